@@ -39,6 +39,7 @@
 #include <emmintrin.h>                 // Define SSE2 intrinsics
 #include "randomc.h"                   // Define integer types etc
 #include <time.h>
+#include <string.h>
 
 // Choose one of the possible Mersenne exponents.
 // Higher values give longer cycle length and use more memory:
@@ -234,6 +235,39 @@ public:
         y = ((uint32_t*)state)[ix++];
         return y;
     }
+
+    void BRandomFill(uint32_t* dest, uint32_t count) // Output count times 32 random bits
+    {
+        // Same sequence as count calls to BRandom, copied a state block at a time
+        while (count) {
+            if (ix >= SFMT_N*4) {
+                Generate();
+            }
+            uint32_t n = SFMT_N*4 - ix;
+            if (n > count) n = count;
+            memcpy(dest, (uint32_t*)state + ix, n * sizeof(uint32_t));
+            ix += n;
+            dest += n;
+            count -= n;
+        }
+    }
+    void RandomFill(double* dest, uint32_t count)  // Output count random floating point numbers
+    {
+        // Same sequence as count calls to Random, including the word skipped at the end of a block
+        while (count) {
+            if (ix >= SFMT_N*4-1) {
+                Generate();
+            }
+            uint32_t n = (SFMT_N*4 - ix) / 2;
+            if (n > count) n = count;
+            for (uint32_t i = 0; i < n; ++i, ix += 2) {
+                uint64_t r = *(uint64_t*)((uint32_t*)state+ix);
+                dest[i] = (int64_t)(r >> 12) * (1./(67108864.0*67108864.0));
+            }
+            dest += n;
+            count -= n;
+        }
+    }
 private:
     void Init2()                                   // Various initializations and period certification
     {
@@ -0,0 +1,3 @@
+DELETE FROM `command` WHERE `name` = 'debug playersaves';
+INSERT INTO `command` (`name`, `security`, `help`) VALUES
+('debug playersaves', 3, 'Syntax: .debug playersaves\nShows the autosave queue of your current map: queued, saved and deferred players, average and maximum save time and the longest wait for a save.');
@@ -0,0 +1,3 @@
+DELETE FROM `command` WHERE `name` = 'server netstats';
+INSERT INTO `command` (`name`, `security`, `help`) VALUES
+('server netstats', 3, 'Syntax: .server netstats [#count]\nShows the network traffic per second and in total, then the #count opcodes (10 by default) with the most traffic, with their packet and byte rates and average handler time.');
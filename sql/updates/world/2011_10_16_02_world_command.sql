@@ -0,0 +1,3 @@
+DELETE FROM `command` WHERE `name` = 'debug querycache';
+INSERT INTO `command` (`name`, `security`, `help`) VALUES
+('debug querycache', 3, 'Syntax: .debug querycache\nShows the line of sight and height query cache of your current map: queries, rays saved by the cache and the number of invalidations.');
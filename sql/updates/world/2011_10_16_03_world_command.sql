@@ -0,0 +1,3 @@
+DELETE FROM `command` WHERE `name` = 'debug hooks';
+INSERT INTO `command` (`name`, `security`, `help`) VALUES
+('debug hooks', 3, 'Syntax: .debug hooks [on|off|reset]\nShows the subscribed script hooks with their subscriber count, calls and total time. on and off enable or disable the hook profiling, reset clears the counters.');
@@ -17,6 +17,7 @@
  */
 
 #include "BoundingIntervalHierarchy.h"
+#include "VMapDefinitions.h"
 
 void BIH::buildHierarchy(std::vector<uint32> &tempTree, buildData &dat, BuildStats &stats)
 {
@@ -238,35 +239,51 @@ void BIH::subdivide(int left, int right, std::vector<uint32> &tempTree, buildDat
         stats.updateLeaf(depth + 1, 0);
 }
 
+BIH& BIH::operator=(const BIH &other)
+{
+    if (this == &other)
+        return *this;
+    tree = other.tree;
+    objects = other.objects;
+    bounds = other.bounds;
+    if (other.tree.empty() && other.treeData)
+    {
+        // both trees share the same mapping
+        treeData = other.treeData;
+        treeSize = other.treeSize;
+        objectsData = other.objectsData;
+        objectsSize = other.objectsSize;
+    }
+    else
+        setOwnedData();
+    return *this;
+}
+
 bool BIH::writeToFile(FILE* wf) const
 {
-    uint32 treeSize = tree.size();
-    uint32 check=0, count=0;
+    uint32 check=0;
     check += fwrite(&bounds.low(), sizeof(float), 3, wf);
     check += fwrite(&bounds.high(), sizeof(float), 3, wf);
     check += fwrite(&treeSize, sizeof(uint32), 1, wf);
-    check += fwrite(&tree[0], sizeof(uint32), treeSize, wf);
-    count = objects.size();
-    check += fwrite(&count, sizeof(uint32), 1, wf);
-    check += fwrite(&objects[0], sizeof(uint32), count, wf);
-    return check == (3 + 3 + 2 + treeSize + count);
+    check += fwrite(treeData, sizeof(uint32), treeSize, wf);
+    check += fwrite(&objectsSize, sizeof(uint32), 1, wf);
+    check += fwrite(objectsData, sizeof(uint32), objectsSize, wf);
+    return check == (3 + 3 + 2 + treeSize + objectsSize);
 }
 
-bool BIH::readFromFile(FILE* rf)
+bool BIH::readFromMemory(VMAP::ChunkReader &reader)
 {
-    uint32 treeSize;
     Vector3 lo, hi;
-    uint32 check=0, count=0;
-    check += fread(&lo, sizeof(float), 3, rf);
-    check += fread(&hi, sizeof(float), 3, rf);
+    tree.clear();
+    objects.clear();
+    if (!reader.read(&lo, sizeof(Vector3)) || !reader.read(&hi, sizeof(Vector3)))
+        return false;
     bounds = AABox(lo, hi);
-    check += fread(&treeSize, sizeof(uint32), 1, rf);
-    tree.resize(treeSize);
-    check += fread(&tree[0], sizeof(uint32), treeSize, rf);
-    check += fread(&count, sizeof(uint32), 1, rf);
-    objects.resize(count); // = new uint32[nObjects];
-    check += fread(&objects[0], sizeof(uint32), count, rf);
-    return check == (3 + 3 + 2 + treeSize + count);
+    if (!reader.read(&treeSize, sizeof(uint32)) || !reader.readArray(treeData, treeSize))
+        return false;
+    if (!reader.read(&objectsSize, sizeof(uint32)) || !reader.readArray(objectsData, objectsSize))
+        return false;
+    return true;
 }
 
 void BIH::BuildStats::updateLeaf(int depth, int n)
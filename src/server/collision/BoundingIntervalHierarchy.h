@@ -37,6 +37,14 @@
 
 #define MAX_STACK_SIZE 64
 
+// number of rays traversed together by BIH::intersectRayPacket()
+#define BIH_PACKET_SIZE 4
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+    #include <xmmintrin.h>
+    #define BIH_PACKET_SSE
+#endif
+
 #ifdef _MSC_VER
     #define isnan(x) _isnan(x)
 #endif
@@ -67,6 +75,11 @@ static inline float intBitsToFloat(uint32 i)
     return temp.fval;
 }
 
+namespace VMAP
+{
+    class ChunkReader;
+}
+
 struct AABound
 {
     Vector3 lo, hi;
@@ -82,7 +95,9 @@ struct AABound
 class BIH
 {
     public:
-        BIH() {};
+        BIH(): treeData(NULL), treeSize(0), objectsData(NULL), objectsSize(0) {};
+        BIH(const BIH &other) { *this = other; }
+        BIH& operator=(const BIH &other);
         template< class T, class BoundsFunc >
         void build(const std::vector<T> &primitives, BoundsFunc &getBounds, uint32 leafSize = 3, bool printStats=false)
         {
@@ -112,10 +127,11 @@ class BIH
                 objects[i] = dat.indices[i];
             //nObjects = dat.numPrims;
             tree = tempTree;
+            setOwnedData();
             delete[] dat.primBound;
             delete[] dat.indices;
         }
-        uint32 primCount() { return objects.size(); }
+        uint32 primCount() const { return objectsSize; }
 
         template<typename RayCallback>
         void intersectRay(const Ray &r, RayCallback& intersectCallback, float &maxDist, bool stopAtFirst=false) const
@@ -175,7 +191,7 @@ class BIH
             while (true) {
                 while (true)
                 {
-                    uint32 tn = tree[node];
+                    uint32 tn = treeData[node];
                     uint32 axis = (tn & (3 << 30)) >> 30;
                     bool BVH2 = tn & (1 << 29);
                     int offset = tn & ~(7 << 29);
@@ -184,8 +200,8 @@ class BIH
                         if (axis < 3)
                         {
                             // "normal" interior node
-                            float tf = (intBitsToFloat(tree[node + offsetFront[axis]]) - org[axis]) * invDir[axis];
-                            float tb = (intBitsToFloat(tree[node + offsetBack[axis]]) - org[axis]) * invDir[axis];
+                            float tf = (intBitsToFloat(treeData[node + offsetFront[axis]]) - org[axis]) * invDir[axis];
+                            float tb = (intBitsToFloat(treeData[node + offsetBack[axis]]) - org[axis]) * invDir[axis];
                             // ray passes between clip zones
                             if (tf < intervalMin && tb > intervalMax)
                                 break;
@@ -215,9 +231,9 @@ class BIH
                         else
                         {
                             // leaf - test some objects
-                            int n = tree[node + 1];
+                            int n = treeData[node + 1];
                             while (n > 0) {
-                                bool hit = intersectCallback(r, objects[offset], maxDist, stopAtFirst);
+                                bool hit = intersectCallback(r, objectsData[offset], maxDist, stopAtFirst);
                                 if (stopAtFirst && hit) return;
                                 --n;
                                 ++offset;
@@ -229,8 +245,8 @@ class BIH
                     {
                         if (axis>2)
                             return; // should not happen
-                        float tf = (intBitsToFloat(tree[node + offsetFront[axis]]) - org[axis]) * invDir[axis];
-                        float tb = (intBitsToFloat(tree[node + offsetBack[axis]]) - org[axis]) * invDir[axis];
+                        float tf = (intBitsToFloat(treeData[node + offsetFront[axis]]) - org[axis]) * invDir[axis];
+                        float tb = (intBitsToFloat(treeData[node + offsetBack[axis]]) - org[axis]) * invDir[axis];
                         node = offset;
                         intervalMin = (tf >= intervalMin) ? tf : intervalMin;
                         intervalMax = (tb <= intervalMax) ? tb : intervalMax;
@@ -256,6 +272,216 @@ class BIH
             }
         }
 
+        /**
+        Traverses the tree once for up to BIH_PACKET_SIZE rays. The rays descend together
+        and are only split up at the leaves, which is much cheaper than separate traversals
+        for coherent bundles, e.g. LOS checks from one caster to many targets.
+        Returns a mask with bit i set for every ray i that hit something.
+        */
+        template<typename RayCallback>
+        uint32 intersectRayPacket(const Ray* rays, uint32 count, RayCallback& intersectCallback, float* maxDist, bool stopAtFirst=false) const
+        {
+            uint32 hitMask = 0;
+#ifndef BIH_PACKET_SSE
+            for (uint32 i = 0; i < count; ++i)
+            {
+                PacketRayCallback<RayCallback> callback(intersectCallback);
+                intersectRay(rays[i], callback, maxDist[i], stopAtFirst);
+                if (callback.hit)
+                    hitMask |= 1 << i;
+            }
+            return hitMask;
+#else
+            if (!treeSize || !count)
+                return 0;
+
+            // per ray entry interval into the tree bounds, empty (near > far) for missing rays
+            float nearArr[BIH_PACKET_SIZE], farArr[BIH_PACKET_SIZE], distArr[BIH_PACKET_SIZE];
+            float orgArr[3][BIH_PACKET_SIZE], invDirArr[3][BIH_PACKET_SIZE];
+            uint32 activeMask = 0;
+            for (uint32 i = 0; i < BIH_PACKET_SIZE; ++i)
+            {
+                nearArr[i] = G3D::inf();
+                farArr[i] = -G3D::inf();
+                distArr[i] = -G3D::inf();
+                for (int a = 0; a < 3; ++a)
+                {
+                    orgArr[a][i] = 0.f;
+                    invDirArr[a][i] = 1.f;
+                }
+                if (i >= count)
+                    continue;
+
+                distArr[i] = maxDist[i];
+                Vector3 org = rays[i].origin();
+                Vector3 dir = rays[i].direction();
+                float intervalMin = -1.f;
+                float intervalMax = -1.f;
+                bool miss = false;
+                for (int a = 0; a < 3; ++a)
+                {
+                    orgArr[a][i] = org[a];
+                    invDirArr[a][i] = 1.f / dir[a];
+                    if (G3D::fuzzyNe(dir[a], 0.0f))
+                    {
+                        float t1 = (bounds.low()[a]  - org[a]) * invDirArr[a][i];
+                        float t2 = (bounds.high()[a] - org[a]) * invDirArr[a][i];
+                        if (t1 > t2)
+                            std::swap(t1, t2);
+                        if (t1 > intervalMin)
+                            intervalMin = t1;
+                        if (t2 < intervalMax || intervalMax < 0.f)
+                            intervalMax = t2;
+                        if (intervalMax <= 0 || intervalMin >= maxDist[i])
+                            miss = true;
+                    }
+                }
+                if (miss || intervalMin > intervalMax)
+                    continue;
+
+                nearArr[i] = std::max(intervalMin, 0.f);
+                farArr[i] = std::min(intervalMax, maxDist[i]);
+                activeMask |= 1 << i;
+            }
+
+            if (!activeMask)
+                return 0;
+
+            __m128 org[3], invDir[3], negDir[3];
+            for (int a = 0; a < 3; ++a)
+            {
+                org[a] = _mm_loadu_ps(orgArr[a]);
+                invDir[a] = _mm_loadu_ps(invDirArr[a]);
+                // same sign convention as the single ray traversal, -0 counts as negative
+                negDir[a] = _mm_cmplt_ps(invDir[a], _mm_setzero_ps());
+            }
+            __m128 tMin = _mm_loadu_ps(nearArr);
+            __m128 tMax = _mm_loadu_ps(farArr);
+
+            PacketStackNode stack[MAX_STACK_SIZE];
+            int stackPos = 0;
+            int node = 0;
+
+            while (true) {
+                while (true)
+                {
+                    uint32 tn = treeData[node];
+                    uint32 axis = (tn & (3 << 30)) >> 30;
+                    bool BVH2 = tn & (1 << 29);
+                    int offset = tn & ~(7 << 29);
+                    if (!BVH2)
+                    {
+                        if (axis < 3)
+                        {
+                            // "normal" interior node, left child ends at tl, right child starts at tr
+                            __m128 tl = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(intBitsToFloat(treeData[node + 1])), org[axis]), invDir[axis]);
+                            __m128 tr = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(intBitsToFloat(treeData[node + 2])), org[axis]), invDir[axis]);
+                            __m128 neg = negDir[axis];
+                            __m128 leftNear = packetSelect(neg, _mm_max_ps(tMin, tl), tMin);
+                            __m128 leftFar = packetSelect(neg, tMax, _mm_min_ps(tMax, tl));
+                            __m128 rightNear = packetSelect(neg, tMin, _mm_max_ps(tMin, tr));
+                            __m128 rightFar = packetSelect(neg, _mm_min_ps(tMax, tr), tMax);
+                            uint32 leftMask = _mm_movemask_ps(_mm_cmple_ps(leftNear, leftFar)) & activeMask;
+                            uint32 rightMask = _mm_movemask_ps(_mm_cmple_ps(rightNear, rightFar)) & activeMask;
+                            // packet passes between clip zones
+                            if (!leftMask && !rightMask)
+                                break;
+                            if (!rightMask)
+                            {
+                                node = offset;
+                                tMin = leftNear;
+                                tMax = leftFar;
+                                continue;
+                            }
+                            if (!leftMask)
+                            {
+                                node = offset + 3;
+                                tMin = rightNear;
+                                tMax = rightFar;
+                                continue;
+                            }
+                            // packet passes through both nodes, visit the near one of the first active ray first
+                            uint32 firstActive = 0;
+                            while (!(activeMask & (1 << firstActive)))
+                                ++firstActive;
+                            bool rightFirst = (_mm_movemask_ps(neg) & (1 << firstActive)) != 0;
+                            stack[stackPos].node = rightFirst ? offset : offset + 3;
+                            stack[stackPos].tnear = rightFirst ? leftNear : rightNear;
+                            stack[stackPos].tfar = rightFirst ? leftFar : rightFar;
+                            stackPos++;
+                            node = rightFirst ? offset + 3 : offset;
+                            tMin = rightFirst ? rightNear : leftNear;
+                            tMax = rightFirst ? rightFar : leftFar;
+                            continue;
+                        }
+                        else
+                        {
+                            // leaf - test some objects against every ray still inside this node
+                            uint32 leafMask = _mm_movemask_ps(_mm_cmple_ps(tMin, tMax)) & activeMask;
+                            int n = treeData[node + 1];
+                            while (n > 0) {
+                                for (uint32 i = 0; i < count; ++i)
+                                {
+                                    if (!(leafMask & (1 << i)))
+                                        continue;
+                                    if (intersectCallback(rays[i], objectsData[offset], distArr[i], stopAtFirst))
+                                    {
+                                        hitMask |= 1 << i;
+                                        if (stopAtFirst)
+                                        {
+                                            activeMask &= ~(1 << i);
+                                            leafMask &= ~(1 << i);
+                                        }
+                                    }
+                                }
+                                --n;
+                                ++offset;
+                            }
+                            if (!activeMask)
+                            {
+                                for (uint32 i = 0; i < count; ++i)
+                                    maxDist[i] = distArr[i];
+                                return hitMask;
+                            }
+                            break;
+                        }
+                    }
+                    else
+                    {
+                        if (axis>2)
+                            break; // should not happen
+                        __m128 tl = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(intBitsToFloat(treeData[node + 1])), org[axis]), invDir[axis]);
+                        __m128 tr = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(intBitsToFloat(treeData[node + 2])), org[axis]), invDir[axis]);
+                        node = offset;
+                        tMin = _mm_max_ps(tMin, packetSelect(negDir[axis], tr, tl));
+                        tMax = _mm_min_ps(tMax, packetSelect(negDir[axis], tl, tr));
+                        if (!(_mm_movemask_ps(_mm_cmple_ps(tMin, tMax)) & activeMask))
+                            break;
+                        continue;
+                    }
+                } // traversal loop
+                do
+                {
+                    // stack is empty?
+                    if (stackPos == 0)
+                    {
+                        for (uint32 i = 0; i < count; ++i)
+                            maxDist[i] = distArr[i];
+                        return hitMask;
+                    }
+                    // move back up the stack, rays may have found closer hits meanwhile
+                    stackPos--;
+                    tMin = stack[stackPos].tnear;
+                    tMax = _mm_min_ps(stack[stackPos].tfar, _mm_loadu_ps(distArr));
+                    if (!(_mm_movemask_ps(_mm_cmple_ps(tMin, tMax)) & activeMask))
+                        continue;
+                    node = stack[stackPos].node;
+                    break;
+                } while (true);
+            }
+#endif
+        }
+
         template<typename IsectCallback>
         void intersectPoint(const Vector3 &p, IsectCallback& intersectCallback) const
         {
@@ -269,7 +495,7 @@ class BIH
             while (true) {
                 while (true)
                 {
-                    uint32 tn = tree[node];
+                    uint32 tn = treeData[node];
                     uint32 axis = (tn & (3 << 30)) >> 30;
                     bool BVH2 = tn & (1 << 29);
                     int offset = tn & ~(7 << 29);
@@ -278,8 +504,8 @@ class BIH
                         if (axis < 3)
                         {
                             // "normal" interior node
-                            float tl = intBitsToFloat(tree[node + 1]);
-                            float tr = intBitsToFloat(tree[node + 2]);
+                            float tl = intBitsToFloat(treeData[node + 1]);
+                            float tr = intBitsToFloat(treeData[node + 2]);
                             // point is between clip zones
                             if (tl < p[axis] && tr > p[axis])
                                 break;
@@ -303,9 +529,9 @@ class BIH
                         else
                         {
                             // leaf - test some objects
-                            int n = tree[node + 1];
+                            int n = treeData[node + 1];
                             while (n > 0) {
-                                intersectCallback(p, objects[offset]); // !!!
+                                intersectCallback(p, objectsData[offset]); // !!!
                                 --n;
                                 ++offset;
                             }
@@ -316,8 +542,8 @@ class BIH
                     {
                         if (axis>2)
                             return; // should not happen
-                        float tl = intBitsToFloat(tree[node + 1]);
-                        float tr = intBitsToFloat(tree[node + 2]);
+                        float tl = intBitsToFloat(treeData[node + 1]);
+                        float tr = intBitsToFloat(treeData[node + 2]);
                         node = offset;
                         if (tl > p[axis] || tr < p[axis])
                             break;
@@ -335,13 +561,28 @@ class BIH
         }
 
         bool writeToFile(FILE* wf) const;
-        bool readFromFile(FILE* rf);
+        //! points tree and object arrays into the reader's mapping, nothing is copied
+        bool readFromMemory(VMAP::ChunkReader &reader);
 
     protected:
+        // owned storage, only filled by build(); trees read from a mapped file leave these empty
         std::vector<uint32> tree;
         std::vector<uint32> objects;
+        // what traversal actually uses, either the vectors above or a mapped file
+        const uint32* treeData;
+        uint32 treeSize;
+        const uint32* objectsData;
+        uint32 objectsSize;
         AABox bounds;
 
+        void setOwnedData()
+        {
+            treeSize = tree.size();
+            treeData = treeSize ? &tree[0] : NULL;
+            objectsSize = objects.size();
+            objectsData = objectsSize ? &objects[0] : NULL;
+        }
+
         struct buildData
         {
             uint32 *indices;
@@ -356,6 +597,35 @@ class BIH
             float tfar;
         };
 
+        template<typename RayCallback>
+        struct PacketRayCallback
+        {
+            PacketRayCallback(RayCallback& callback): wrapped(callback), hit(false) {}
+            bool operator()(const Ray& ray, uint32 entry, float& distance, bool stopAtFirst)
+            {
+                bool result = wrapped(ray, entry, distance, stopAtFirst);
+                if (result)
+                    hit = true;
+                return result;
+            }
+            RayCallback& wrapped;
+            bool hit;
+        };
+
+#ifdef BIH_PACKET_SSE
+        struct PacketStackNode
+        {
+            __m128 tnear;
+            __m128 tfar;
+            uint32 node;
+        };
+
+        static __m128 packetSelect(__m128 mask, __m128 a, __m128 b)
+        {
+            return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+        }
+#endif
+
         class BuildStats
         {
             private:
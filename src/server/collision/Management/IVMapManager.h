@@ -61,6 +61,11 @@ namespace VMAP
             virtual void unloadMap(unsigned int pMapId) = 0;
 
             virtual bool isInLineOfSight(unsigned int pMapId, float x1, float y1, float z1, float x2, float y2, float z2) = 0;
+            /**
+            check LOS of count segments at once, pSegments holds x1, y1, z1, x2, y2, z2 of each segment
+            pResults[i] is set to what isInLineOfSight() returns for segment i
+            */
+            virtual void isInLineOfSight(unsigned int pMapId, const float* pSegments, uint32 count, bool* pResults) = 0;
             virtual float getHeight(unsigned int pMapId, float x, float y, float z, float maxSearchDist) = 0;
             /**
             test if we hit an object. return true if we hit one. rx, ry, rz will hold the hit position or the dest position, if no intersection was found
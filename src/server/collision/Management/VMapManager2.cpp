@@ -149,6 +149,28 @@ namespace VMAP
         return true;
     }
 
+    void VMapManager2::isInLineOfSight(unsigned int mapId, const float* segments, uint32 count, bool* results)
+    {
+        std::fill(results, results + count, true);
+
+        if (!count || !isLineOfSightCalcEnabled() || DisableMgr::IsDisabledFor(DISABLE_TYPE_VMAP, mapId, NULL, VMAP_DISABLE_LOS))
+            return;
+
+        InstanceTreeMap::iterator instanceTree = iInstanceMapTrees.find(mapId);
+        if (instanceTree == iInstanceMapTrees.end())
+            return;
+
+        std::vector<Vector3> pos1(count), pos2(count);
+        for (uint32 i = 0; i < count; ++i)
+        {
+            const float* segment = segments + i * 6;
+            pos1[i] = convertPositionToInternalRep(segment[0], segment[1], segment[2]);
+            pos2[i] = convertPositionToInternalRep(segment[3], segment[4], segment[5]);
+        }
+
+        instanceTree->second->isInLineOfSight(&pos1[0], &pos2[0], count, results);
+    }
+
     /**
     get the hit position and return true if we hit something
     otherwise the result pos will be the dest pos
@@ -247,6 +269,8 @@ namespace VMAP
 
     WorldModel* VMapManager2::acquireModelInstance(const std::string& basepath, const std::string& filename)
     {
+        ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, LoadedModelFilesLock, NULL);
+
         ModelFileMap::iterator model = iLoadedModelFiles.find(filename);
         if (model == iLoadedModelFiles.end())
         {
@@ -267,6 +291,8 @@ namespace VMAP
 
     void VMapManager2::releaseModelInstance(const std::string &filename)
     {
+        ACE_GUARD(ACE_Thread_Mutex, guard, LoadedModelFilesLock);
+
         ModelFileMap::iterator model = iLoadedModelFiles.find(filename);
         if (model == iLoadedModelFiles.end())
         {
@@ -125,7 +125,7 @@ namespace VMAP
     }
 
     StaticMapTree::StaticMapTree(uint32 mapID, const std::string &basePath):
-        iMapID(mapID), iTreeValues(0), iBasePath(basePath)
+        iMapID(mapID), iIsTiled(false), iTreeFile(0), iTreeValues(0), iNTreeValues(0), iBasePath(basePath)
     {
         if (iBasePath.length() > 0 && (iBasePath[iBasePath.length()-1] != '/' || iBasePath[iBasePath.length()-1] != '\\'))
         {
@@ -138,6 +138,7 @@ namespace VMAP
     StaticMapTree::~StaticMapTree()
     {
         delete[] iTreeValues;
+        delete iTreeFile;
     }
 
     //=========================================================
@@ -172,6 +173,43 @@ namespace VMAP
 
         return true;
     }
+    //=========================================================
+
+    void StaticMapTree::isInLineOfSight(const Vector3* pos1, const Vector3* pos2, uint32 count, bool* results) const
+    {
+        G3D::Ray rays[BIH_PACKET_SIZE];
+        float maxDist[BIH_PACKET_SIZE];
+        uint32 rayTarget[BIH_PACKET_SIZE];
+        uint32 numRays = 0;
+
+        for (uint32 i = 0; i < count; ++i)
+        {
+            results[i] = true;
+            float dist = (pos2[i] - pos1[i]).magnitude();
+            // valid map coords should *never ever* produce float overflow, but this would produce NaNs too
+            ASSERT(dist < std::numeric_limits<float>::max());
+            // prevent NaN values which can cause BIH intersection to enter infinite loop
+            if (dist >= 1e-10f)
+            {
+                rays[numRays] = G3D::Ray::fromOriginAndDirection(pos1[i], (pos2[i] - pos1[i])/dist);
+                maxDist[numRays] = dist;
+                rayTarget[numRays] = i;
+                ++numRays;
+            }
+
+            // trace full packets, and the remainder after the last target
+            if (numRays == BIH_PACKET_SIZE || (i + 1 == count && numRays))
+            {
+                MapRayCallback intersectionCallBack(iTreeValues);
+                uint32 hitMask = iTree.intersectRayPacket(rays, numRays, intersectionCallBack, maxDist, true);
+                for (uint32 r = 0; r < numRays; ++r)
+                    if (hitMask & (1 << r))
+                        results[rayTarget[r]] = false;
+                numRays = 0;
+            }
+        }
+    }
+
     //=========================================================
     /**
     When moving from pos1 to pos2 check if we hit an object. Return true and the position if we hit one
@@ -249,9 +287,9 @@ namespace VMAP
         if (!rf)
             return false;
         // TODO: check magic number when implemented...
-        char tiled;
+        uint32 tiled;
         char chunk[8];
-        if (!readChunk(rf, chunk, VMAP_MAGIC, 8) || fread(&tiled, sizeof(char), 1, rf) != 1)
+        if (!readChunk(rf, chunk, VMAP_MAGIC, 8) || fread(&tiled, sizeof(uint32), 1, rf) != 1)
         {
             fclose(rf);
             return false;
@@ -280,52 +318,50 @@ namespace VMAP
         sLog->outDebug(LOG_FILTER_MAPS, "StaticMapTree::InitMap() : initializing StaticMapTree '%s'", fname.c_str());
         bool success = true;
         std::string fullname = iBasePath + fname;
-        FILE* rf = fopen(fullname.c_str(), "rb");
-        if (!rf)
+        delete iTreeFile;
+        iTreeFile = new MappedFile();
+        if (!iTreeFile->open(fullname))
             return false;
-        else
+
+        ChunkReader reader(*iTreeFile);
+        //general info
+        if (!reader.readChunk(VMAP_MAGIC, 8)) success = false;
+        uint32 tiled = 0;
+        if (success && !reader.read(&tiled, sizeof(uint32))) success = false;
+        iIsTiled = bool(tiled);
+        // Nodes, used in place from the mapping
+        if (success && !reader.readChunk("NODE", 4)) success = false;
+        if (success) success = iTree.readFromMemory(reader);
+        if (success)
         {
-            char chunk[8];
-            //general info
-            if (!readChunk(rf, chunk, VMAP_MAGIC, 8)) success = false;
-            char tiled = '\0';
-            if (success && fread(&tiled, sizeof(char), 1, rf) != 1) success = false;
-            iIsTiled = bool(tiled);
-            // Nodes
-            if (success && !readChunk(rf, chunk, "NODE", 4)) success = false;
-            if (success) success = iTree.readFromFile(rf);
-            if (success)
-            {
-                iNTreeValues = iTree.primCount();
-                iTreeValues = new ModelInstance[iNTreeValues];
-            }
+            iNTreeValues = iTree.primCount();
+            iTreeValues = new ModelInstance[iNTreeValues];
+        }
 
-            if (success && !readChunk(rf, chunk, "GOBJ", 4)) success = false;
-            // global model spawns
-            // only non-tiled maps have them, and if so exactly one (so far at least...)
-            ModelSpawn spawn;
+        if (success && !reader.readChunk("GOBJ", 4)) success = false;
+        // global model spawns
+        // only non-tiled maps have them, and if so exactly one (so far at least...)
+        ModelSpawn spawn;
 #ifdef VMAP_DEBUG
-            sLog->outDebug(LOG_FILTER_MAPS, "StaticMapTree::InitMap() : map isTiled: %u", static_cast<uint32>(iIsTiled));
+        sLog->outDebug(LOG_FILTER_MAPS, "StaticMapTree::InitMap() : map isTiled: %u", static_cast<uint32>(iIsTiled));
 #endif
-            if (!iIsTiled && ModelSpawn::readFromFile(rf, spawn))
+        if (success && !iIsTiled && ModelSpawn::readFromMemory(reader, spawn))
+        {
+            WorldModel* model = vm->acquireModelInstance(iBasePath, spawn.name);
+            sLog->outDebug(LOG_FILTER_MAPS, "StaticMapTree::InitMap() : loading %s", spawn.name.c_str());
+            if (model)
             {
-                WorldModel* model = vm->acquireModelInstance(iBasePath, spawn.name);
-                sLog->outDebug(LOG_FILTER_MAPS, "StaticMapTree::InitMap() : loading %s", spawn.name.c_str());
-                if (model)
-                {
-                    // assume that global model always is the first and only tree value (could be improved...)
-                    iTreeValues[0] = ModelInstance(spawn, model);
-                    iLoadedSpawns[0] = 1;
-                }
-                else
-                {
-                    success = false;
-                    sLog->outError("StaticMapTree::InitMap() : could not acquire WorldModel pointer for '%s'", spawn.name.c_str());
-                }
+                // assume that global model always is the first and only tree value (could be improved...)
+                iTreeValues[0] = ModelInstance(spawn, model);
+                iLoadedSpawns[0] = 1;
+            }
+            else
+            {
+                success = false;
+                sLog->outError("StaticMapTree::InitMap() : could not acquire WorldModel pointer for '%s'", spawn.name.c_str());
             }
-
-            fclose(rf);
         }
+
         return success;
     }
 
@@ -362,21 +398,21 @@ namespace VMAP
         bool result = true;
 
         std::string tilefile = iBasePath + getTileFileName(iMapID, tileX, tileY);
-        FILE* tf = fopen(tilefile.c_str(), "rb");
-        if (tf)
+        MappedFile tf;
+        if (tf.open(tilefile))
         {
-            char chunk[8];
+            ChunkReader reader(tf);
 
-            if (!readChunk(tf, chunk, VMAP_MAGIC, 8))
+            if (!reader.readChunk(VMAP_MAGIC, 8))
                 result = false;
             uint32 numSpawns = 0;
-            if (result && fread(&numSpawns, sizeof(uint32), 1, tf) != 1)
+            if (result && !reader.read(&numSpawns, sizeof(uint32)))
                 result = false;
             for (uint32 i=0; i<numSpawns && result; ++i)
             {
                 // read model spawns
                 ModelSpawn spawn;
-                result = ModelSpawn::readFromFile(tf, spawn);
+                result = ModelSpawn::readFromMemory(reader, spawn);
                 if (result)
                 {
                     // acquire model instance
@@ -387,7 +423,7 @@ namespace VMAP
                     // update tree
                     uint32 referencedVal;
 
-                    if (fread(&referencedVal, sizeof(uint32), 1, tf) == 1)
+                    if (reader.read(&referencedVal, sizeof(uint32)))
                     {
                         if (!iLoadedSpawns.count(referencedVal))
                         {
@@ -417,7 +453,6 @@ namespace VMAP
                 }
             }
             iLoadedTiles[packTileID(tileX, tileY)] = true;
-            fclose(tf);
         }
         else
             iLoadedTiles[packTileID(tileX, tileY)] = false;
@@ -438,21 +473,21 @@ namespace VMAP
         if (tile->second) // file associated with tile
         {
             std::string tilefile = iBasePath + getTileFileName(iMapID, tileX, tileY);
-            FILE* tf = fopen(tilefile.c_str(), "rb");
-            if (tf)
+            MappedFile tf;
+            if (tf.open(tilefile))
             {
+                ChunkReader reader(tf);
                 bool result=true;
-                char chunk[8];
-                if (!readChunk(tf, chunk, VMAP_MAGIC, 8))
+                if (!reader.readChunk(VMAP_MAGIC, 8))
                     result = false;
-                uint32 numSpawns;
-                if (fread(&numSpawns, sizeof(uint32), 1, tf) != 1)
+                uint32 numSpawns = 0;
+                if (result && !reader.read(&numSpawns, sizeof(uint32)))
                     result = false;
                 for (uint32 i=0; i<numSpawns && result; ++i)
                 {
                     // read model spawns
                     ModelSpawn spawn;
-                    result = ModelSpawn::readFromFile(tf, spawn);
+                    result = ModelSpawn::readFromMemory(reader, spawn);
                     if (result)
                     {
                         // release model instance
@@ -461,7 +496,7 @@ namespace VMAP
                         // update tree
                         uint32 referencedNode;
 
-                        if (fread(&referencedNode, sizeof(uint32), 1, tf) != 1)
+                        if (!reader.read(&referencedNode, sizeof(uint32)))
                             result = false;
                         else
                         {
@@ -475,7 +510,6 @@ namespace VMAP
                         }
                     }
                 }
-                fclose(tf);
             }
         }
         iLoadedTiles.erase(tile);
@@ -28,6 +28,7 @@ namespace VMAP
     class ModelInstance;
     class GroupModel;
     class VMapManager2;
+    class MappedFile;
 
     struct LocationInfo
     {
@@ -44,6 +45,7 @@ namespace VMAP
         private:
             uint32 iMapID;
             bool iIsTiled;
+            MappedFile* iTreeFile; // .vmtree mapping, iTree nodes live in here
             BIH iTree;
             ModelInstance* iTreeValues; // the tree entries
             uint32 iNTreeValues;
@@ -69,6 +71,8 @@ namespace VMAP
             ~StaticMapTree();
 
             bool isInLineOfSight(const G3D::Vector3& pos1, const G3D::Vector3& pos2) const;
+            //! results[i] is the LOS result from pos1[i] to pos2[i]
+            void isInLineOfSight(const G3D::Vector3* pos1, const G3D::Vector3* pos2, uint32 count, bool* results) const;
             bool getObjectHitPos(const G3D::Vector3& pos1, const G3D::Vector3& pos2, G3D::Vector3& pResultHitPos, float pModifyDist) const;
             float getHeight(const G3D::Vector3& pPos, float maxSearchDist) const;
             bool getAreaInfo(G3D::Vector3 &pos, uint32 &flags, int32 &adtId, int32 &rootId, int32 &groupId) const;
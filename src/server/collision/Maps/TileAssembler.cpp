@@ -45,6 +45,13 @@ namespace VMAP
         return memcmp(dest, compare, len) == 0;
     }
 
+    bool writePadding(FILE* wf, uint32 written)
+    {
+        static const char pad[4] = { 0, 0, 0, 0 };
+        uint32 padSize = (4 - (written & 3)) & 3;
+        return fwrite(pad, 1, padSize, wf) == padSize;
+    }
+
     Vector3 ModelPosition::transform(const Vector3& pIn) const
     {
         Vector3 out = pIn * iScale;
@@ -125,8 +132,9 @@ namespace VMAP
             if (success && fwrite(VMAP_MAGIC, 1, 8, mapfile) != 8) success = false;
             uint32 globalTileID = StaticMapTree::packTileID(65, 65);
             pair<TileMap::iterator, TileMap::iterator> globalRange = map_iter->second->TileEntries.equal_range(globalTileID);
-            char isTiled = globalRange.first == globalRange.second; // only maps without terrain (tiles) have global WMO
-            if (success && fwrite(&isTiled, sizeof(char), 1, mapfile) != 1) success = false;
+            // only maps without terrain (tiles) have global WMO, stored as uint32 to keep the tree aligned
+            uint32 isTiled = globalRange.first == globalRange.second;
+            if (success && fwrite(&isTiled, sizeof(uint32), 1, mapfile) != 1) success = false;
             // Nodes
             if (success && fwrite("NODE", 4, 1, mapfile) != 1) success = false;
             if (success) success = pTree.writeToFile(mapfile);
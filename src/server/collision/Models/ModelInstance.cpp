@@ -197,6 +197,40 @@ namespace VMAP
         return true;
     }
 
+    bool ModelSpawn::readFromMemory(ChunkReader &reader, ModelSpawn &spawn)
+    {
+        uint32 nameLen;
+        bool result = reader.read(&spawn.flags, sizeof(uint32));
+        if (result) result = reader.read(&spawn.adtId, sizeof(uint16));
+        if (result) result = reader.read(&spawn.ID, sizeof(uint32));
+        if (result) result = reader.read(&spawn.iPos, sizeof(float) * 3);
+        if (result) result = reader.read(&spawn.iRot, sizeof(float) * 3);
+        if (result) result = reader.read(&spawn.iScale, sizeof(float));
+        if (result && (spawn.flags & MOD_HAS_BOUND)) // only WMOs have bound in MPQ, only available after computation
+        {
+            Vector3 bLow, bHigh;
+            result = reader.read(&bLow, sizeof(float) * 3) && reader.read(&bHigh, sizeof(float) * 3);
+            spawn.iBound = G3D::AABox(bLow, bHigh);
+        }
+        if (result) result = reader.read(&nameLen, sizeof(uint32));
+        if (!result)
+            return false;
+
+        if (nameLen > 500) // file names should never be that long, must be file error
+        {
+            std::cout << "Error reading ModelSpawn, file name too long!\n";
+            return false;
+        }
+        char nameBuff[500];
+        if (!reader.read(nameBuff, nameLen))
+        {
+            std::cout << "Error reading ModelSpawn!\n";
+            return false;
+        }
+        spawn.name = std::string(nameBuff, nameLen);
+        return true;
+    }
+
     bool ModelSpawn::writeToFile(FILE* wf, const ModelSpawn &spawn)
     {
         uint32 check=0;
@@ -29,6 +29,7 @@
 namespace VMAP
 {
     class WorldModel;
+    class ChunkReader;
     struct AreaInfo;
     struct LocationInfo;
 
@@ -57,6 +58,7 @@ namespace VMAP
             const G3D::AABox& getBounds() const { return iBound; }
 
             static bool readFromFile(FILE* rf, ModelSpawn &spawn);
+            static bool readFromMemory(ChunkReader &reader, ModelSpawn &spawn);
             static bool writeToFile(FILE* rw, const ModelSpawn &spawn);
     };
 
@@ -30,7 +30,7 @@ template<> struct BoundsTrait<VMAP::GroupModel>
 
 namespace VMAP
 {
-    bool IntersectTriangle(const MeshTriangle &tri, std::vector<Vector3>::const_iterator points, const G3D::Ray &ray, float &distance)
+    bool IntersectTriangle(const MeshTriangle &tri, const Vector3* points, const G3D::Ray &ray, float &distance)
     {
         static const float EPS = 1e-5f;
 
@@ -196,10 +196,11 @@ namespace VMAP
 
     uint32 WmoLiquid::GetFileSize()
     {
-        return 2 * sizeof(uint32) +
+        uint32 flagsSize = iTilesX * iTilesY;
+        return 3 * sizeof(uint32) +
                 sizeof(Vector3) +
                 (iTilesX + 1)*(iTilesY + 1) * sizeof(float) +
-                iTilesX * iTilesY;
+                ((flagsSize + 3) & ~3);
     }
 
     bool WmoLiquid::writeToFile(FILE* wf)
@@ -213,25 +214,36 @@ namespace VMAP
         if (result && fwrite(iHeight, sizeof(float), size, wf) != size) result = false;
         size = iTilesX*iTilesY;
         if (result && fwrite(iFlags, sizeof(uint8), size, wf) != size) result = false;
+        if (result) result = writePadding(wf, size);
         return result;
     }
 
-    bool WmoLiquid::readFromFile(FILE* rf, WmoLiquid* &out)
+    bool WmoLiquid::readFromMemory(ChunkReader &reader, WmoLiquid* &out)
     {
+        // liquids are small, just copy them
         bool result = true;
         WmoLiquid* liquid = new WmoLiquid();
-        if (result && fread(&liquid->iTilesX, sizeof(uint32), 1, rf) != 1) result = false;
-        if (result && fread(&liquid->iTilesY, sizeof(uint32), 1, rf) != 1) result = false;
-        if (result && fread(&liquid->iCorner, sizeof(Vector3), 1, rf) != 1) result = false;
-        if (result && fread(&liquid->iType, sizeof(uint32), 1, rf) != 1) result = false;
+        if (result && !reader.read(&liquid->iTilesX, sizeof(uint32))) result = false;
+        if (result && !reader.read(&liquid->iTilesY, sizeof(uint32))) result = false;
+        if (result && !reader.read(&liquid->iCorner, sizeof(Vector3))) result = false;
+        if (result && !reader.read(&liquid->iType, sizeof(uint32))) result = false;
         uint32 size = (liquid->iTilesX + 1)*(liquid->iTilesY + 1);
-        liquid->iHeight = new float[size];
-        if (result && fread(liquid->iHeight, sizeof(float), size, rf) != size) result = false;
+        if (result)
+        {
+            liquid->iHeight = new float[size];
+            result = reader.read(liquid->iHeight, sizeof(float) * size);
+        }
         size = liquid->iTilesX * liquid->iTilesY;
-        liquid->iFlags = new uint8[size];
-        if (result && fread(liquid->iFlags, sizeof(uint8), size, rf) != size) result = false;
+        if (result)
+        {
+            liquid->iFlags = new uint8[size];
+            result = reader.read(liquid->iFlags, sizeof(uint8) * size) && reader.skipPadding();
+        }
         if (!result)
+        {
             delete liquid;
+            liquid = NULL;
+        }
         out = liquid;
         return result;
     }
@@ -240,8 +252,15 @@ namespace VMAP
 
     GroupModel::GroupModel(const GroupModel &other):
         iBound(other.iBound), iMogpFlags(other.iMogpFlags), iGroupWMOID(other.iGroupWMOID),
-        vertices(other.vertices), triangles(other.triangles), meshTree(other.meshTree), iLiquid(0)
+        vertices(other.vertices), triangles(other.triangles),
+        iVertices(other.iVertices), iNVertices(other.iNVertices), iTriangles(other.iTriangles), iNTriangles(other.iNTriangles),
+        meshTree(other.meshTree), iLiquid(0)
     {
+        // owned geometry was copied, don't point into the other model's vectors
+        if (!vertices.empty())
+            iVertices = &vertices[0];
+        if (!triangles.empty())
+            iTriangles = &triangles[0];
         if (other.iLiquid)
             iLiquid = new WmoLiquid(*other.iLiquid);
     }
@@ -250,6 +269,10 @@ namespace VMAP
     {
         vertices.swap(vert);
         triangles.swap(tri);
+        iNVertices = vertices.size();
+        iVertices = iNVertices ? &vertices[0] : NULL;
+        iNTriangles = triangles.size();
+        iTriangles = iNTriangles ? &triangles[0] : NULL;
         TriBoundFunc bFunc(vertices);
         meshTree.build(triangles, bFunc);
     }
@@ -265,21 +288,21 @@ namespace VMAP
 
         // write vertices
         if (result && fwrite("VERT", 1, 4, wf) != 4) result = false;
-        count = vertices.size();
+        count = iNVertices;
         chunkSize = sizeof(uint32)+ sizeof(Vector3)*count;
         if (result && fwrite(&chunkSize, sizeof(uint32), 1, wf) != 1) result = false;
         if (result && fwrite(&count, sizeof(uint32), 1, wf) != 1) result = false;
         if (!count) // models without (collision) geometry end here, unsure if they are useful
             return result;
-        if (result && fwrite(&vertices[0], sizeof(Vector3), count, wf) != count) result = false;
+        if (result && fwrite(iVertices, sizeof(Vector3), count, wf) != count) result = false;
 
         // write triangle mesh
         if (result && fwrite("TRIM", 1, 4, wf) != 4) result = false;
-        count = triangles.size();
+        count = iNTriangles;
         chunkSize = sizeof(uint32)+ sizeof(MeshTriangle)*count;
         if (result && fwrite(&chunkSize, sizeof(uint32), 1, wf) != 1) result = false;
         if (result && fwrite(&count, sizeof(uint32), 1, wf) != 1) result = false;
-        if (result && fwrite(&triangles[0], sizeof(MeshTriangle), count, wf) != count) result = false;
+        if (result && fwrite(iTriangles, sizeof(MeshTriangle), count, wf) != count) result = false;
 
         // write mesh BIH
         if (result && fwrite("MBIH", 1, 4, wf) != 4) result = false;
@@ -300,78 +323,77 @@ namespace VMAP
         return result;
     }
 
-    bool GroupModel::readFromFile(FILE* rf)
+    bool GroupModel::readFromMemory(ChunkReader &reader)
     {
-        char chunk[8];
         bool result = true;
         uint32 chunkSize = 0;
-        uint32 count = 0;
         triangles.clear();
         vertices.clear();
+        iVertices = NULL;
+        iNVertices = 0;
+        iTriangles = NULL;
+        iNTriangles = 0;
         delete iLiquid;
         iLiquid = NULL;
 
-        if (result && fread(&iBound, sizeof(G3D::AABox), 1, rf) != 1) result = false;
-        if (result && fread(&iMogpFlags, sizeof(uint32), 1, rf) != 1) result = false;
-        if (result && fread(&iGroupWMOID, sizeof(uint32), 1, rf) != 1) result = false;
+        if (result && !reader.read(&iBound, sizeof(G3D::AABox))) result = false;
+        if (result && !reader.read(&iMogpFlags, sizeof(uint32))) result = false;
+        if (result && !reader.read(&iGroupWMOID, sizeof(uint32))) result = false;
 
         // read vertices
-        if (result && !readChunk(rf, chunk, "VERT", 4)) result = false;
-        if (result && fread(&chunkSize, sizeof(uint32), 1, rf) != 1) result = false;
-        if (result && fread(&count, sizeof(uint32), 1, rf) != 1) result = false;
-        if (!count) // models without (collision) geometry end here, unsure if they are useful
+        if (result && !reader.readChunk("VERT", 4)) result = false;
+        if (result && !reader.read(&chunkSize, sizeof(uint32))) result = false;
+        if (result && !reader.read(&iNVertices, sizeof(uint32))) result = false;
+        if (!iNVertices) // models without (collision) geometry end here, unsure if they are useful
             return result;
-        if (result) vertices.resize(count);
-        if (result && fread(&vertices[0], sizeof(Vector3), count, rf) != count) result = false;
+        if (result && !reader.readArray(iVertices, iNVertices)) result = false;
 
         // read triangle mesh
-        if (result && !readChunk(rf, chunk, "TRIM", 4)) result = false;
-        if (result && fread(&chunkSize, sizeof(uint32), 1, rf) != 1) result = false;
-        if (result && fread(&count, sizeof(uint32), 1, rf) != 1) result = false;
-        if (result) triangles.resize(count);
-        if (result && fread(&triangles[0], sizeof(MeshTriangle), count, rf) != count) result = false;
+        if (result && !reader.readChunk("TRIM", 4)) result = false;
+        if (result && !reader.read(&chunkSize, sizeof(uint32))) result = false;
+        if (result && !reader.read(&iNTriangles, sizeof(uint32))) result = false;
+        if (result && !reader.readArray(iTriangles, iNTriangles)) result = false;
 
         // read mesh BIH
-        if (result && !readChunk(rf, chunk, "MBIH", 4)) result = false;
-        if (result) result = meshTree.readFromFile(rf);
+        if (result && !reader.readChunk("MBIH", 4)) result = false;
+        if (result) result = meshTree.readFromMemory(reader);
 
-        // write liquid data
-        if (result && !readChunk(rf, chunk, "LIQU", 4)) result = false;
-        if (result && fread(&chunkSize, sizeof(uint32), 1, rf) != 1) result = false;
+        // read liquid data
+        if (result && !reader.readChunk("LIQU", 4)) result = false;
+        if (result && !reader.read(&chunkSize, sizeof(uint32))) result = false;
         if (result && chunkSize > 0)
-            result = WmoLiquid::readFromFile(rf, iLiquid);
+            result = WmoLiquid::readFromMemory(reader, iLiquid);
         return result;
     }
 
     struct GModelRayCallback
     {
-        GModelRayCallback(const std::vector<MeshTriangle> &tris, const std::vector<Vector3> &vert):
-            vertices(vert.begin()), triangles(tris.begin()), hit(false) {}
+        GModelRayCallback(const MeshTriangle* tris, const Vector3* vert):
+            vertices(vert), triangles(tris), hit(false) {}
         bool operator()(const G3D::Ray& ray, uint32 entry, float& distance, bool /*pStopAtFirstHit*/)
         {
             bool result = IntersectTriangle(triangles[entry], vertices, ray, distance);
             if (result)  hit=true;
             return hit;
         }
-        std::vector<Vector3>::const_iterator vertices;
-        std::vector<MeshTriangle>::const_iterator triangles;
+        const Vector3* vertices;
+        const MeshTriangle* triangles;
         bool hit;
     };
 
     bool GroupModel::IntersectRay(const G3D::Ray &ray, float &distance, bool stopAtFirstHit) const
     {
-        if (triangles.empty())
+        if (!iNTriangles)
             return false;
-        GModelRayCallback callback(triangles, vertices);
+        GModelRayCallback callback(iTriangles, iVertices);
         meshTree.intersectRay(ray, callback, distance, stopAtFirstHit);
         return callback.hit;
     }
 
     bool GroupModel::IsInsideObject(const Vector3 &pos, const Vector3 &down, float &z_dist) const
     {
-        if (triangles.empty() || !iBound.contains(pos))
+        if (!iNTriangles || !iBound.contains(pos))
             return false;
-        GModelRayCallback callback(triangles, vertices);
         Vector3 rPos = pos - 0.1f * down;
         float dist = G3D::inf();
         G3D::Ray ray(rPos, down);
@@ -398,6 +420,13 @@ namespace VMAP
 
     // ===================== WorldModel ==================================
 
+    WorldModel::~WorldModel()
+    {
+        // group models only reference the mapping
+        groupModels.clear();
+        delete iFile;
+    }
+
     void WorldModel::setGroupModels(std::vector<GroupModel> &models)
     {
         groupModels.swap(models);
@@ -534,37 +563,34 @@ namespace VMAP
 
     bool WorldModel::readFile(const std::string &filename)
     {
-        FILE* rf = fopen(filename.c_str(), "rb");
-        if (!rf)
+        delete iFile;
+        iFile = new MappedFile();
+        if (!iFile->open(filename))
             return false;
 
+        ChunkReader reader(*iFile);
         bool result = true;
         uint32 chunkSize = 0;
         uint32 count = 0;
-        char chunk[8];                          // Ignore the added magic header
-        if (!readChunk(rf, chunk, VMAP_MAGIC, 8)) result = false;
+        if (!reader.readChunk(VMAP_MAGIC, 8)) result = false;
 
-        if (result && !readChunk(rf, chunk, "WMOD", 4)) result = false;
-        if (result && fread(&chunkSize, sizeof(uint32), 1, rf) != 1) result = false;
-        if (result && fread(&RootWMOID, sizeof(uint32), 1, rf) != 1) result = false;
+        if (result && !reader.readChunk("WMOD", 4)) result = false;
+        if (result && !reader.read(&chunkSize, sizeof(uint32))) result = false;
+        if (result && !reader.read(&RootWMOID, sizeof(uint32))) result = false;
 
         // read group models
-        if (result && readChunk(rf, chunk, "GMOD", 4))
+        if (result && reader.readChunk("GMOD", 4))
         {
-            //if (fread(&chunkSize, sizeof(uint32), 1, rf) != 1) result = false;
-
-            if (result && fread(&count, sizeof(uint32), 1, rf) != 1) result = false;
+            if (result && !reader.read(&count, sizeof(uint32))) result = false;
             if (result) groupModels.resize(count);
-            //if (result && fread(&groupModels[0], sizeof(GroupModel), count, rf) != count) result = false;
             for (uint32 i=0; i<count && result; ++i)
-                result = groupModels[i].readFromFile(rf);
+                result = groupModels[i].readFromMemory(reader);
 
             // read group BIH
-            if (result && !readChunk(rf, chunk, "GBIH", 4)) result = false;
-            if (result) result = groupTree.readFromFile(rf);
+            if (result && !reader.readChunk("GBIH", 4)) result = false;
+            if (result) result = groupTree.readFromMemory(reader);
         }
 
-        fclose(rf);
         return result;
     }
 }
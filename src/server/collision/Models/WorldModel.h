@@ -32,6 +32,8 @@ namespace VMAP
     class TreeNode;
     struct AreaInfo;
     struct LocationInfo;
+    class MappedFile;
+    class ChunkReader;
 
     class MeshTriangle
     {
@@ -57,7 +59,7 @@ namespace VMAP
             uint8 *GetFlagsStorage() { return iFlags; }
             uint32 GetFileSize();
             bool writeToFile(FILE* wf);
-            static bool readFromFile(FILE* rf, WmoLiquid* &liquid);
+            static bool readFromMemory(ChunkReader &reader, WmoLiquid* &liquid);
         private:
             WmoLiquid(): iHeight(0), iFlags(0) {};
             uint32 iTilesX;  //!< number of tiles in x direction, each
@@ -72,10 +74,11 @@ namespace VMAP
     class GroupModel
     {
         public:
-            GroupModel(): iLiquid(0) {}
+            GroupModel(): iVertices(0), iNVertices(0), iTriangles(0), iNTriangles(0), iLiquid(0) {}
             GroupModel(const GroupModel &other);
             GroupModel(uint32 mogpFlags, uint32 groupWMOID, const AABox &bound):
-                        iBound(bound), iMogpFlags(mogpFlags), iGroupWMOID(groupWMOID), iLiquid(0) {}
+                        iBound(bound), iMogpFlags(mogpFlags), iGroupWMOID(groupWMOID),
+                        iVertices(0), iNVertices(0), iTriangles(0), iNTriangles(0), iLiquid(0) {}
             ~GroupModel() { delete iLiquid; }
 
             //! pass mesh data to object and create BIH. Passed vectors get get swapped with old geometry!
@@ -86,7 +89,8 @@ namespace VMAP
             bool GetLiquidLevel(const Vector3 &pos, float &liqHeight) const;
             uint32 GetLiquidType() const;
             bool writeToFile(FILE* wf);
-            bool readFromFile(FILE* rf);
+            //! vertices, triangles and mesh BIH stay in the reader's mapping
+            bool readFromMemory(ChunkReader &reader);
             const G3D::AABox& GetBound() const { return iBound; }
             uint32 GetMogpFlags() const { return iMogpFlags; }
             uint32 GetWmoID() const { return iGroupWMOID; }
@@ -94,8 +98,14 @@ namespace VMAP
             G3D::AABox iBound;
             uint32 iMogpFlags;// 0x8 outdor; 0x2000 indoor
             uint32 iGroupWMOID;
+            // owned geometry, only used while assembling; loaded models keep both empty
             std::vector<Vector3> vertices;
             std::vector<MeshTriangle> triangles;
+            // geometry used for intersection, points to the vectors above or into a mapped .vmo file
+            const Vector3* iVertices;
+            uint32 iNVertices;
+            const MeshTriangle* iTriangles;
+            uint32 iNTriangles;
             BIH meshTree;
             WmoLiquid* iLiquid;
     };
@@ -103,7 +113,8 @@ namespace VMAP
     class WorldModel
     {
         public:
-            WorldModel(): RootWMOID(0) {}
+            WorldModel(): RootWMOID(0), iFile(0) {}
+            ~WorldModel();
 
             //! pass group models to WorldModel and create BIH. Passed vector is swapped with old geometry!
             void setGroupModels(std::vector<GroupModel> &models);
@@ -112,11 +123,16 @@ namespace VMAP
             bool IntersectPoint(const G3D::Vector3 &p, const G3D::Vector3 &down, float &dist, AreaInfo &info) const;
             bool GetLocationInfo(const G3D::Vector3 &p, const G3D::Vector3 &down, float &dist, LocationInfo &info) const;
             bool writeFile(const std::string &filename);
+            //! maps the file, group meshes and trees are used in place and must not outlive this object
             bool readFile(const std::string &filename);
         protected:
             uint32 RootWMOID;
             std::vector<GroupModel> groupModels;
             BIH groupTree;
+            MappedFile* iFile;
+        private:
+            WorldModel(const WorldModel &);
+            WorldModel& operator=(const WorldModel &);
     };
 } // namespace VMAP
 
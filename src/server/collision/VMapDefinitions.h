@@ -19,14 +19,90 @@
 #ifndef _VMAPDEFINITIONS_H
 #define _VMAPDEFINITIONS_H
 #include <cstring>
+#include <string>
+#include <ace/Mem_Map.h>
+
+#include "Define.h"
 
 #define LIQUID_TILE_SIZE (533.333f / 128.f)
 
 namespace VMAP
 {
-    const char VMAP_MAGIC[] = "VMAP_3.0";
+    // 3.1: all arrays start on 4 byte boundaries, so files can be used in place from a mapping
+    const char VMAP_MAGIC[] = "VMAP_3.1";
 
     // defined in TileAssembler.cpp currently...
     bool readChunk(FILE* rf, char *dest, const char *compare, uint32 len);
+    // pad file to the next 4 byte boundary
+    bool writePadding(FILE* wf, uint32 written);
+
+    /**
+    Read-only mapping of a whole vmap file. Pages are only loaded on first access,
+    so untouched parts of a model or tree never cost memory.
+    */
+    class MappedFile
+    {
+        public:
+            MappedFile() {}
+            bool open(const std::string &filename)
+            {
+                return iMap.map(filename.c_str(), static_cast<size_t>(-1), O_RDONLY, ACE_DEFAULT_FILE_PERMS, PROT_READ, ACE_MAP_PRIVATE) != -1;
+            }
+            const void* data() const { return iMap.addr(); }
+            size_t size() const { return iMap.size(); }
+        private:
+            MappedFile(const MappedFile &);
+            MappedFile& operator=(const MappedFile &);
+            ACE_Mem_Map iMap;
+    };
+
+    /**
+    Sequential reader over a MappedFile. Plain values are copied out, arrays are
+    returned as pointers into the mapping and have to be 4 byte aligned.
+    */
+    class ChunkReader
+    {
+        public:
+            ChunkReader(const MappedFile &file):
+                iBase(static_cast<const char*>(file.data())), iPos(iBase), iEnd(iBase + file.size()) {}
+
+            bool read(void* dest, size_t size)
+            {
+                if (size > size_t(iEnd - iPos))
+                    return false;
+                memcpy(dest, iPos, size);
+                iPos += size;
+                return true;
+            }
+            bool readChunk(const char* compare, uint32 len)
+            {
+                if (len > size_t(iEnd - iPos) || memcmp(iPos, compare, len) != 0)
+                    return false;
+                iPos += len;
+                return true;
+            }
+            template<class T>
+            bool readArray(const T* &dest, uint32 count)
+            {
+                size_t size = size_t(count) * sizeof(T);
+                if (size > size_t(iEnd - iPos) || (size_t(iPos - iBase) & 3))
+                    return false;
+                dest = reinterpret_cast<const T*>(iPos);
+                iPos += size;
+                return true;
+            }
+            bool skipPadding()
+            {
+                size_t pad = (4 - (size_t(iPos - iBase) & 3)) & 3;
+                if (pad > size_t(iEnd - iPos))
+                    return false;
+                iPos += pad;
+                return true;
+            }
+        private:
+            const char* iBase;
+            const char* iPos;
+            const char* iEnd;
+    };
 }
 #endif
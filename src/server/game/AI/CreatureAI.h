@@ -91,6 +91,10 @@ class CreatureAI : public UnitAI
         // Called in Creature::Update when deathstate = DEAD. Inherited classes may maniuplate the ability to respawn based on scripted events.
         virtual bool CanRespawn() { return true; }
 
+        // Idle creatures out of combat skip updates for up to Creature.IdleSleepTime ms and then get the
+        // summed diff at once. Return false if the AI needs every update while idle (precise timers)
+        virtual bool CanSleep() const { return true; }
+
         // Called for reaction at stopping attack at no attackers or targets
         virtual void EnterEvadeMode();
 
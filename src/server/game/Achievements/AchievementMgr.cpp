@@ -426,6 +426,7 @@ void AchievementMgr::Reset()
 
     m_completedAchievements.clear();
     m_criteriaProgress.clear();
+    m_closedCriteria.clear();
     DeleteFromDB(m_player->GetGUIDLow());
 
     // re-fill data
@@ -631,6 +632,9 @@ void AchievementMgr::LoadFromDB(PreparedQueryResult achievementResult, PreparedQ
             progress.changed = false;
         } while (criteriaResult->NextRow());
     }
+
+    for (CompletedAchievementMap::const_iterator itr = m_completedAchievements.begin(); itr != m_completedAchievements.end(); ++itr)
+        CloseCompletedCriteria(sAchievementStore.LookupEntry(itr->first));
 }
 
 void AchievementMgr::SendAchievementEarned(AchievementEntry const* achievement) const
@@ -739,10 +743,16 @@ void AchievementMgr::UpdateAchievementCriteria(AchievementCriteriaTypes type, ui
     if (m_player->isGameMaster())
         return;
 
-    AchievementCriteriaEntryList const& achievementCriteriaList = sAchievementMgr->GetAchievementCriteriaByType(type);
+    // most events only concern the few criteria referencing their creature, item, spell... directly
+    AchievementCriteriaEntryList const& achievementCriteriaList = miscValue1 && AchievementGlobalMgr::IsCriteriaTypeIndexedByAsset(type)
+        ? sAchievementMgr->GetAchievementCriteriaByAsset(type, miscValue1)
+        : sAchievementMgr->GetAchievementCriteriaByType(type);
     for (AchievementCriteriaEntryList::const_iterator i = achievementCriteriaList.begin(); i != achievementCriteriaList.end(); ++i)
     {
         AchievementCriteriaEntry const* achievementCriteria = (*i);
+        if (IsClosedCriteria(achievementCriteria->ID))
+            continue;
+
         AchievementEntry const* achievement = sAchievementStore.LookupEntry(achievementCriteria->referredAchievement);
         if (!achievement)
             continue;
@@ -1937,6 +1947,37 @@ void AchievementMgr::RemoveCriteriaProgress(const AchievementCriteriaEntry* entr
     m_player->SendDirectMessage(&data);
 
     m_criteriaProgress.erase(criteriaProgress);
+
+    if (IsClosedCriteria(entry->ID))
+        m_closedCriteria[entry->ID] = false;
+}
+
+void AchievementMgr::CloseCompletedCriteria(AchievementEntry const* achievement)
+{
+    if (!achievement)
+        return;
+
+    // criteria of a referenced achievement keep counting for the achievements referencing it
+    if (achievement->refAchievement)
+        achievement = sAchievementStore.LookupEntry(achievement->refAchievement);
+
+    if (!achievement || !HasAchieved(achievement))
+        return;
+
+    if (AchievementEntryList const* refList = sAchievementMgr->GetAchievementByReferencedId(achievement->ID))
+        for (AchievementEntryList::const_iterator itr = refList->begin(); itr != refList->end(); ++itr)
+            if (!HasAchieved(*itr))
+                return;
+
+    AchievementCriteriaEntryList const* cList = sAchievementMgr->GetAchievementCriteriaByAchievement(achievement->ID);
+    if (!cList)
+        return;
+
+    if (m_closedCriteria.empty())
+        m_closedCriteria.resize(sAchievementCriteriaStore.GetNumRows(), false);
+
+    for (AchievementCriteriaEntryList::const_iterator itr = cList->begin(); itr != cList->end(); ++itr)
+        m_closedCriteria[(*itr)->ID] = true;
 }
 
 void AchievementMgr::UpdateTimedAchievements(uint32 timeDiff)
@@ -2026,6 +2067,8 @@ void AchievementMgr::CompletedAchievement(AchievementEntry const* achievement)
     if (!(achievement->flags & ACHIEVEMENT_FLAG_REALM_FIRST_KILL))
         sAchievementMgr->SetRealmCompleted(achievement);
 
+    CloseCompletedCriteria(achievement);
+
     UpdateAchievementCriteria(ACHIEVEMENT_CRITERIA_TYPE_COMPLETE_ACHIEVEMENT);
     UpdateAchievementCriteria(ACHIEVEMENT_CRITERIA_TYPE_EARN_ACHIEVEMENT_POINTS, achievement->points);
 
@@ -2192,6 +2235,8 @@ void AchievementGlobalMgr::LoadAchievementCriteriaList()
             continue;
 
         m_AchievementCriteriasByType[criteria->requiredType].push_back(criteria);
+        if (IsCriteriaTypeIndexedByAsset(AchievementCriteriaTypes(criteria->requiredType)))
+            m_AchievementCriteriasByAsset[criteria->requiredType][criteria->raw.field3].push_back(criteria);
         m_AchievementCriteriaListByAchievement[criteria->referredAchievement].push_back(criteria);
 
         if (criteria->timeLimit)
@@ -2202,6 +2247,43 @@ void AchievementGlobalMgr::LoadAchievementCriteriaList()
     sLog->outString();
 }
 
+bool AchievementGlobalMgr::IsCriteriaTypeIndexedByAsset(AchievementCriteriaTypes type)
+{
+    // must match the miscValue1 checks in AchievementMgr::UpdateAchievementCriteria
+    switch (type)
+    {
+        case ACHIEVEMENT_CRITERIA_TYPE_KILL_CREATURE:
+        case ACHIEVEMENT_CRITERIA_TYPE_REACH_SKILL_LEVEL:
+        case ACHIEVEMENT_CRITERIA_TYPE_COMPLETE_QUESTS_IN_ZONE:
+        case ACHIEVEMENT_CRITERIA_TYPE_KILLED_BY_CREATURE:
+        case ACHIEVEMENT_CRITERIA_TYPE_COMPLETE_QUEST:
+        case ACHIEVEMENT_CRITERIA_TYPE_BE_SPELL_TARGET:
+        case ACHIEVEMENT_CRITERIA_TYPE_BE_SPELL_TARGET2:
+        case ACHIEVEMENT_CRITERIA_TYPE_CAST_SPELL:
+        case ACHIEVEMENT_CRITERIA_TYPE_CAST_SPELL2:
+        case ACHIEVEMENT_CRITERIA_TYPE_LEARN_SPELL:
+        case ACHIEVEMENT_CRITERIA_TYPE_LOOT_TYPE:
+        case ACHIEVEMENT_CRITERIA_TYPE_OWN_ITEM:
+        case ACHIEVEMENT_CRITERIA_TYPE_USE_ITEM:
+        case ACHIEVEMENT_CRITERIA_TYPE_LOOT_ITEM:
+        case ACHIEVEMENT_CRITERIA_TYPE_LEARN_SKILL_LEVEL:
+        case ACHIEVEMENT_CRITERIA_TYPE_GAIN_REPUTATION:
+        case ACHIEVEMENT_CRITERIA_TYPE_DO_EMOTE:
+        case ACHIEVEMENT_CRITERIA_TYPE_EQUIP_ITEM:
+        case ACHIEVEMENT_CRITERIA_TYPE_USE_GAMEOBJECT:
+        case ACHIEVEMENT_CRITERIA_TYPE_FISH_IN_GAMEOBJECT:
+        case ACHIEVEMENT_CRITERIA_TYPE_LEARN_SKILLLINE_SPELLS:
+        case ACHIEVEMENT_CRITERIA_TYPE_LEARN_SKILL_LINE:
+        case ACHIEVEMENT_CRITERIA_TYPE_HK_CLASS:
+        case ACHIEVEMENT_CRITERIA_TYPE_HK_RACE:
+        case ACHIEVEMENT_CRITERIA_TYPE_BG_OBJECTIVE_CAPTURE:
+        case ACHIEVEMENT_CRITERIA_TYPE_HONORABLE_KILL_AT_AREA:
+            return true;
+        default:
+            return false;
+    }
+}
+
 void AchievementGlobalMgr::LoadAchievementReferenceList()
 {
     uint32 oldMSTime = getMSTime();
@@ -32,6 +32,7 @@ typedef std::list<AchievementEntry const*>         AchievementEntryList;
 
 typedef std::map<uint32, AchievementCriteriaEntryList> AchievementCriteriaListByAchievement;
 typedef std::map<uint32, AchievementEntryList>         AchievementListByReferencedId;
+typedef UNORDERED_MAP<uint32, AchievementCriteriaEntryList> AchievementCriteriaListByAsset;
 
 struct CriteriaProgress
 {
@@ -272,6 +273,8 @@ class AchievementMgr
         void RemoveCriteriaProgress(AchievementCriteriaEntry const* entry);
         void CompletedCriteriaFor(AchievementEntry const* achievement);
         bool IsCompletedCriteria(AchievementCriteriaEntry const* achievementCriteria, AchievementEntry const* achievement);
+        bool IsClosedCriteria(uint32 criteriaId) const { return criteriaId < m_closedCriteria.size() && m_closedCriteria[criteriaId]; }
+        void CloseCompletedCriteria(AchievementEntry const* achievement);
         bool IsCompletedAchievement(AchievementEntry const* entry);
         bool CanUpdateCriteria(AchievementCriteriaEntry const* criteria, AchievementEntry const* achievement);
         void BuildAllDataPacket(WorldPacket* data) const;
@@ -281,6 +284,9 @@ class AchievementMgr
         CompletedAchievementMap m_completedAchievements;
         typedef std::map<uint32, uint32> TimedAchievementMap;
         TimedAchievementMap m_timedAchievements;      // Criteria id/time left in MS
+        // criteria whose achievement and all achievements referencing it are earned, indexed by criteria id;
+        // UpdateAchievementCriteria skips them without any further lookup
+        std::vector<bool> m_closedCriteria;
 };
 
 class AchievementGlobalMgr
@@ -295,6 +301,16 @@ class AchievementGlobalMgr
             return m_AchievementCriteriasByType[type];
         }
 
+        // Criteria of the given type whose main requirement is asset. Only valid for IsCriteriaTypeIndexedByAsset types.
+        AchievementCriteriaEntryList const& GetAchievementCriteriaByAsset(AchievementCriteriaTypes type, uint32 asset) const
+        {
+            AchievementCriteriaListByAsset::const_iterator itr = m_AchievementCriteriasByAsset[type].find(asset);
+            return itr != m_AchievementCriteriasByAsset[type].end() ? itr->second : m_emptyCriteriaList;
+        }
+
+        // Types whose criteria are all skipped unless a non zero miscvalue1 equals their main requirement (raw.field3)
+        static bool IsCriteriaTypeIndexedByAsset(AchievementCriteriaTypes type);
+
         AchievementCriteriaEntryList const& GetTimedAchievementCriteriaByType(AchievementCriteriaTimedTypes type) const
         {
             return m_AchievementCriteriasByTimedType[type];
@@ -352,6 +368,9 @@ class AchievementGlobalMgr
         // store achievement criterias by type to speed up lookup
         AchievementCriteriaEntryList m_AchievementCriteriasByType[ACHIEVEMENT_CRITERIA_TYPE_TOTAL];
         AchievementCriteriaEntryList m_AchievementCriteriasByTimedType[ACHIEVEMENT_TIMED_TYPE_MAX];
+        // and by type and main requirement for types that filter on it
+        AchievementCriteriaListByAsset m_AchievementCriteriasByAsset[ACHIEVEMENT_CRITERIA_TYPE_TOTAL];
+        AchievementCriteriaEntryList m_emptyCriteriaList;
         // store achievement criterias by achievement to speed up lookup
         AchievementCriteriaListByAchievement m_AchievementCriteriaListByAchievement;
         // store achievements by referenced achievement id to speed up lookup
@@ -1,7 +1,7 @@
 #include "AnticheatScripts.h"
 #include "AnticheatMgr.h"
 
-AnticheatScripts::AnticheatScripts(): PlayerScript("AnticheatScripts") {}
+AnticheatScripts::AnticheatScripts(): PlayerScript("AnticheatScripts", SCRIPT_HOOK_MASK(PLAYERHOOK_LOGIN) | SCRIPT_HOOK_MASK(PLAYERHOOK_LOGOUT)) {}
 
 void AnticheatScripts::OnLogout(Player* player)
 {
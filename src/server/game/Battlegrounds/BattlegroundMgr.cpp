@@ -55,7 +55,7 @@ BattlegroundMgr::BattlegroundMgr() : m_AutoDistributionTimeChecker(0), m_ArenaTe
 {
     for (uint32 i = BATTLEGROUND_TYPE_NONE; i < MAX_BATTLEGROUND_TYPE_ID; i++)
         m_Battlegrounds[i].clear();
-    m_NextRatingDiscardUpdate = sWorld->getIntConfig(CONFIG_ARENA_RATING_DISCARD_TIMER);
+    m_NextRatingDiscardUpdate = GetRatedQueueUpdateInterval();
     m_Testing=false;
 }
 
@@ -116,6 +116,10 @@ void BattlegroundMgr::Update(uint32 diff)
         }
     }
 
+    // invitation reminders and timeouts
+    for (uint32 i = 0; i < MAX_BATTLEGROUND_QUEUE_TYPES; ++i)
+        m_BattlegroundQueues[i].UpdateTimers(diff);
+
     // update scheduled queues
     if (!m_QueueUpdateScheduler.empty())
     {
@@ -139,7 +143,7 @@ void BattlegroundMgr::Update(uint32 diff)
     }
 
     // if rating difference counts, maybe force-update queues
-    if (sWorld->getIntConfig(CONFIG_ARENA_MAX_RATING_DIFFERENCE) && sWorld->getIntConfig(CONFIG_ARENA_RATING_DISCARD_TIMER))
+    if (sWorld->getIntConfig(CONFIG_ARENA_MAX_RATING_DIFFERENCE) && (sWorld->getIntConfig(CONFIG_ARENA_RATING_DISCARD_TIMER) || sWorld->getIntConfig(CONFIG_ARENA_RATING_WINDOW_WIDENING)))
     {
         // it's time to force update
         if (m_NextRatingDiscardUpdate < diff)
@@ -152,7 +156,7 @@ void BattlegroundMgr::Update(uint32 diff)
                         BATTLEGROUND_AA, BattlegroundBracketId(bracket),
                         BattlegroundMgr::BGArenaType(BattlegroundQueueTypeId(qtype)), true, 0);
 
-            m_NextRatingDiscardUpdate = sWorld->getIntConfig(CONFIG_ARENA_RATING_DISCARD_TIMER);
+            m_NextRatingDiscardUpdate = GetRatedQueueUpdateInterval();
         }
         else
             m_NextRatingDiscardUpdate -= diff;
@@ -1052,6 +1056,15 @@ uint32 BattlegroundMgr::GetRatingDiscardTimer() const
     return sWorld->getIntConfig(CONFIG_ARENA_RATING_DISCARD_TIMER);
 }
 
+// the rating window of waiting teams grows every minute, they have to be checked at least that often
+uint32 BattlegroundMgr::GetRatedQueueUpdateInterval() const
+{
+    uint32 interval = GetRatingDiscardTimer();
+    if (sWorld->getIntConfig(CONFIG_ARENA_RATING_WINDOW_WIDENING) && (!interval || interval > MINUTE * IN_MILLISECONDS))
+        interval = MINUTE * IN_MILLISECONDS;
+    return interval;
+}
+
 uint32 BattlegroundMgr::GetPrematureFinishTime() const
 {
     return sWorld->getIntConfig(CONFIG_BATTLEGROUND_PREMATURE_FINISH_TIMER);
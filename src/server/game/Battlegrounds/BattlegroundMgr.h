@@ -102,6 +102,7 @@ class BattlegroundMgr
         void ScheduleQueueUpdate(uint32 arenaMatchmakerRating, uint8 arenaType, BattlegroundQueueTypeId bgQueueTypeId, BattlegroundTypeId bgTypeId, BattlegroundBracketId bracket_id);
         uint32 GetMaxRatingDifference() const;
         uint32 GetRatingDiscardTimer()  const;
+        uint32 GetRatedQueueUpdateInterval() const;
         uint32 GetPrematureFinishTime() const;
 
         void InitAutomaticArenaPointDistribution();
@@ -41,12 +41,17 @@ BattlegroundQueue::BattlegroundQueue()
                 m_WaitTimes[i][j][k] = 0;
         }
     }
+
+    for (uint32 i = 0; i < MAX_BATTLEGROUND_BRACKETS; ++i)
+        for (uint32 j = 0; j < BG_QUEUE_GROUP_TYPES_COUNT; ++j)
+            m_WaitingPlayers[i][j] = 0;
+
+    m_TimerWheelPos = 0;
+    m_TimerWheelTime = 0;
 }
 
 BattlegroundQueue::~BattlegroundQueue()
 {
-    m_events.KillAllEvents(false);
-
     m_QueuedPlayers.clear();
     for (int i = 0; i < MAX_BATTLEGROUND_BRACKETS; ++i)
     {
@@ -154,6 +159,8 @@ GroupQueueInfo* BattlegroundQueue::AddGroup(Player* leader, Group* grp, Battlegr
         index += BG_TEAMS_COUNT;
     if (ginfo->Team == HORDE)
         index++;
+    ginfo->BracketId = bracketId;
+    ginfo->QueueIndex = index;
     sLog->outDebug(LOG_FILTER_BATTLEGROUND, "Adding Group to BattlegroundQueue bgTypeId : %u, bracket_id : %u, index : %u", BgTypeId, bracketId, index);
 
     uint32 lastOnlineTime = getMSTime();
@@ -192,7 +199,10 @@ GroupQueueInfo* BattlegroundQueue::AddGroup(Player* leader, Group* grp, Battlegr
         }
 
         //add GroupInfo to m_QueuedGroups
-        m_QueuedGroups[bracketId][index].push_back(ginfo);
+        ginfo->QueuePosition = m_QueuedGroups[bracketId][index].insert(m_QueuedGroups[bracketId][index].end(), ginfo);
+        m_WaitingPlayers[bracketId][index] += ginfo->Players.size();
+        if (isRated)
+            AddRatedGroup(ginfo);
 
         //announce to world, this code needs mutex
         if (!isRated && !isPremade && sWorld->getBoolConfig(CONFIG_BATTLEGROUND_QUEUE_ANNOUNCER_ENABLE))
@@ -201,17 +211,10 @@ GroupQueueInfo* BattlegroundQueue::AddGroup(Player* leader, Group* grp, Battlegr
             {
                 char const* bgName = bg->GetName();
                 uint32 MinPlayers = bg->GetMinPlayersPerTeam();
-                uint32 qHorde = 0;
-                uint32 qAlliance = 0;
+                uint32 qHorde = m_WaitingPlayers[bracketId][BG_QUEUE_NORMAL_HORDE];
+                uint32 qAlliance = m_WaitingPlayers[bracketId][BG_QUEUE_NORMAL_ALLIANCE];
                 uint32 q_min_level = bracketEntry->minLevel;
                 uint32 q_max_level = bracketEntry->maxLevel;
-                GroupsQueueType::const_iterator itr;
-                for (itr = m_QueuedGroups[bracketId][BG_QUEUE_NORMAL_ALLIANCE].begin(); itr != m_QueuedGroups[bracketId][BG_QUEUE_NORMAL_ALLIANCE].end(); ++itr)
-                    if (!(*itr)->IsInvitedToBGInstanceGUID)
-                        qAlliance += (*itr)->Players.size();
-                for (itr = m_QueuedGroups[bracketId][BG_QUEUE_NORMAL_HORDE].begin(); itr != m_QueuedGroups[bracketId][BG_QUEUE_NORMAL_HORDE].end(); ++itr)
-                    if (!(*itr)->IsInvitedToBGInstanceGUID)
-                        qHorde += (*itr)->Players.size();
 
                 // Show queue status to player only (when joining queue)
                 if (sWorld->getBoolConfig(CONFIG_BATTLEGROUND_QUEUE_ANNOUNCER_PLAYERONLY))
@@ -285,52 +288,19 @@ uint32 BattlegroundQueue::GetAverageQueueWaitTime(GroupQueueInfo* ginfo, Battleg
 //remove player from queue and from group info, if group info is empty then remove it too
 void BattlegroundQueue::RemovePlayer(uint64 guid, bool decreaseInvitedCount)
 {
-    //Player* plr = ObjectAccessor::FindPlayer(guid);
-
-    int32 bracket_id = -1;                                     // signed for proper for-loop finish
-    QueuedPlayersMap::iterator itr;
-
     //remove player from map, if he's there
-    itr = m_QueuedPlayers.find(guid);
+    QueuedPlayersMap::iterator itr = m_QueuedPlayers.find(guid);
     if (itr == m_QueuedPlayers.end())
     {
         sLog->outError("BattlegroundQueue: couldn't find player to remove GUID: %u", GUID_LOPART(guid));
         return;
     }
 
+    // the group knows where it is queued, its team may have changed since it joined
     GroupQueueInfo* group = itr->second.GroupInfo;
-    GroupsQueueType::iterator group_itr, group_itr_tmp;
-    // mostly people with the highest levels are in battlegrounds, thats why
-    // we count from MAX_BATTLEGROUND_QUEUES - 1 to 0
-    // variable index removes useless searching in other team's queue
-    uint32 index = (group->Team == HORDE) ? BG_TEAM_HORDE : BG_TEAM_ALLIANCE;
+    BattlegroundBracketId bracket_id = group->BracketId;
+    uint32 index = group->QueueIndex;
 
-    for (int32 bracket_id_tmp = MAX_BATTLEGROUND_BRACKETS - 1; bracket_id_tmp >= 0 && bracket_id == -1; --bracket_id_tmp)
-    {
-        //we must check premade and normal team's queue - because when players from premade are joining bg,
-        //they leave groupinfo so we can't use its players size to find out index
-        for (uint32 j = index; j < BG_QUEUE_GROUP_TYPES_COUNT; j += BG_QUEUE_NORMAL_ALLIANCE)
-        {
-            for (group_itr_tmp = m_QueuedGroups[bracket_id_tmp][j].begin(); group_itr_tmp != m_QueuedGroups[bracket_id_tmp][j].end(); ++group_itr_tmp)
-            {
-                if ((*group_itr_tmp) == group)
-                {
-                    bracket_id = bracket_id_tmp;
-                    group_itr = group_itr_tmp;
-                    //we must store index to be able to erase iterator
-                    index = j;
-                    break;
-                }
-            }
-        }
-    }
-
-    //player can't be in queue without group, but just in case
-    if (bracket_id == -1)
-    {
-        sLog->outError("BattlegroundQueue: ERROR Cannot find groupinfo for player GUID: %u", GUID_LOPART(guid));
-        return;
-    }
     sLog->outDebug(LOG_FILTER_BATTLEGROUND, "BattlegroundQueue: Removing player GUID %u, from bracket_id %u", GUID_LOPART(guid), (uint32)bracket_id);
 
     // ALL variables are correctly set
@@ -351,6 +321,9 @@ void BattlegroundQueue::RemovePlayer(uint64 guid, bool decreaseInvitedCount)
     // remove player queue info
     m_QueuedPlayers.erase(itr);
 
+    if (!group->IsInvitedToBGInstanceGUID)
+        --m_WaitingPlayers[bracket_id][index];
+
     // announce to world if arena team left queue for rated match, show only once
     if (group->ArenaType && group->IsRated && group->Players.empty() && sWorld->getBoolConfig(CONFIG_ARENA_QUEUE_ANNOUNCER_ENABLE))
         if (ArenaTeam* Team = sArenaTeamMgr->GetArenaTeamById(group->ArenaTeamId))
@@ -373,7 +346,9 @@ void BattlegroundQueue::RemovePlayer(uint64 guid, bool decreaseInvitedCount)
     // remove group queue info if needed
     if (group->Players.empty())
     {
-        m_QueuedGroups[bracket_id][index].erase(group_itr);
+        m_QueuedGroups[bracket_id][index].erase(group->QueuePosition);
+        if (group->IsRated)
+            RemoveRatedGroup(group);
         delete group;
     }
     // if group wasn't empty, so it wasn't deleted, and player have left a rated
@@ -428,6 +403,7 @@ bool BattlegroundQueue::InviteGroupToBG(GroupQueueInfo* ginfo, Battleground* bg,
         // not yet invited
         // set invitation
         ginfo->IsInvitedToBGInstanceGUID = bg->GetInstanceID();
+        m_WaitingPlayers[ginfo->BracketId][ginfo->QueueIndex] -= ginfo->Players.size();
         BattlegroundTypeId bgTypeId = bg->GetTypeID();
         BattlegroundQueueTypeId bgQueueTypeId = BattlegroundMgr::BGQueueTypeId(bgTypeId, bg->GetArenaType());
         BattlegroundBracketId bracket_id = bg->GetBracketId();
@@ -456,12 +432,18 @@ bool BattlegroundQueue::InviteGroupToBG(GroupQueueInfo* ginfo, Battleground* bg,
 
             plr->SetInviteForBattlegroundQueueType(bgQueueTypeId, ginfo->IsInvitedToBGInstanceGUID);
 
-            // create remind invite events
-            BGQueueInviteEvent* inviteEvent = new BGQueueInviteEvent(plr->GetGUID(), ginfo->IsInvitedToBGInstanceGUID, bgTypeId, ginfo->ArenaType, ginfo->RemoveInviteTime);
-            m_events.AddEvent(inviteEvent, m_events.CalculateTime(INVITATION_REMIND_TIME));
-            // create automatic remove events
-            BGQueueRemoveEvent* removeEvent = new BGQueueRemoveEvent(plr->GetGUID(), ginfo->IsInvitedToBGInstanceGUID, bgTypeId, bgQueueTypeId, ginfo->RemoveInviteTime);
-            m_events.AddEvent(removeEvent, m_events.CalculateTime(INVITE_ACCEPT_WAIT_TIME));
+            // remind the player of the invitation, then remove him if he didn't enter
+            BGQueueTimer timer;
+            timer.PlayerGuid = plr->GetGUID();
+            timer.BgInstanceGUID = ginfo->IsInvitedToBGInstanceGUID;
+            timer.RemoveTime = ginfo->RemoveInviteTime;
+            timer.BgTypeId = bgTypeId;
+            timer.BgQueueTypeId = bgQueueTypeId;
+            timer.ArenaType = ginfo->ArenaType;
+            timer.Type = BG_QUEUE_TIMER_INVITE_REMIND;
+            AddTimer(timer, INVITATION_REMIND_TIME);
+            timer.Type = BG_QUEUE_TIMER_INVITE_REMOVE;
+            AddTimer(timer, INVITE_ACCEPT_WAIT_TIME);
 
             WorldPacket data;
 
@@ -479,6 +461,88 @@ bool BattlegroundQueue::InviteGroupToBG(GroupQueueInfo* ginfo, Battleground* bg,
     return false;
 }
 
+// moves a group to the front of another queue of its bracket
+void BattlegroundQueue::MoveGroup(GroupQueueInfo* ginfo, uint32 index)
+{
+    m_QueuedGroups[ginfo->BracketId][ginfo->QueueIndex].erase(ginfo->QueuePosition);
+
+    if (ginfo->IsRated)
+        RemoveRatedGroup(ginfo);
+    if (!ginfo->IsInvitedToBGInstanceGUID)
+    {
+        m_WaitingPlayers[ginfo->BracketId][ginfo->QueueIndex] -= ginfo->Players.size();
+        m_WaitingPlayers[ginfo->BracketId][index] += ginfo->Players.size();
+    }
+
+    ginfo->QueueIndex = index;
+    ginfo->QueuePosition = m_QueuedGroups[ginfo->BracketId][index].insert(m_QueuedGroups[ginfo->BracketId][index].begin(), ginfo);
+    if (ginfo->IsRated)
+        AddRatedGroup(ginfo);
+}
+
+void BattlegroundQueue::AddRatedGroup(GroupQueueInfo* ginfo)
+{
+    GroupsQueueType& bucket = m_RatedGroups[ginfo->BracketId][ginfo->QueueIndex][ginfo->ArenaMatchmakerRating / ARENA_RATING_BUCKET_SIZE];
+
+    // keep join order, only groups moved between queues are not the latest joined
+    GroupsQueueType::iterator itr = bucket.end();
+    while (itr != bucket.begin())
+    {
+        GroupsQueueType::iterator prev = itr;
+        if ((*--prev)->JoinTime <= ginfo->JoinTime)
+            break;
+        itr = prev;
+    }
+    ginfo->RatedPosition = bucket.insert(itr, ginfo);
+}
+
+void BattlegroundQueue::RemoveRatedGroup(GroupQueueInfo* ginfo)
+{
+    RatingBuckets& buckets = m_RatedGroups[ginfo->BracketId][ginfo->QueueIndex];
+    RatingBuckets::iterator bucket = buckets.find(ginfo->ArenaMatchmakerRating / ARENA_RATING_BUCKET_SIZE);
+    if (bucket == buckets.end())
+        return;
+
+    bucket->second.erase(ginfo->RatedPosition);
+    if (bucket->second.empty())
+        buckets.erase(bucket);
+}
+
+// returns the longest waiting, not yet invited rated group of queue index that either has
+// its rating inside [minRating, maxRating] or waits longer than discardTime
+GroupQueueInfo* BattlegroundQueue::SelectRatedGroup(BattlegroundBracketId bracket_id, uint32 index, uint32 minRating, uint32 maxRating, uint32 discardTime, GroupQueueInfo const* exclude) const
+{
+    // the queue is in join order, only its head can be past the discard time
+    for (GroupsQueueType::const_iterator itr = m_QueuedGroups[bracket_id][index].begin(); itr != m_QueuedGroups[bracket_id][index].end(); ++itr)
+    {
+        if ((*itr)->IsInvitedToBGInstanceGUID || *itr == exclude)
+            continue;
+        if ((*itr)->JoinTime >= discardTime)
+            break;
+        return *itr;
+    }
+
+    GroupQueueInfo* selected = NULL;
+    RatingBuckets const& buckets = m_RatedGroups[bracket_id][index];
+    RatingBuckets::const_iterator end = buckets.upper_bound(maxRating / ARENA_RATING_BUCKET_SIZE);
+    for (RatingBuckets::const_iterator bucket = buckets.lower_bound(minRating / ARENA_RATING_BUCKET_SIZE); bucket != end; ++bucket)
+    {
+        // first match of a bucket is the longest waiting one of that bucket
+        for (GroupsQueueType::const_iterator itr = bucket->second.begin(); itr != bucket->second.end(); ++itr)
+        {
+            GroupQueueInfo* ginfo = *itr;
+            if (ginfo->IsInvitedToBGInstanceGUID || ginfo == exclude
+                || ginfo->ArenaMatchmakerRating < minRating || ginfo->ArenaMatchmakerRating > maxRating)
+                continue;
+
+            if (!selected || ginfo->JoinTime < selected->JoinTime)
+                selected = ginfo;
+            break;
+        }
+    }
+    return selected;
+}
+
 /*
 This function is inviting players to already running battlegrounds
 Invitation type is based on config file
@@ -486,6 +550,9 @@ large groups are disadvantageous, because they will be kicked first if invitatio
 */
 void BattlegroundQueue::FillPlayersToBG(Battleground* bg, BattlegroundBracketId bracket_id)
 {
+    if (!m_WaitingPlayers[bracket_id][BG_QUEUE_NORMAL_ALLIANCE] && !m_WaitingPlayers[bracket_id][BG_QUEUE_NORMAL_HORDE])
+        return;
+
     int32 hordeFree = bg->GetFreeSlotsForTeam(HORDE);
     int32 aliFree   = bg->GetFreeSlotsForTeam(ALLIANCE);
 
@@ -606,12 +673,11 @@ bool BattlegroundQueue::CheckPremadeMatch(BattlegroundBracketId bracket_id, uint
     {
         if (!m_QueuedGroups[bracket_id][BG_QUEUE_PREMADE_ALLIANCE + i].empty())
         {
-            GroupsQueueType::iterator itr = m_QueuedGroups[bracket_id][BG_QUEUE_PREMADE_ALLIANCE + i].begin();
-            if (!(*itr)->IsInvitedToBGInstanceGUID && ((*itr)->JoinTime < time_before || (*itr)->Players.size() < MinPlayersPerTeam))
+            GroupQueueInfo* ginfo = m_QueuedGroups[bracket_id][BG_QUEUE_PREMADE_ALLIANCE + i].front();
+            if (!ginfo->IsInvitedToBGInstanceGUID && (ginfo->JoinTime < time_before || ginfo->Players.size() < MinPlayersPerTeam))
             {
                 //we must insert group to normal queue and erase pointer from premade queue
-                m_QueuedGroups[bracket_id][BG_QUEUE_NORMAL_ALLIANCE + i].push_front((*itr));
-                m_QueuedGroups[bracket_id][BG_QUEUE_PREMADE_ALLIANCE + i].erase(itr);
+                MoveGroup(ginfo, BG_QUEUE_NORMAL_ALLIANCE + i);
             }
         }
     }
@@ -622,6 +688,14 @@ bool BattlegroundQueue::CheckPremadeMatch(BattlegroundBracketId bracket_id, uint
 // this method tries to create battleground or arena with MinPlayersPerTeam against MinPlayersPerTeam
 bool BattlegroundQueue::CheckNormalMatch(Battleground* bg_template, BattlegroundBracketId bracket_id, uint32 minPlayers, uint32 maxPlayers)
 {
+    // don't walk the queues when not enough players joined since the last match, a same faction
+    // skirmish (see CheckSkirmishForSameFaction) needs both teams from one queue
+    uint32 waitingAli = m_WaitingPlayers[bracket_id][BG_QUEUE_NORMAL_ALLIANCE];
+    uint32 waitingHorde = m_WaitingPlayers[bracket_id][BG_QUEUE_NORMAL_HORDE];
+    if (!sBattlegroundMgr->isTesting() && (waitingAli < minPlayers || waitingHorde < minPlayers)
+        && (!bg_template->isArena() || (waitingAli < 2 * minPlayers && waitingHorde < 2 * minPlayers)))
+        return false;
+
     GroupsQueueType::const_iterator itr_team[BG_TEAMS_COUNT];
     for (uint32 i = 0; i < BG_TEAMS_COUNT; i++)
     {
@@ -704,19 +778,8 @@ bool BattlegroundQueue::CheckSkirmishForSameFaction(BattlegroundBracketId bracke
     {
         //set correct team
         (*itr)->Team = otherTeamId;
-        //add team to other queue
-        m_QueuedGroups[bracket_id][BG_QUEUE_NORMAL_ALLIANCE + otherTeam].push_front(*itr);
-        //remove team from old queue
-        GroupsQueueType::iterator itr2 = itr_team;
-        ++itr2;
-        for (; itr2 != m_QueuedGroups[bracket_id][BG_QUEUE_NORMAL_ALLIANCE + teamIndex].end(); ++itr2)
-        {
-            if (*itr2 == *itr)
-            {
-                m_QueuedGroups[bracket_id][BG_QUEUE_NORMAL_ALLIANCE + teamIndex].erase(itr2);
-                break;
-            }
-        }
+        //move team to other queue
+        MoveGroup(*itr, BG_QUEUE_NORMAL_ALLIANCE + otherTeam);
     }
     return true;
 }
@@ -728,8 +791,6 @@ should be called from Battleground::RemovePlayer function in some cases
 */
 void BattlegroundQueue::BattlegroundQueueUpdate(uint32 diff, BattlegroundTypeId bgTypeId, BattlegroundBracketId bracket_id, uint8 arenaType, bool isRated, uint32 arenaRating)
 {
-    m_events.Update(diff);
-
     //if no players in queue - do nothing
     if (m_QueuedGroups[bracket_id][BG_QUEUE_PREMADE_ALLIANCE].empty() &&
         m_QueuedGroups[bracket_id][BG_QUEUE_PREMADE_HORDE].empty() &&
@@ -878,6 +939,7 @@ void BattlegroundQueue::BattlegroundQueueUpdate(uint32 diff, BattlegroundTypeId
         // found out the minimum and maximum ratings the newly added team should battle against
         // arenaRating is the rating of the latest joined team, or 0
         // 0 is on (automatic update call) and we must set it to team's with longest wait time
+        uint32 anchorJoinTime = getMSTime();
         if (!arenaRating)
         {
             GroupQueueInfo* front1 = NULL;
@@ -886,24 +948,31 @@ void BattlegroundQueue::BattlegroundQueueUpdate(uint32 diff, BattlegroundTypeId
             {
                 front1 = m_QueuedGroups[bracket_id][BG_QUEUE_PREMADE_ALLIANCE].front();
                 arenaRating = front1->ArenaMatchmakerRating;
+                anchorJoinTime = front1->JoinTime;
             }
             if (!m_QueuedGroups[bracket_id][BG_QUEUE_PREMADE_HORDE].empty())
             {
                 front2 = m_QueuedGroups[bracket_id][BG_QUEUE_PREMADE_HORDE].front();
                 arenaRating = front2->ArenaMatchmakerRating;
+                anchorJoinTime = front2->JoinTime;
             }
             if (front1 && front2)
             {
                 if (front1->JoinTime < front2->JoinTime)
+                {
                     arenaRating = front1->ArenaMatchmakerRating;
+                    anchorJoinTime = front1->JoinTime;
+                }
             }
             else if (!front1 && !front2)
                 return; //queues are empty
         }
 
-        //set rating range
-        uint32 arenaMinRating = (arenaRating <= sBattlegroundMgr->GetMaxRatingDifference()) ? 0 : arenaRating - sBattlegroundMgr->GetMaxRatingDifference();
-        uint32 arenaMaxRating = arenaRating + sBattlegroundMgr->GetMaxRatingDifference();
+        //set rating range, it widens with the time the team waits
+        uint32 maxRatingDifference = sBattlegroundMgr->GetMaxRatingDifference()
+            + sWorld->getIntConfig(CONFIG_ARENA_RATING_WINDOW_WIDENING) * (getMSTimeDiff(anchorJoinTime, getMSTime()) / (MINUTE * IN_MILLISECONDS));
+        uint32 arenaMinRating = (arenaRating <= maxRatingDifference) ? 0 : arenaRating - maxRatingDifference;
+        uint32 arenaMaxRating = arenaRating + maxRatingDifference;
         // if max rating difference is set and the time past since server startup is greater than the rating discard time
         // (after what time the ratings aren't taken into account when making teams) then
         // the discard time is current_time - time_to_discard, teams that joined after that, will have their ratings taken into account
@@ -911,67 +980,20 @@ void BattlegroundQueue::BattlegroundQueueUpdate(uint32 diff, BattlegroundTypeId
         uint32 discardTime = getMSTime() - sBattlegroundMgr->GetRatingDiscardTimer();
 
         // we need to find 2 teams which will play next game
-
-        GroupsQueueType::iterator itr_team[BG_TEAMS_COUNT];
-
         //optimalization : --- we dont need to use selection_pools - each update we select max 2 groups
+        GroupQueueInfo* teams[BG_TEAMS_COUNT];
         for (uint32 i = BG_QUEUE_PREMADE_ALLIANCE; i < BG_QUEUE_NORMAL_ALLIANCE; i++)
-        {
-            // take the group that joined first
-            itr_team[i] = m_QueuedGroups[bracket_id][i].begin();
-            for (; itr_team[i] != m_QueuedGroups[bracket_id][i].end(); ++(itr_team[i]))
-            {
-                // if group match conditions, then add it to pool
-                if (!(*itr_team[i])->IsInvitedToBGInstanceGUID
-                    && (((*itr_team[i])->ArenaMatchmakerRating >= arenaMinRating && (*itr_team[i])->ArenaMatchmakerRating <= arenaMaxRating)
-                        || (*itr_team[i])->JoinTime < discardTime))
-                {
-                    m_SelectionPools[i].AddGroup((*itr_team[i]), MaxPlayersPerTeam);
-                    // break for cycle to be able to start selecting another group from same faction queue
-                    break;
-                }
-            }
-        }
+            teams[i] = SelectRatedGroup(bracket_id, i, arenaMinRating, arenaMaxRating, discardTime, NULL);
 
         // now we are done if we have 2 groups - ali vs horde!
-        // if we don't have, we must try to continue search in same queue
-        // tmp variables are correctly set
-        // this code isn't much userfriendly - but it is supposed to continue search for mathing group in HORDE queue
-        if (m_SelectionPools[BG_TEAM_ALLIANCE].GetPlayerCount() == 0 && m_SelectionPools[BG_TEAM_HORDE].GetPlayerCount())
-        {
-            itr_team[BG_TEAM_ALLIANCE] = itr_team[BG_TEAM_HORDE];
-            ++itr_team[BG_TEAM_ALLIANCE];
-            for (; itr_team[BG_TEAM_ALLIANCE] != m_QueuedGroups[bracket_id][BG_QUEUE_PREMADE_HORDE].end(); ++(itr_team[BG_TEAM_ALLIANCE]))
-            {
-                if (!(*itr_team[BG_TEAM_ALLIANCE])->IsInvitedToBGInstanceGUID
-                    && (((*itr_team[BG_TEAM_ALLIANCE])->ArenaMatchmakerRating >= arenaMinRating && (*itr_team[BG_TEAM_ALLIANCE])->ArenaMatchmakerRating <= arenaMaxRating)
-                        || (*itr_team[BG_TEAM_ALLIANCE])->JoinTime < discardTime))
-                {
-                    m_SelectionPools[BG_TEAM_ALLIANCE].AddGroup((*itr_team[BG_TEAM_ALLIANCE]), MaxPlayersPerTeam);
-                    break;
-                }
-            }
-        }
-
-        // this code isn't much userfriendly - but it is supposed to continue search for mathing group in ALLIANCE queue
-        if (m_SelectionPools[BG_TEAM_HORDE].GetPlayerCount() == 0 && m_SelectionPools[BG_TEAM_ALLIANCE].GetPlayerCount())
-        {
-            itr_team[BG_TEAM_HORDE] = itr_team[BG_TEAM_ALLIANCE];
-            ++itr_team[BG_TEAM_HORDE];
-            for (; itr_team[BG_TEAM_HORDE] != m_QueuedGroups[bracket_id][BG_QUEUE_PREMADE_ALLIANCE].end(); ++(itr_team[BG_TEAM_HORDE]))
-            {
-                if (!(*itr_team[BG_TEAM_HORDE])->IsInvitedToBGInstanceGUID
-                    && (((*itr_team[BG_TEAM_HORDE])->ArenaMatchmakerRating >= arenaMinRating && (*itr_team[BG_TEAM_HORDE])->ArenaMatchmakerRating <= arenaMaxRating)
-                        || (*itr_team[BG_TEAM_HORDE])->JoinTime < discardTime))
-                {
-                    m_SelectionPools[BG_TEAM_HORDE].AddGroup((*itr_team[BG_TEAM_HORDE]), MaxPlayersPerTeam);
-                    break;
-                }
-            }
-        }
+        // if we don't have, we must try to find the opponent in the same faction queue
+        if (!teams[BG_TEAM_ALLIANCE] && teams[BG_TEAM_HORDE])
+            teams[BG_TEAM_ALLIANCE] = SelectRatedGroup(bracket_id, BG_QUEUE_PREMADE_HORDE, arenaMinRating, arenaMaxRating, discardTime, teams[BG_TEAM_HORDE]);
+        if (!teams[BG_TEAM_HORDE] && teams[BG_TEAM_ALLIANCE])
+            teams[BG_TEAM_HORDE] = SelectRatedGroup(bracket_id, BG_QUEUE_PREMADE_ALLIANCE, arenaMinRating, arenaMaxRating, discardTime, teams[BG_TEAM_ALLIANCE]);
 
         //if we have 2 teams, then start new arena and invite players!
-        if (m_SelectionPools[BG_TEAM_ALLIANCE].GetPlayerCount() && m_SelectionPools[BG_TEAM_HORDE].GetPlayerCount())
+        if (teams[BG_TEAM_ALLIANCE] && teams[BG_TEAM_HORDE])
         {
             Battleground* arena = sBattlegroundMgr->CreateNewBattleground(bgTypeId, bracketEntry, arenaType, true);
             if (!arena)
@@ -980,32 +1002,22 @@ void BattlegroundQueue::BattlegroundQueueUpdate(uint32 diff, BattlegroundTypeId
                 return;
             }
 
-            (*(itr_team[BG_TEAM_ALLIANCE]))->OpponentsTeamRating = (*(itr_team[BG_TEAM_HORDE]))->ArenaTeamRating;
-            (*(itr_team[BG_TEAM_ALLIANCE]))->OpponentsMatchmakerRating = (*(itr_team[BG_TEAM_HORDE]))->ArenaMatchmakerRating;
-            sLog->outDebug(LOG_FILTER_BATTLEGROUND, "setting oposite teamrating for team %u to %u", (*(itr_team[BG_TEAM_ALLIANCE]))->ArenaTeamId, (*(itr_team[BG_TEAM_ALLIANCE]))->OpponentsTeamRating);
-            (*(itr_team[BG_TEAM_HORDE]))->OpponentsTeamRating = (*(itr_team[BG_TEAM_ALLIANCE]))->ArenaTeamRating;
-            (*(itr_team[BG_TEAM_HORDE]))->OpponentsMatchmakerRating = (*(itr_team[BG_TEAM_ALLIANCE]))->ArenaMatchmakerRating;
-            sLog->outDebug(LOG_FILTER_BATTLEGROUND, "setting oposite teamrating for team %u to %u", (*(itr_team[BG_TEAM_HORDE]))->ArenaTeamId, (*(itr_team[BG_TEAM_HORDE]))->OpponentsTeamRating);
+            teams[BG_TEAM_ALLIANCE]->OpponentsTeamRating = teams[BG_TEAM_HORDE]->ArenaTeamRating;
+            teams[BG_TEAM_ALLIANCE]->OpponentsMatchmakerRating = teams[BG_TEAM_HORDE]->ArenaMatchmakerRating;
+            sLog->outDebug(LOG_FILTER_BATTLEGROUND, "setting oposite teamrating for team %u to %u", teams[BG_TEAM_ALLIANCE]->ArenaTeamId, teams[BG_TEAM_ALLIANCE]->OpponentsTeamRating);
+            teams[BG_TEAM_HORDE]->OpponentsTeamRating = teams[BG_TEAM_ALLIANCE]->ArenaTeamRating;
+            teams[BG_TEAM_HORDE]->OpponentsMatchmakerRating = teams[BG_TEAM_ALLIANCE]->ArenaMatchmakerRating;
+            sLog->outDebug(LOG_FILTER_BATTLEGROUND, "setting oposite teamrating for team %u to %u", teams[BG_TEAM_HORDE]->ArenaTeamId, teams[BG_TEAM_HORDE]->OpponentsTeamRating);
             // now we must move team if we changed its faction to another faction queue, because then we will spam log by errors in Queue::RemovePlayer
-            if ((*(itr_team[BG_TEAM_ALLIANCE]))->Team != ALLIANCE)
-            {
-                // add to alliance queue
-                m_QueuedGroups[bracket_id][BG_QUEUE_PREMADE_ALLIANCE].push_front(*(itr_team[BG_TEAM_ALLIANCE]));
-                // erase from horde queue
-                m_QueuedGroups[bracket_id][BG_QUEUE_PREMADE_HORDE].erase(itr_team[BG_TEAM_ALLIANCE]);
-                itr_team[BG_TEAM_ALLIANCE] = m_QueuedGroups[bracket_id][BG_QUEUE_PREMADE_ALLIANCE].begin();
-            }
-            if ((*(itr_team[BG_TEAM_HORDE]))->Team != HORDE)
-            {
-                m_QueuedGroups[bracket_id][BG_QUEUE_PREMADE_HORDE].push_front(*(itr_team[BG_TEAM_HORDE]));
-                m_QueuedGroups[bracket_id][BG_QUEUE_PREMADE_ALLIANCE].erase(itr_team[BG_TEAM_HORDE]);
-                itr_team[BG_TEAM_HORDE] = m_QueuedGroups[bracket_id][BG_QUEUE_PREMADE_HORDE].begin();
-            }
+            if (teams[BG_TEAM_ALLIANCE]->Team != ALLIANCE)
+                MoveGroup(teams[BG_TEAM_ALLIANCE], BG_QUEUE_PREMADE_ALLIANCE);
+            if (teams[BG_TEAM_HORDE]->Team != HORDE)
+                MoveGroup(teams[BG_TEAM_HORDE], BG_QUEUE_PREMADE_HORDE);
 
-            arena->SetArenaMatchmakerRating(ALLIANCE, (*(itr_team[BG_TEAM_ALLIANCE]))->ArenaMatchmakerRating);
-            arena->SetArenaMatchmakerRating(HORDE, (*(itr_team[BG_TEAM_HORDE]))->ArenaMatchmakerRating);
-            InviteGroupToBG(*(itr_team[BG_TEAM_ALLIANCE]), arena, ALLIANCE);
-            InviteGroupToBG(*(itr_team[BG_TEAM_HORDE]), arena, HORDE);
+            arena->SetArenaMatchmakerRating(ALLIANCE, teams[BG_TEAM_ALLIANCE]->ArenaMatchmakerRating);
+            arena->SetArenaMatchmakerRating(HORDE, teams[BG_TEAM_HORDE]->ArenaMatchmakerRating);
+            InviteGroupToBG(teams[BG_TEAM_ALLIANCE], arena, ALLIANCE);
+            InviteGroupToBG(teams[BG_TEAM_HORDE], arena, HORDE);
 
             sLog->outDebug(LOG_FILTER_BATTLEGROUND, "Starting rated arena match!");
 
@@ -1018,42 +1030,35 @@ void BattlegroundQueue::BattlegroundQueueUpdate(uint32 diff, BattlegroundTypeId
 /***            BATTLEGROUND QUEUE EVENTS              ***/
 /*********************************************************/
 
-bool BGQueueInviteEvent::Execute(uint64 /*e_time*/, uint32 /*p_time*/)
+void BattlegroundQueue::AddTimer(BGQueueTimer const& timer, uint32 delay)
 {
-    Player* plr = ObjectAccessor::FindPlayer(m_PlayerGuid);
-    // player logged off (we should do nothing, he is correctly removed from queue in another procedure)
-    if (!plr)
-        return true;
-
-    Battleground* bg = sBattlegroundMgr->GetBattleground(m_BgInstanceGUID, m_BgTypeId);
-    //if battleground ended and its instance deleted - do nothing
-    if (!bg)
-        return true;
-
-    BattlegroundQueueTypeId bgQueueTypeId = BattlegroundMgr::BGQueueTypeId(bg->GetTypeID(), bg->GetArenaType());
-    uint32 queueSlot = plr->GetBattlegroundQueueIndex(bgQueueTypeId);
-    if (queueSlot < PLAYER_MAX_BATTLEGROUND_QUEUES)         // player is in queue or in battleground
-    {
-        // check if player is invited to this bg
-        BattlegroundQueue &bgQueue = sBattlegroundMgr->m_BattlegroundQueues[bgQueueTypeId];
-        if (bgQueue.IsPlayerInvited(m_PlayerGuid, m_BgInstanceGUID, m_RemoveTime))
-        {
-            WorldPacket data;
-            //we must send remaining time in queue
-            sBattlegroundMgr->BuildBattlegroundStatusPacket(&data, bg, queueSlot, STATUS_WAIT_JOIN, INVITE_ACCEPT_WAIT_TIME - INVITATION_REMIND_TIME, 0, m_ArenaType);
-            plr->GetSession()->SendPacket(&data);
-        }
-    }
-    return true;                                            //event will be deleted
+    // round up, a timer may expire up to one wheel tick late but never early
+    uint32 ticks = (m_TimerWheelTime + delay + BG_QUEUE_TIMER_WHEEL_TICK - 1) / BG_QUEUE_TIMER_WHEEL_TICK;
+    ticks = std::max<uint32>(1, std::min<uint32>(ticks, BG_QUEUE_TIMER_WHEEL_SLOTS - 1));
+    m_TimerWheel[(m_TimerWheelPos + ticks) % BG_QUEUE_TIMER_WHEEL_SLOTS].push_back(timer);
 }
 
-void BGQueueInviteEvent::Abort(uint64 /*e_time*/)
+void BattlegroundQueue::UpdateTimers(uint32 diff)
 {
-    //do nothing
+    m_TimerWheelTime += diff;
+    while (m_TimerWheelTime >= BG_QUEUE_TIMER_WHEEL_TICK)
+    {
+        m_TimerWheelTime -= BG_QUEUE_TIMER_WHEEL_TICK;
+        m_TimerWheelPos = (m_TimerWheelPos + 1) % BG_QUEUE_TIMER_WHEEL_SLOTS;
+
+        if (m_TimerWheel[m_TimerWheelPos].empty())
+            continue;
+
+        // executing a timer can add new ones
+        TimerList expired;
+        expired.swap(m_TimerWheel[m_TimerWheelPos]);
+        for (TimerList::const_iterator itr = expired.begin(); itr != expired.end(); ++itr)
+            ExecuteTimer(*itr);
+    }
 }
 
 /*
-    this event has many possibilities when it is executed:
+    a remove timer has many possibilities when it is executed:
     1. player is in battleground (he clicked enter on invitation window)
     2. player left battleground queue and he isn't there any more
     3. player left battleground queue and he joined it again and IsInvitedToBGInstanceGUID = 0
@@ -1061,43 +1066,48 @@ void BGQueueInviteEvent::Abort(uint64 /*e_time*/)
     5. player is invited to bg and he didn't choose what to do and timer expired - only in this condition we should call queue::RemovePlayer
     we must remove player in the 5. case even if battleground object doesn't exist!
 */
-bool BGQueueRemoveEvent::Execute(uint64 /*e_time*/, uint32 /*p_time*/)
+void BattlegroundQueue::ExecuteTimer(BGQueueTimer const& timer)
 {
-    Player* plr = ObjectAccessor::FindPlayer(m_PlayerGuid);
+    Player* plr = ObjectAccessor::FindPlayer(timer.PlayerGuid);
+    // player logged off (we should do nothing, he is correctly removed from queue in another procedure)
     if (!plr)
-        // player logged off (we should do nothing, he is correctly removed from queue in another procedure)
-        return true;
+        return;
 
-    Battleground* bg = sBattlegroundMgr->GetBattleground(m_BgInstanceGUID, m_BgTypeId);
     //battleground can be deleted already when we are removing queue info
     //bg pointer can be NULL! so use it carefully!
+    Battleground* bg = sBattlegroundMgr->GetBattleground(timer.BgInstanceGUID, timer.BgTypeId);
+
+    uint32 queueSlot = plr->GetBattlegroundQueueIndex(timer.BgQueueTypeId);
+    if (queueSlot >= PLAYER_MAX_BATTLEGROUND_QUEUES)         // player is neither in queue nor in battleground
+        return;
 
-    uint32 queueSlot = plr->GetBattlegroundQueueIndex(m_BgQueueTypeId);
-    if (queueSlot < PLAYER_MAX_BATTLEGROUND_QUEUES)         // player is in queue, or in Battleground
+    // check if player is still invited to this bg by the invitation the timer was created for
+    if (!IsPlayerInvited(timer.PlayerGuid, timer.BgInstanceGUID, timer.RemoveTime))
+        return;
+
+    WorldPacket data;
+    switch (timer.Type)
     {
-        // check if player is in queue for this BG and if we are removing his invite event
-        BattlegroundQueue &bgQueue = sBattlegroundMgr->m_BattlegroundQueues[m_BgQueueTypeId];
-        if (bgQueue.IsPlayerInvited(m_PlayerGuid, m_BgInstanceGUID, m_RemoveTime))
-        {
-            sLog->outDebug(LOG_FILTER_BATTLEGROUND, "Battleground: removing player %u from bg queue for instance %u because of not pressing enter battle in time.", plr->GetGUIDLow(), m_BgInstanceGUID);
+        case BG_QUEUE_TIMER_INVITE_REMIND:
+            //if battleground ended and its instance deleted - do nothing
+            if (!bg)
+                return;
+
+            //we must send remaining time in queue
+            sBattlegroundMgr->BuildBattlegroundStatusPacket(&data, bg, queueSlot, STATUS_WAIT_JOIN, INVITE_ACCEPT_WAIT_TIME - INVITATION_REMIND_TIME, 0, timer.ArenaType);
+            plr->GetSession()->SendPacket(&data);
+            break;
+        case BG_QUEUE_TIMER_INVITE_REMOVE:
+            sLog->outDebug(LOG_FILTER_BATTLEGROUND, "Battleground: removing player %u from bg queue for instance %u because of not pressing enter battle in time.", plr->GetGUIDLow(), timer.BgInstanceGUID);
 
-            plr->RemoveBattlegroundQueueId(m_BgQueueTypeId);
-            bgQueue.RemovePlayer(m_PlayerGuid, true);
+            plr->RemoveBattlegroundQueueId(timer.BgQueueTypeId);
+            RemovePlayer(timer.PlayerGuid, true);
             //update queues if battleground isn't ended
             if (bg && bg->isBattleground() && bg->GetStatus() != STATUS_WAIT_LEAVE)
-                sBattlegroundMgr->ScheduleQueueUpdate(0, 0, m_BgQueueTypeId, m_BgTypeId, bg->GetBracketId());
+                sBattlegroundMgr->ScheduleQueueUpdate(0, 0, timer.BgQueueTypeId, timer.BgTypeId, bg->GetBracketId());
 
-            WorldPacket data;
             sBattlegroundMgr->BuildBattlegroundStatusPacket(&data, bg, queueSlot, STATUS_NONE, 0, 0, 0);
             plr->GetSession()->SendPacket(&data);
-        }
+            break;
     }
-
-    //event will be deleted
-    return true;
-}
-
-void BGQueueRemoveEvent::Abort(uint64 /*e_time*/)
-{
-    //do nothing
 }
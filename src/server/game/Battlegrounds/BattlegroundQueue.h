@@ -22,14 +22,19 @@
 #include "Common.h"
 #include "DBCEnums.h"
 #include "Battleground.h"
-#include "EventProcessor.h"
 
 //this container can't be deque, because deque doesn't like removing the last element - if you remove it, it invalidates next iterator and crash appears
 typedef std::list<Battleground*> BGFreeSlotQueueType;
 
 #define COUNT_OF_PLAYERS_TO_AVERAGE_WAIT_TIME 10
+#define ARENA_RATING_BUCKET_SIZE 50                         // matchmaker rating span of one rated queue bucket
+#define BG_QUEUE_TIMER_WHEEL_TICK 1000                      // ms per invite timer wheel slot
+#define BG_QUEUE_TIMER_WHEEL_SLOTS 64                       // wheel span must exceed INVITE_ACCEPT_WAIT_TIME
 
 struct GroupQueueInfo;                                      // type predefinition
+//we need constant add to begin and constant remove / add from the end, therefore deque suits our problem well
+typedef std::list<GroupQueueInfo*> GroupsQueueType;
+
 struct PlayerQueueInfo                                      // stores information for players in queue
 {
     uint32  LastOnlineTime;                                 // for tracking and removing offline players from queue after 5 minutes
@@ -51,6 +56,29 @@ struct GroupQueueInfo                                       // stores informatio
     uint32  ArenaMatchmakerRating;                          // if rated match, inited to the rating of the team
     uint32  OpponentsTeamRating;                            // for rated arena matches
     uint32  OpponentsMatchmakerRating;                      // for rated arena matches
+    BattlegroundBracketId BracketId;                        // bracket and BattlegroundQueueGroupTypes queue the group waits in
+    uint8   QueueIndex;
+    GroupsQueueType::iterator QueuePosition;                // position in m_QueuedGroups[BracketId][QueueIndex]
+    GroupsQueueType::iterator RatedPosition;                // position in its rating bucket, rated groups only
+};
+
+enum BGQueueTimerType
+{
+    BG_QUEUE_TIMER_INVITE_REMIND    = 0,                    // resend the invitation with the remaining time
+    BG_QUEUE_TIMER_INVITE_REMOVE    = 1                     // remove the player if he still didn't enter
+};
+
+// Invitation timer of one player. It carries everything needed to check that the invitation
+// it was created for is still the current one, the player may have left and joined again since.
+struct BGQueueTimer
+{
+    uint64 PlayerGuid;
+    uint32 BgInstanceGUID;
+    uint32 RemoveTime;
+    BattlegroundTypeId BgTypeId;
+    BattlegroundQueueTypeId BgQueueTypeId;
+    uint8  ArenaType;
+    uint8  Type;
 };
 
 enum BattlegroundQueueGroupTypes
@@ -82,11 +110,12 @@ class BattlegroundQueue
         void PlayerInvitedToBGUpdateAverageWaitTime(GroupQueueInfo* ginfo, BattlegroundBracketId bracket_id);
         uint32 GetAverageQueueWaitTime(GroupQueueInfo* ginfo, BattlegroundBracketId bracket_id) const;
 
-        typedef std::map<uint64, PlayerQueueInfo> QueuedPlayersMap;
-        QueuedPlayersMap m_QueuedPlayers;
+        // advances the invitation timers, called every world tick
+        void UpdateTimers(uint32 diff);
 
-        //we need constant add to begin and constant remove / add from the end, therefore deque suits our problem well
-        typedef std::list<GroupQueueInfo*> GroupsQueueType;
+        // node based, so the PlayerQueueInfo pointers kept in GroupQueueInfo::Players stay valid
+        typedef UNORDERED_MAP<uint64, PlayerQueueInfo> QueuedPlayersMap;
+        QueuedPlayersMap m_QueuedPlayers;
 
         /*
         This two dimensional array is used to store All queued groups
@@ -119,59 +148,32 @@ class BattlegroundQueue
     private:
 
         bool InviteGroupToBG(GroupQueueInfo* ginfo, Battleground* bg, uint32 side);
-        uint32 m_WaitTimes[BG_TEAMS_COUNT][MAX_BATTLEGROUND_BRACKETS][COUNT_OF_PLAYERS_TO_AVERAGE_WAIT_TIME];
-        uint32 m_WaitTimeLastPlayer[BG_TEAMS_COUNT][MAX_BATTLEGROUND_BRACKETS];
-        uint32 m_SumOfWaitTimes[BG_TEAMS_COUNT][MAX_BATTLEGROUND_BRACKETS];
+        void MoveGroup(GroupQueueInfo* ginfo, uint32 index);
+        GroupQueueInfo* SelectRatedGroup(BattlegroundBracketId bracket_id, uint32 index, uint32 minRating, uint32 maxRating, uint32 discardTime, GroupQueueInfo const* exclude) const;
+        void AddRatedGroup(GroupQueueInfo* ginfo);
+        void RemoveRatedGroup(GroupQueueInfo* ginfo);
 
-        // Event handler
-        EventProcessor m_events;
-};
+        void AddTimer(BGQueueTimer const& timer, uint32 delay);
+        void ExecuteTimer(BGQueueTimer const& timer);
 
-/*
-    This class is used to invite player to BG again, when minute lasts from his first invitation
-    it is capable to solve all possibilities
-*/
-class BGQueueInviteEvent : public BasicEvent
-{
-    public:
-        BGQueueInviteEvent(uint64 pl_guid, uint32 BgInstanceGUID, BattlegroundTypeId BgTypeId, uint8 arenaType, uint32 removeTime) :
-          m_PlayerGuid(pl_guid), m_BgInstanceGUID(BgInstanceGUID), m_BgTypeId(BgTypeId), m_ArenaType(arenaType), m_RemoveTime(removeTime)
-          {
-          };
-        virtual ~BGQueueInviteEvent() {};
-
-        virtual bool Execute(uint64 e_time, uint32 p_time);
-        virtual void Abort(uint64 e_time);
-    private:
-        uint64 m_PlayerGuid;
-        uint32 m_BgInstanceGUID;
-        BattlegroundTypeId m_BgTypeId;
-        uint8  m_ArenaType;
-        uint32 m_RemoveTime;
-};
+        // players of not yet invited groups per queue, lets updates skip queues that can't form a match
+        uint32 m_WaitingPlayers[MAX_BATTLEGROUND_BRACKETS][BG_QUEUE_GROUP_TYPES_COUNT];
 
-/*
-    This class is used to remove player from BG queue after 1 minute 20 seconds from first invitation
-    We must store removeInvite time in case player left queue and joined and is invited again
-    We must store bgQueueTypeId, because battleground can be deleted already, when player entered it
-*/
-class BGQueueRemoveEvent : public BasicEvent
-{
-    public:
-        BGQueueRemoveEvent(uint64 pl_guid, uint32 bgInstanceGUID, BattlegroundTypeId BgTypeId, BattlegroundQueueTypeId bgQueueTypeId, uint32 removeTime)
-            : m_PlayerGuid(pl_guid), m_BgInstanceGUID(bgInstanceGUID), m_RemoveTime(removeTime), m_BgTypeId(BgTypeId), m_BgQueueTypeId(bgQueueTypeId)
-        {}
+        // rated arena teams (premade queues) bucketed by matchmaker rating / ARENA_RATING_BUCKET_SIZE,
+        // every bucket in join order
+        typedef std::map<uint32, GroupsQueueType> RatingBuckets;
+        RatingBuckets m_RatedGroups[MAX_BATTLEGROUND_BRACKETS][BG_TEAMS_COUNT];
 
-        virtual ~BGQueueRemoveEvent() {}
+        uint32 m_WaitTimes[BG_TEAMS_COUNT][MAX_BATTLEGROUND_BRACKETS][COUNT_OF_PLAYERS_TO_AVERAGE_WAIT_TIME];
+        uint32 m_WaitTimeLastPlayer[BG_TEAMS_COUNT][MAX_BATTLEGROUND_BRACKETS];
+        uint32 m_SumOfWaitTimes[BG_TEAMS_COUNT][MAX_BATTLEGROUND_BRACKETS];
 
-        virtual bool Execute(uint64 e_time, uint32 p_time);
-        virtual void Abort(uint64 e_time);
-    private:
-        uint64 m_PlayerGuid;
-        uint32 m_BgInstanceGUID;
-        uint32 m_RemoveTime;
-        BattlegroundTypeId m_BgTypeId;
-        BattlegroundQueueTypeId m_BgQueueTypeId;
+        // invitation timers, the timers of slot (m_TimerWheelPos + n) % BG_QUEUE_TIMER_WHEEL_SLOTS
+        // expire when the wheel advanced n more times
+        typedef std::vector<BGQueueTimer> TimerList;
+        TimerList m_TimerWheel[BG_QUEUE_TIMER_WHEEL_SLOTS];
+        uint32 m_TimerWheelPos;
+        uint32 m_TimerWheelTime;                            // ms passed since the wheel last advanced
 };
 
 #endif
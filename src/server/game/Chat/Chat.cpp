@@ -35,9 +35,14 @@
 #include "SpellMgr.h"
 #include "ScriptMgr.h"
 #include "ChatLink.h"
+#include "ChatCommandIndex.h"
 
 bool ChatHandler::load_command_table = true;
 
+// rebuilt with the command table cache and, like it, never freed: console and RA
+// threads may still be resolving a command when it is replaced
+static ChatCommandIndex* commandIndex = NULL;
+
 // wrapper for old-style handlers
 template<bool (ChatHandler::*F)(const char*)>
 bool OldHandler(ChatHandler* chatHandler, const char* args)
@@ -284,6 +289,7 @@ ChatCommand* ChatHandler::getCommandTable()
         { "idleshutdown",   SEC_ADMINISTRATOR,  true,  NULL,                                                     "", serverShutdownCommandTable },
         { "info",           SEC_PLAYER,         true,  OldHandler<&ChatHandler::HandleServerInfoCommand>,        "", NULL },
         { "motd",           SEC_PLAYER,         true,  OldHandler<&ChatHandler::HandleServerMotdCommand>,        "", NULL },
+        { "netstats",       SEC_ADMINISTRATOR,  true,  OldHandler<&ChatHandler::HandleServerNetStatsCommand>,    "", NULL },
         { "plimit",         SEC_ADMINISTRATOR,  true,  OldHandler<&ChatHandler::HandleServerPLimitCommand>,      "", NULL },
         { "restart",        SEC_ADMINISTRATOR,  true,  NULL,                                                     "", serverRestartCommandTable },
         { "shutdown",       SEC_ADMINISTRATOR,  true,  NULL,                                                     "", serverShutdownCommandTable },
@@ -468,11 +474,19 @@ ChatCommand* ChatHandler::getCommandTable()
 
             } while (result->NextRow());
         }
+
+        commandIndex = new ChatCommandIndex(commandTableCache);
     }
 
     return commandTableCache;
 }
 
+ChatCommandIndex const& ChatHandler::getCommandIndex()
+{
+    getCommandTable();
+    return *commandIndex;
+}
+
 std::string ChatHandler::PGetParseString(int32 entry, ...) const
 {
     const char *format = GetTrinityString(entry);
@@ -648,7 +662,7 @@ void ChatHandler::PSendSysMessage(const char *format, ...)
     SendSysMessage(str);
 }
 
-bool ChatHandler::ExecuteCommandInTable(ChatCommand* table, const char* text, const std::string& fullcmd)
+bool ChatHandler::ExecuteCommandInTable(ChatCommandIndex const& index, const char* text, const std::string& fullcmd)
 {
     char const* oldtext = text;
     std::string cmd = "";
@@ -661,81 +675,54 @@ bool ChatHandler::ExecuteCommandInTable(ChatCommand* table, const char* text, co
 
     while (*text == ' ') ++text;
 
-    for (uint32 i = 0; table[i].Name != NULL; ++i)
-    {
-        if (!hasStringAbbr(table[i].Name, cmd.c_str()))
-            continue;
-
-        bool match = false;
-        if (strlen(table[i].Name) > cmd.length())
-        {
-            for (uint32 j = 0; table[j].Name != NULL; ++j)
-            {
-                if (!hasStringAbbr(table[j].Name, cmd.c_str()))
-                    continue;
-
-                if (strcmp(table[j].Name, cmd.c_str()) != 0)
-                    continue;
-                else
-                {
-                    match = true;
-                    break;
-                }
-            }
-        }
-        if (match)
-            continue;
+    ChatCommand* table = index.GetTable();
+    int32 i = index.Resolve(cmd, *this);
+    if (i < 0)
+        return false;
 
-        // select subcommand from child commands list
-        if (table[i].ChildCommands != NULL)
+    // select subcommand from child commands list
+    if (table[i].ChildCommands != NULL)
+    {
+        if (!ExecuteCommandInTable(*index.GetChild(i), text, fullcmd))
         {
-            if (!ExecuteCommandInTable(table[i].ChildCommands, text, fullcmd))
-            {
-                if (text && text[0] != '\0')
-                    SendSysMessage(LANG_NO_SUBCMD);
-                else
-                    SendSysMessage(LANG_CMD_SYNTAX);
-
-                ShowHelpForCommand(table[i].ChildCommands, text);
-            }
+            if (text && text[0] != '\0')
+                SendSysMessage(LANG_NO_SUBCMD);
+            else
+                SendSysMessage(LANG_CMD_SYNTAX);
 
-            return true;
+            ShowHelpForCommand(table[i].ChildCommands, text);
         }
 
-        // must be available and have handler
-        if (!table[i].Handler || !isAvailable(table[i]))
-            continue;
+        return true;
+    }
 
-        SetSentErrorMessage(false);
-        // table[i].Name == "" is special case: send original command to handler
-        if ((table[i].Handler)(this, table[i].Name[0] != '\0' ? text : oldtext))
+    SetSentErrorMessage(false);
+    // table[i].Name == "" is special case: send original command to handler
+    if ((table[i].Handler)(this, table[i].Name[0] != '\0' ? text : oldtext))
+    {
+        if (!AccountMgr::IsPlayerAccount(table[i].SecurityLevel))
         {
-            if (!AccountMgr::IsPlayerAccount(table[i].SecurityLevel))
+            // chat case
+            if (m_session)
             {
-                // chat case
-                if (m_session)
-                {
-                    Player* p = m_session->GetPlayer();
-                    uint64 sel_guid = p->GetSelection();
-                    sLog->outCommand(m_session->GetAccountId(), "Command: %s [Player: %s (Account: %u) X: %f Y: %f Z: %f Map: %u Selected %s: %s (GUID: %u)]",
-                        fullcmd.c_str(), p->GetName(), m_session->GetAccountId(), p->GetPositionX(), p->GetPositionY(), p->GetPositionZ(), p->GetMapId(),
-                        GetLogNameForGuid(sel_guid), (p->GetSelectedUnit()) ? p->GetSelectedUnit()->GetName() : "", GUID_LOPART(sel_guid));
-                }
+                Player* p = m_session->GetPlayer();
+                uint64 sel_guid = p->GetSelection();
+                sLog->outCommand(m_session->GetAccountId(), "Command: %s [Player: %s (Account: %u) X: %f Y: %f Z: %f Map: %u Selected %s: %s (GUID: %u)]",
+                    fullcmd.c_str(), p->GetName(), m_session->GetAccountId(), p->GetPositionX(), p->GetPositionY(), p->GetPositionZ(), p->GetMapId(),
+                    GetLogNameForGuid(sel_guid), (p->GetSelectedUnit()) ? p->GetSelectedUnit()->GetName() : "", GUID_LOPART(sel_guid));
             }
         }
-        // some commands have custom error messages. Don't send the default one in these cases.
-        else if (!HasSentErrorMessage())
-        {
-            if (!table[i].Help.empty())
-                SendSysMessage(table[i].Help.c_str());
-            else
-                SendSysMessage(LANG_CMD_SYNTAX);
-        }
-
-        return true;
+    }
+    // some commands have custom error messages. Don't send the default one in these cases.
+    else if (!HasSentErrorMessage())
+    {
+        if (!table[i].Help.empty())
+            SendSysMessage(table[i].Help.c_str());
+        else
+            SendSysMessage(LANG_CMD_SYNTAX);
     }
 
-    return false;
+    return true;
 }
 
 bool ChatHandler::SetDataForCommandInTable(ChatCommand* table, const char* text, uint32 security, std::string const& help, std::string const& fullcommand)
@@ -823,7 +810,7 @@ int ChatHandler::ParseCommands(const char* text)
     if (text[0] == '!' || text[0] == '.')
         ++text;
 
-    if (!ExecuteCommandInTable(getCommandTable(), text, fullcmd))
+    if (!ExecuteCommandInTable(getCommandIndex(), text, fullcmd))
     {
         if (m_session && AccountMgr::IsPlayerAccount(m_session->GetSecurity()))
             return 0;
@@ -25,6 +25,7 @@
 #include <vector>
 
 class ChatHandler;
+class ChatCommandIndex;
 class WorldSession;
 class WorldObject;
 class Creature;
@@ -77,6 +78,7 @@ class ChatHandler
         int ParseCommands(const char* text);
 
         static ChatCommand* getCommandTable();
+        static ChatCommandIndex const& getCommandIndex();
 
         bool isValidChatMessage(const char* msg);
         void SendGlobalSysMessage(const char *str);
@@ -127,7 +129,7 @@ class ChatHandler
     protected:
         explicit ChatHandler() : m_session(NULL) {}      // for CLI subclass
         static bool SetDataForCommandInTable(ChatCommand* table, const char* text, uint32 security, std::string const& help, std::string const& fullcommand);
-        bool ExecuteCommandInTable(ChatCommand* table, const char* text, const std::string& fullcmd);
+        bool ExecuteCommandInTable(ChatCommandIndex const& index, const char* text, const std::string& fullcmd);
         bool ShowHelpForCommand(ChatCommand* table, const char* cmd);
         bool ShowHelpForSubCommands(ChatCommand* table, char const* cmd, char const* subcmd);
 
@@ -231,6 +233,7 @@ class ChatHandler
         bool HandleServerIdleShutDownCommand(const char* args);
         bool HandleServerInfoCommand(const char* args);
         bool HandleServerMotdCommand(const char* args);
+        bool HandleServerNetStatsCommand(const char* args);
         bool HandleServerPLimitCommand(const char* args);
         bool HandleServerRestartCommand(const char* args);
         bool HandleServerSetLogLevelCommand(const char* args);
@@ -0,0 +1,115 @@
+/*
+ * Copyright (C) 2008-2011 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ChatCommandIndex.h"
+#include "Chat.h"
+
+ChatCommandIndex::ChatCommandIndex(ChatCommand* table) : _table(table), _nodes(1)
+{
+    for (uint32 i = 0; table[i].Name != NULL; ++i)
+    {
+        char const* name = table[i].Name;
+        _nameLengths.push_back(uint32(strlen(name)));
+        _children.push_back(table[i].ChildCommands ? new ChatCommandIndex(table[i].ChildCommands) : NULL);
+
+        if (!*name)
+        {
+            _emptyNames.push_back(i);
+            continue;
+        }
+
+        uint32 node = 0;
+        for (; *name; ++name)
+        {
+            node = _AddChild(node, char(tolower(*name)));
+            _nodes[node].entries.push_back(i);
+        }
+    }
+}
+
+ChatCommandIndex::~ChatCommandIndex()
+{
+    for (std::vector<ChatCommandIndex*>::iterator itr = _children.begin(); itr != _children.end(); ++itr)
+        delete *itr;
+}
+
+uint32 ChatCommandIndex::_GetChild(uint32 node, char c) const
+{
+    std::vector<std::pair<char, uint32> > const& children = _nodes[node].children;
+    for (std::vector<std::pair<char, uint32> >::const_iterator itr = children.begin(); itr != children.end(); ++itr)
+        if (itr->first == c)
+            return itr->second;
+
+    return 0;
+}
+
+uint32 ChatCommandIndex::_AddChild(uint32 node, char c)
+{
+    if (uint32 child = _GetChild(node, c))
+        return child;
+
+    uint32 child = uint32(_nodes.size());
+    _nodes.push_back(Node());
+    _nodes[node].children.push_back(std::make_pair(c, child));
+    return child;
+}
+
+int32 ChatCommandIndex::Resolve(std::string const& name, ChatHandler const& handler) const
+{
+    static std::vector<uint32> const noEntries;
+    std::vector<uint32> const* prefixed = &noEntries;
+
+    // "" typed matches only the "" entries
+    if (!name.empty())
+    {
+        uint32 node = 0;
+        for (std::string::const_iterator itr = name.begin(); itr != name.end(); ++itr)
+            if (!(node = _GetChild(node, char(tolower(*itr)))))
+                break;
+
+        if (node)
+            prefixed = &_nodes[node].entries;
+    }
+
+    bool exact = false;
+    for (std::vector<uint32>::const_iterator itr = prefixed->begin(); itr != prefixed->end() && !exact; ++itr)
+        exact = _nameLengths[*itr] == name.length() && name == _table[*itr].Name;
+
+    // both lists are in table order, merge them
+    std::vector<uint32>::const_iterator p = prefixed->begin(), e = _emptyNames.begin();
+    while (p != prefixed->end() || e != _emptyNames.end())
+    {
+        uint32 entry;
+        if (e == _emptyNames.end() || (p != prefixed->end() && *p < *e))
+        {
+            entry = *p++;
+            if (exact && _nameLengths[entry] > name.length())
+                continue;
+        }
+        else
+            entry = *e++;
+
+        ChatCommand const& command = _table[entry];
+        if (command.ChildCommands)
+            return int32(entry);
+
+        if (command.Handler && handler.isAvailable(command))
+            return int32(entry);
+    }
+
+    return -1;
+}
@@ -0,0 +1,69 @@
+/*
+ * Copyright (C) 2008-2011 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRINITYCORE_CHATCOMMANDINDEX_H
+#define TRINITYCORE_CHATCOMMANDINDEX_H
+
+#include "Define.h"
+#include <string>
+#include <utility>
+#include <vector>
+
+class ChatCommand;
+class ChatHandler;
+
+// Prefix trie over the command names of one command table, with one index per subcommand
+// table below it. Every trie node lists, in table order, the entries whose name starts with
+// the node's (lower case) prefix, so resolving an abbreviation is one walk down the typed
+// characters instead of comparing against every name of the table.
+// The index only points into the tables, it has to be rebuilt when the tables are replaced.
+class ChatCommandIndex
+{
+    public:
+        explicit ChatCommandIndex(ChatCommand* table);
+        ~ChatCommandIndex();
+
+        ChatCommand* GetTable() const { return _table; }
+        ChatCommandIndex const* GetChild(uint32 entry) const { return _children[entry]; }
+
+        // Entry of the table selected by the typed (maybe abbreviated) name, -1 if none.
+        // An exact name hides the longer names starting with it, otherwise the first match in
+        // table order wins. Entries without handler or not available to the handler are
+        // skipped, entries with subcommands are not.
+        int32 Resolve(std::string const& name, ChatHandler const& handler) const;
+
+    private:
+        struct Node
+        {
+            std::vector<uint32> entries;
+            std::vector<std::pair<char, uint32> > children;
+        };
+
+        uint32 _GetChild(uint32 node, char c) const;
+        uint32 _AddChild(uint32 node, char c);
+
+        ChatCommand* _table;
+        std::vector<Node> _nodes;                           // [0] is the root
+        std::vector<uint32> _nameLengths;
+        std::vector<uint32> _emptyNames;                    // "" entries match anything
+        std::vector<ChatCommandIndex*> _children;
+
+        ChatCommandIndex(ChatCommandIndex const&);
+        ChatCommandIndex& operator=(ChatCommandIndex const&);
+};
+
+#endif
@@ -65,6 +65,7 @@
 #include "ChannelMgr.h"
 
 #include "AuctionHouseBot.h"
+#include "OpcodeStats.h"
 
 bool ChatHandler::HandleAHBotOptionsCommand(const char *args)
 {
@@ -4286,6 +4287,58 @@ bool ChatHandler::HandleServerPLimitCommand(const char *args)
     return true;
 }
 
+static bool OpcodeStatsByTrafficRate(OpcodeStatsEntry const& a, OpcodeStatsEntry const& b)
+{
+    uint64 rateA = a.PerSecond.BytesIn + a.PerSecond.BytesOut;
+    uint64 rateB = b.PerSecond.BytesIn + b.PerSecond.BytesOut;
+    if (rateA != rateB)
+        return rateA > rateB;
+    return a.Total.BytesIn + a.Total.BytesOut > b.Total.BytesIn + b.Total.BytesOut;
+}
+
+// USAGE: .server netstats [#count] - lists the opcodes with the most traffic, default 10
+bool ChatHandler::HandleServerNetStatsCommand(const char* args)
+{
+    uint32 count = *args ? uint32(atoi(args)) : 10;
+
+    std::vector<OpcodeStatsEntry> entries;
+    sOpcodeStats->GetSnapshot(entries);
+
+    OpcodeCounters total, perSecond;
+    memset(&total, 0, sizeof(total));
+    memset(&perSecond, 0, sizeof(perSecond));
+    for (std::vector<OpcodeStatsEntry>::const_iterator itr = entries.begin(); itr != entries.end(); ++itr)
+    {
+        total.BytesIn += itr->Total.BytesIn;
+        total.BytesOut += itr->Total.BytesOut;
+        total.RawBytes += itr->Total.RawBytes;
+        total.CompressedBytes += itr->Total.CompressedBytes;
+        perSecond.PacketsIn += itr->PerSecond.PacketsIn;
+        perSecond.BytesIn += itr->PerSecond.BytesIn;
+        perSecond.PacketsOut += itr->PerSecond.PacketsOut;
+        perSecond.BytesOut += itr->PerSecond.BytesOut;
+    }
+
+    PSendSysMessage("Network: in " UI64FMTD " packets/s " UI64FMTD " bytes/s, out " UI64FMTD " packets/s " UI64FMTD " bytes/s",
+        perSecond.PacketsIn, perSecond.BytesIn, perSecond.PacketsOut, perSecond.BytesOut);
+    PSendSysMessage("Total: in " UI64FMTD " bytes, out " UI64FMTD " bytes, compressed " UI64FMTD " of " UI64FMTD " bytes",
+        total.BytesIn, total.BytesOut, total.CompressedBytes, total.RawBytes);
+
+    std::sort(entries.begin(), entries.end(), OpcodeStatsByTrafficRate);
+    if (entries.size() > count)
+        entries.resize(count);
+
+    for (std::vector<OpcodeStatsEntry>::const_iterator itr = entries.begin(); itr != entries.end(); ++itr)
+    {
+        OpcodeCounters const& c = itr->Total;
+        PSendSysMessage("%s: in " UI64FMTD "/s " UI64FMTD " B/s, out " UI64FMTD "/s " UI64FMTD " B/s, handler " UI64FMTD " calls avg " UI64FMTD " us",
+            LookupOpcodeName(itr->Opcode), itr->PerSecond.PacketsIn, itr->PerSecond.BytesIn, itr->PerSecond.PacketsOut, itr->PerSecond.BytesOut,
+            c.HandlerCalls, c.HandlerCalls ? c.HandlerTime / c.HandlerCalls : 0);
+    }
+
+    return true;
+}
+
 bool ChatHandler::HandleCastCommand(const char *args)
 {
     if (!*args)
@@ -221,7 +221,7 @@ bool Condition::Meets(Player* player, Unit* invoker)
     bool refMeets = false;
     if (condMeets && refId)//only have to check references if 'this' is met
     {
-        ConditionList ref = sConditionMgr->GetConditionReferences(refId);
+        ConditionList const& ref = sConditionMgr->GetConditionReferences(refId);
         refMeets = sConditionMgr->IsPlayerMeetToConditions(player, ref);
     }
     else
@@ -234,6 +234,71 @@ bool Condition::Meets(Player* player, Unit* invoker)
     return condMeets && refMeets && script;
 }
 
+// Rough relative cost of Meets(), used to order the conditions of an else group
+uint32 Condition::GetEvaluationCost() const
+{
+    // conditions with an error text are checked first so a failing group still reports it
+    if (ErrorTextd)
+        return 0;
+
+    if (mReferenceId)
+        return 8;
+
+    uint32 cost;
+    switch (mConditionType)
+    {
+        case CONDITION_NONE:
+        case CONDITION_ZONEID:
+        case CONDITION_TEAM:
+        case CONDITION_DRUNKENSTATE:
+        case CONDITION_ACTIVE_EVENT:
+        case CONDITION_CLASS:
+        case CONDITION_RACE:
+        case CONDITION_CREATURE_TARGET:
+        case CONDITION_TARGET_HEALTH_BELOW_PCT:
+        case CONDITION_TARGET_RANGE:
+        case CONDITION_MAPID:
+        case CONDITION_AREAID:
+        case CONDITION_LEVEL:
+            cost = 1;                                       // plain field compares
+            break;
+        case CONDITION_AURA:
+        case CONDITION_NO_AURA:
+        case CONDITION_REPUTATION_RANK:
+        case CONDITION_SKILL:
+        case CONDITION_QUESTREWARDED:
+        case CONDITION_QUESTTAKEN:
+        case CONDITION_QUEST_NONE:
+        case CONDITION_QUEST_COMPLETE:
+        case CONDITION_ACHIEVEMENT:
+        case CONDITION_SPELL:
+        case CONDITION_INSTANCE_DATA:
+            cost = 2;                                       // container lookups
+            break;
+        case CONDITION_ITEM:
+        case CONDITION_ITEM_EQUIPPED:
+        case CONDITION_NOITEM:
+            cost = 3;                                       // inventory scans
+            break;
+        case CONDITION_NEAR_CREATURE:
+        case CONDITION_NEAR_GAMEOBJECT:
+            cost = 4;                                       // grid searches
+            break;
+        default:
+            cost = 1;
+            break;
+    }
+
+    // value3 'quick' reference, aura uses value3 for something else
+    if (mConditionValue3 && mConditionType != CONDITION_AURA && cost < 4)
+        cost += 4;
+
+    if (mScriptId)
+        cost += 4;
+
+    return cost;
+}
+
 ConditionMgr::ConditionMgr()
 {
 }
@@ -243,54 +308,72 @@ ConditionMgr::~ConditionMgr()
     Clean();
 }
 
-ConditionList ConditionMgr::GetConditionReferences(uint32 refId)
+ConditionList const& ConditionMgr::GetConditionReferences(uint32 refId) const
 {
-    ConditionList conditions;
     ConditionReferenceMap::const_iterator ref = m_ConditionReferenceMap.find(refId);
     if (ref != m_ConditionReferenceMap.end())
-        conditions = (*ref).second;
-    return conditions;
+        return ref->second;
+    return m_EmptyConditionList;
+}
+
+void ConditionMgr::AddToConditionList(ConditionList& conditions, Condition* cond)
+{
+    // insert after every condition of a lower else group, or of the same group with lower or equal cost
+    uint32 cost = cond->GetEvaluationCost();
+    ConditionList::iterator itr = conditions.end();
+    while (itr != conditions.begin())
+    {
+        Condition const* prev = *(itr - 1);
+        if (prev->mElseGroup < cond->mElseGroup || (prev->mElseGroup == cond->mElseGroup && prev->GetEvaluationCost() <= cost))
+            break;
+        --itr;
+    }
+    conditions.insert(itr, cond);
 }
 
 bool ConditionMgr::IsPlayerMeetToConditionList(Player* player, ConditionList const& conditions, Unit* invoker /*= NULL*/)
 {
-    std::map<uint32, bool> ElseGroupMap;
-    for (ConditionList::const_iterator i = conditions.begin(); i != conditions.end(); ++i)
+    // conditions are grouped by else group (see AddToConditionList): the list is met as soon as
+    // one group has all its conditions met, the rest of a group is skipped after its first failure
+    ConditionList::const_iterator i = conditions.begin();
+    while (i != conditions.end())
     {
-        sLog->outDebug(LOG_FILTER_CONDITIONSYS, "ConditionMgr::IsPlayerMeetToConditionList condType: %u val1: %u", (*i)->mConditionType, (*i)->mConditionValue1);
-        if ((*i)->isLoaded())
+        uint32 elseGroup = (*i)->mElseGroup;
+        bool hasConditions = false;
+        bool groupMeets = true;
+
+        for (; i != conditions.end() && (*i)->mElseGroup == elseGroup; ++i)
         {
-            std::map<uint32, bool>::const_iterator itr = ElseGroupMap.find((*i)->mElseGroup);
-            if (itr == ElseGroupMap.end())
-                ElseGroupMap[(*i)->mElseGroup] = true;
-            else if (!(*itr).second)
+            if (!groupMeets || !(*i)->isLoaded())
                 continue;
 
+            sLog->outDebug(LOG_FILTER_CONDITIONSYS, "ConditionMgr::IsPlayerMeetToConditionList condType: %u val1: %u", (*i)->mConditionType, (*i)->mConditionValue1);
+            hasConditions = true;
+
             if ((*i)->mReferenceId)//handle reference
             {
                 ConditionReferenceMap::const_iterator ref = m_ConditionReferenceMap.find((*i)->mReferenceId);
                 if (ref != m_ConditionReferenceMap.end())
                 {
-                    if (!IsPlayerMeetToConditionList(player, (*ref).second, invoker))
-                        ElseGroupMap[(*i)->mElseGroup] = false;
+                    if (!IsPlayerMeetToConditionList(player, ref->second, invoker))
+                        groupMeets = false;
                 }
                 else
                 {
                     sLog->outDebug(LOG_FILTER_CONDITIONSYS, "IsPlayerMeetToConditionList: Reference template -%u not found",
                         (*i)->mReferenceId);//checked at loading, should never happen
                 }
-
             }
             else //handle normal condition
             {
                 if (!(*i)->Meets(player, invoker))
-                    ElseGroupMap[(*i)->mElseGroup] = false;
+                    groupMeets = false;
             }
         }
-    }
-    for (std::map<uint32, bool>::const_iterator i = ElseGroupMap.begin(); i != ElseGroupMap.end(); ++i)
-        if (i->second)
+
+        if (hasConditions && groupMeets)
             return true;
+    }
 
     return false;
 }
@@ -312,39 +395,29 @@ bool ConditionMgr::IsPlayerMeetToConditions(Player* player, ConditionList const&
     return result;
 }
 
-ConditionList ConditionMgr::GetConditionsForNotGroupedEntry(ConditionSourceType sType, uint32 uEntry)
+ConditionList const& ConditionMgr::GetConditionsForNotGroupedEntry(ConditionSourceType sType, uint32 uEntry) const
 {
-    ConditionList spellCond;
     if (sType > CONDITION_SOURCE_TYPE_NONE && sType < CONDITION_SOURCE_TYPE_MAX)
     {
-        ConditionMap::const_iterator itr = m_ConditionMap.find(sType);
-        if (itr != m_ConditionMap.end())
+        ConditionTypeMap::const_iterator i = m_ConditionMap[sType].find(uEntry);
+        if (i != m_ConditionMap[sType].end())
         {
-            ConditionTypeMap::const_iterator i = (*itr).second.find(uEntry);
-            if (i != (*itr).second.end())
-            {
-                spellCond = (*i).second;
-                sLog->outDebug(LOG_FILTER_CONDITIONSYS, "GetConditionsForNotGroupedEntry: found conditions for type %u and entry %u", uint32(sType), uEntry);
-            }
+            sLog->outDebug(LOG_FILTER_CONDITIONSYS, "GetConditionsForNotGroupedEntry: found conditions for type %u and entry %u", uint32(sType), uEntry);
+            return i->second;
         }
     }
-    return spellCond;
+    return m_EmptyConditionList;
 }
 
-ConditionList ConditionMgr::GetConditionsForVehicleSpell(uint32 creatureID, uint32 spellID)
+ConditionList const& ConditionMgr::GetConditionsForVehicleSpell(uint32 creatureID, uint32 spellID) const
 {
-    ConditionList cond;
-    VehicleSpellConditionMap::const_iterator itr = m_VehicleSpellConditions.find(creatureID);
+    VehicleSpellConditionMap::const_iterator itr = m_VehicleSpellConditions.find(MAKE_PAIR64(spellID, creatureID));
     if (itr != m_VehicleSpellConditions.end())
     {
-        ConditionTypeMap::const_iterator i = (*itr).second.find(spellID);
-        if (i != (*itr).second.end())
-        {
-            cond = (*i).second;
-            sLog->outDebug(LOG_FILTER_CONDITIONSYS, "GetConditionsForVehicleSpell: found conditions for Vehicle entry %u spell %u", creatureID, spellID);
-        }
+        sLog->outDebug(LOG_FILTER_CONDITIONSYS, "GetConditionsForVehicleSpell: found conditions for Vehicle entry %u spell %u", creatureID, spellID);
+        return itr->second;
     }
-    return cond;
+    return m_EmptyConditionList;
 }
 
 void ConditionMgr::LoadConditions(bool isReload)
@@ -443,12 +516,7 @@ void ConditionMgr::LoadConditions(bool isReload)
         if (iSourceTypeOrReferenceId < 0)//it is a reference template
         {
             uint32 uRefId = abs(iSourceTypeOrReferenceId);
-            if (m_ConditionReferenceMap.find(uRefId) == m_ConditionReferenceMap.end())//make sure we have a list for our conditions, based on reference id
-            {
-                ConditionList mCondList;
-                m_ConditionReferenceMap[uRefId] = mCondList;
-            }
-            m_ConditionReferenceMap[uRefId].push_back(cond);//add to reference storage
+            AddToConditionList(m_ConditionReferenceMap[uRefId], cond);//add to reference storage
             count++;
             continue;
         }//end of reference templates
@@ -462,6 +530,13 @@ void ConditionMgr::LoadConditions(bool isReload)
             continue;
         }
 
+        if (cond->mSourceType >= CONDITION_SOURCE_TYPE_MAX)
+        {
+            sLog->outErrorDb("Condition SourceTypeOrReferenceId %i (SourceEntry %u, SourceGroup %u) has invalid SourceType, skipped", iSourceTypeOrReferenceId, cond->mSourceEntry, cond->mSourceGroup);
+            delete cond;
+            continue;
+        }
+
         //Grouping is only allowed for some types (loot templates, gossip menus, gossip items)
         if (cond->mSourceGroup && !isGroupable(cond->mSourceType))
         {
@@ -519,19 +594,7 @@ void ConditionMgr::LoadConditions(bool isReload)
                     break;
                 case CONDITION_SOURCE_TYPE_VEHICLE_SPELL:
                 {
-                    //if no list for vehicle create one
-                    if (m_VehicleSpellConditions.find(cond->mSourceGroup) == m_VehicleSpellConditions.end())
-                    {
-                        ConditionTypeMap cmap;
-                        m_VehicleSpellConditions[cond->mSourceGroup] = cmap;
-                    }
-                    //if no list for vehicle's spell create one
-                    if (m_VehicleSpellConditions[cond->mSourceGroup].find(cond->mSourceEntry) == m_VehicleSpellConditions[cond->mSourceGroup].end())
-                    {
-                        ConditionList clist;
-                        m_VehicleSpellConditions[cond->mSourceGroup][cond->mSourceEntry] = clist;
-                    }
-                    m_VehicleSpellConditions[cond->mSourceGroup][cond->mSourceEntry].push_back(cond);
+                    AddToConditionList(m_VehicleSpellConditions[MAKE_PAIR64(cond->mSourceEntry, cond->mSourceGroup)], cond);
                     bIsDone = true;
                     ++count;
                     continue;   // do not add to m_AllocatedMemory to avoid double deleting
@@ -554,22 +617,8 @@ void ConditionMgr::LoadConditions(bool isReload)
         }
 
         //handle not grouped conditions
-        //make sure we have a storage list for our SourceType
-        if (m_ConditionMap.find(cond->mSourceType) == m_ConditionMap.end())
-        {
-            ConditionTypeMap mTypeMap;
-            m_ConditionMap[cond->mSourceType] = mTypeMap;//add new empty list for SourceType
-        }
-
-        //make sure we have a condition list for our SourceType's entry
-        if (m_ConditionMap[cond->mSourceType].find(cond->mSourceEntry) == m_ConditionMap[cond->mSourceType].end())
-        {
-            ConditionList mCondList;
-            m_ConditionMap[cond->mSourceType][cond->mSourceEntry] = mCondList;
-        }
-
         //add new Condition to storage based on Type/Entry
-        m_ConditionMap[cond->mSourceType][cond->mSourceEntry].push_back(cond);
+        AddToConditionList(m_ConditionMap[cond->mSourceType][cond->mSourceEntry], cond);
         ++count;
     }
     while (result->NextRow());
@@ -603,7 +652,7 @@ bool ConditionMgr::addToGossipMenus(Condition* cond)
         {
             if ((*itr).second.entry == cond->mSourceGroup && (*itr).second.text_id == cond->mSourceEntry)
             {
-                (*itr).second.conditions.push_back(cond);
+                AddToConditionList((*itr).second.conditions, cond);
                 return true;
             }
         }
@@ -622,7 +671,7 @@ bool ConditionMgr::addToGossipMenuItems(Condition* cond)
         {
             if ((*itr).second.MenuId == cond->mSourceGroup && (*itr).second.OptionIndex == cond->mSourceEntry)
             {
-                (*itr).second.Conditions.push_back(cond);
+                AddToConditionList((*itr).second.Conditions, cond);
                 return true;
             }
         }
@@ -948,7 +997,7 @@ bool ConditionMgr::isSourceTypeValid(Condition* cond)
                     if (pItemProto->Spells[i].SpellTrigger == ITEM_SPELLTRIGGER_ON_USE ||
                         pItemProto->Spells[i].SpellTrigger == ITEM_SPELLTRIGGER_ON_NO_DELAY_USE)
                     {
-                        ConditionList conditions = sConditionMgr->GetConditionsForNotGroupedEntry(CONDITION_SOURCE_TYPE_SPELL_SCRIPT_TARGET, pSpellInfo->Id);//script loading is done before item target loading
+                        ConditionList const& conditions = sConditionMgr->GetConditionsForNotGroupedEntry(CONDITION_SOURCE_TYPE_SPELL_SCRIPT_TARGET, pSpellInfo->Id);//script loading is done before item target loading
                         if (!conditions.empty())
                             break;
 
@@ -1387,27 +1436,21 @@ void ConditionMgr::Clean()
 
     m_ConditionReferenceMap.clear();
 
-    for (ConditionMap::iterator itr = m_ConditionMap.begin(); itr != m_ConditionMap.end(); ++itr)
+    for (uint32 type = 0; type < CONDITION_SOURCE_TYPE_MAX; ++type)
     {
-        for (ConditionTypeMap::iterator it = itr->second.begin(); it != itr->second.end(); ++it)
+        for (ConditionTypeMap::iterator it = m_ConditionMap[type].begin(); it != m_ConditionMap[type].end(); ++it)
         {
             for (ConditionList::const_iterator i = it->second.begin(); i != it->second.end(); ++i)
                 delete *i;
             it->second.clear();
         }
-        itr->second.clear();
+        m_ConditionMap[type].clear();
     }
 
-    m_ConditionMap.clear();
-
     for (VehicleSpellConditionMap::iterator itr = m_VehicleSpellConditions.begin(); itr != m_VehicleSpellConditions.end(); ++itr)
     {
-        for (ConditionTypeMap::iterator it = itr->second.begin(); it != itr->second.end(); ++it)
-        {
-            for (ConditionList::const_iterator i = it->second.begin(); i != it->second.end(); ++i)
-                delete *i;
-            it->second.clear();
-        }
+        for (ConditionList::const_iterator i = itr->second.begin(); i != itr->second.end(); ++i)
+            delete *i;
         itr->second.clear();
     }
 
@@ -20,6 +20,7 @@
 #define TRINITY_CONDITIONMGR_H
 
 #include "LootMgr.h"
+#include "UnorderedMap.h"
 #include <ace/Singleton.h>
 
 class Player;
@@ -130,14 +131,17 @@ struct Condition
 
     bool Meets(Player* player, Unit* invoker = NULL);
     bool isLoaded() const { return mConditionType > CONDITION_NONE || mReferenceId; }
+    uint32 GetEvaluationCost() const;
 };
 
-typedef std::list<Condition*> ConditionList;
-typedef std::map<uint32, ConditionList> ConditionTypeMap;
-typedef std::map<ConditionSourceType, ConditionTypeMap> ConditionMap;
-typedef std::map<uint32, ConditionTypeMap> VehicleSpellConditionMap;
+// Lists filled through ConditionMgr::AddToConditionList are ordered by else group and,
+// inside a group, by evaluation cost so that evaluation can stop at the first failing
+// condition of a group and at the first group that is met.
+typedef std::vector<Condition*> ConditionList;
+typedef UNORDERED_MAP<uint32, ConditionList> ConditionTypeMap;
+typedef UNORDERED_MAP<uint64, ConditionList> VehicleSpellConditionMap;   // key: MAKE_PAIR64(spell, creature)
 
-typedef std::map<uint32, ConditionList> ConditionReferenceMap;//only used for references
+typedef UNORDERED_MAP<uint32, ConditionList> ConditionReferenceMap;//only used for references
 
 class ConditionMgr
 {
@@ -150,11 +154,14 @@ class ConditionMgr
     public:
         void LoadConditions(bool isReload = false);
         bool isConditionTypeValid(Condition* cond);
-        ConditionList GetConditionReferences(uint32 refId);
+        ConditionList const& GetConditionReferences(uint32 refId) const;
 
         bool IsPlayerMeetToConditions(Player* player, ConditionList const& conditions, Unit* invoker = NULL);
-        ConditionList GetConditionsForNotGroupedEntry(ConditionSourceType sType, uint32 uEntry);
-        ConditionList GetConditionsForVehicleSpell(uint32 creatureID, uint32 spellID);
+        ConditionList const& GetConditionsForNotGroupedEntry(ConditionSourceType sType, uint32 uEntry) const;
+        ConditionList const& GetConditionsForVehicleSpell(uint32 creatureID, uint32 spellID) const;
+
+        // inserts cond keeping the list ordered for IsPlayerMeetToConditionList
+        static void AddToConditionList(ConditionList& conditions, Condition* cond);
 
     private:
         bool isSourceTypeValid(Condition* cond);
@@ -185,9 +192,10 @@ class ConditionMgr
         void Clean(); // free up resources
         std::list<Condition*> m_AllocatedMemory; // some garbage collection :)
 
-        ConditionMap                m_ConditionMap;
+        ConditionTypeMap            m_ConditionMap[CONDITION_SOURCE_TYPE_MAX];
         ConditionReferenceMap       m_ConditionReferenceMap;
         VehicleSpellConditionMap    m_VehicleSpellConditions;
+        ConditionList               m_EmptyConditionList;
 };
 
 #define sConditionMgr ACE_Singleton<ConditionMgr, ACE_Null_Mutex>::instance()
@@ -23,6 +23,7 @@
 #include "SpellMgr.h"
 
 #include "DBCfmt.h"
+#include "StartupLoader.h"
 
 #include <map>
 
@@ -205,61 +206,232 @@ static bool LoadDBC_assert_print(uint32 fsize, uint32 rsize, const std::string&
     return false;
 }
 
-template<class T>
-inline void LoadDBC(uint32& availableDbcLocales, StoreProblemList& errors, DBCStorage<T>& storage, std::string const& dbcPath, std::string const& filename, std::string const* customFormat = NULL, std::string const* customIndexName = NULL)
+// Files are read by a StartupLoader, every file is an independent step. Locales found
+// missing for one file are skipped for the files loaded after it.
+class DBCLoadContext
 {
-    // compatibility format and C++ structure sizes
-    ASSERT(DBCFileLoader::GetFormatRecordSize(storage.GetFormat()) == sizeof(T) || LoadDBC_assert_print(DBCFileLoader::GetFormatRecordSize(storage.GetFormat()), sizeof(T), filename));
-
-    ++DBCFileCount;
-    std::string dbcFilename = dbcPath + filename;
-    SqlDbc * sql = NULL;
-    if (customFormat)
-        sql = new SqlDbc(&filename, customFormat, customIndexName, storage.GetFormat());
+    public:
+        DBCLoadContext() : _loader("DBC stores"), _availableLocales(0xFFFFFFFF) {}
+        ~DBCLoadContext()
+        {
+            for (std::list<Step*>::iterator itr = _steps.begin(); itr != _steps.end(); ++itr)
+                delete *itr;
+        }
 
-    if (storage.Load(dbcFilename.c_str(), sql))
-    {
-        for (uint8 i = 0; i < TOTAL_LOCALES; ++i)
+        template<class T>
+        void Add(DBCStorage<T>& storage, std::string const& dbcPath, std::string const& filename, std::string const* customFormat, std::string const* customIndexName)
         {
-            if (!(availableDbcLocales & (1 << i)))
-                continue;
+            StoreStep<T>* step = new StoreStep<T>(*this, storage, dbcPath, filename, customFormat, customIndexName);
+            _steps.push_back(step);
+            _loader.Add(step->filename.c_str(), step, &StoreStep<T>::Load);
+        }
 
-            std::string localizedName(dbcPath);
-            localizedName.append(localeNames[i]);
-            localizedName.push_back('/');
-            localizedName.append(filename);
+        void Run(uint32 threads) { _loader.Run(threads); }
 
-            if (!storage.LoadStringsFrom(localizedName.c_str()))
-                availableDbcLocales &= ~(1<<i);             // mark as not available for speedup next checks
+        StoreProblemList const& GetErrors() const { return _errors; }
+
+        bool IsLocaleAvailable(uint8 locale)
+        {
+            ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, _lock, false);
+            return (_availableLocales & (1 << locale)) != 0;
         }
-    }
-    else
-    {
-        // sort problematic dbc to (1) non compatible and (2) non-existed
-        if (FILE* f = fopen(dbcFilename.c_str(), "rb"))
+
+        void SetLocaleUnavailable(uint8 locale)
         {
-            char buf[100];
-            snprintf(buf, 100, " (exists, but has %u fields instead of " SIZEFMTD ") Possible wrong client version.", storage.GetFieldCount(), strlen(storage.GetFormat()));
-            errors.push_back(dbcFilename + buf);
-            fclose(f);
+            ACE_GUARD(ACE_Thread_Mutex, guard, _lock);
+            _availableLocales &= ~(1 << locale);
         }
-        else
-            errors.push_back(dbcFilename);
-    }
 
-    delete sql;
+        void AddError(std::string const& error)
+        {
+            ACE_GUARD(ACE_Thread_Mutex, guard, _lock);
+            _errors.push_back(error);
+        }
+
+    private:
+        struct Step
+        {
+            virtual ~Step() {}
+        };
+
+        template<class T>
+        struct StoreStep : public Step
+        {
+            StoreStep(DBCLoadContext& context, DBCStorage<T>& storage, std::string const& dbcPath, std::string const& filename, std::string const* customFormat, std::string const* customIndexName) :
+                context(context), storage(storage), dbcPath(dbcPath), filename(filename), customFormat(customFormat), customIndexName(customIndexName) {}
+
+            void Load()
+            {
+                std::string dbcFilename = dbcPath + filename;
+                SqlDbc * sql = NULL;
+                if (customFormat)
+                    sql = new SqlDbc(&filename, customFormat, customIndexName, storage.GetFormat());
+
+                if (storage.Load(dbcFilename.c_str(), sql))
+                {
+                    for (uint8 i = 0; i < TOTAL_LOCALES; ++i)
+                    {
+                        if (!context.IsLocaleAvailable(i))
+                            continue;
+
+                        std::string localizedName(dbcPath);
+                        localizedName.append(localeNames[i]);
+                        localizedName.push_back('/');
+                        localizedName.append(filename);
+
+                        if (!storage.LoadStringsFrom(localizedName.c_str()))
+                            context.SetLocaleUnavailable(i); // mark as not available for speedup next checks
+                    }
+                }
+                else
+                {
+                    // sort problematic dbc to (1) non compatible and (2) non-existed
+                    if (FILE* f = fopen(dbcFilename.c_str(), "rb"))
+                    {
+                        char buf[100];
+                        snprintf(buf, 100, " (exists, but has %u fields instead of " SIZEFMTD ") Possible wrong client version.", storage.GetFieldCount(), strlen(storage.GetFormat()));
+                        context.AddError(dbcFilename + buf);
+                        fclose(f);
+                    }
+                    else
+                        context.AddError(dbcFilename);
+                }
+
+                delete sql;
+            }
+
+            DBCLoadContext& context;
+            DBCStorage<T>& storage;
+            std::string dbcPath;
+            std::string filename;
+            std::string const* customFormat;
+            std::string const* customIndexName;
+        };
+
+        StartupLoader _loader;
+        std::list<Step*> _steps;
+
+        ACE_Thread_Mutex _lock;
+        uint32 _availableLocales;
+        StoreProblemList _errors;
+};
+
+template<class T>
+inline void LoadDBC(DBCLoadContext& context, DBCStorage<T>& storage, std::string const& dbcPath, std::string const& filename, std::string const* customFormat = NULL, std::string const* customIndexName = NULL)
+{
+    // compatibility format and C++ structure sizes
+    ASSERT(DBCFileLoader::GetFormatRecordSize(storage.GetFormat()) == sizeof(T) || LoadDBC_assert_print(DBCFileLoader::GetFormatRecordSize(storage.GetFormat()), sizeof(T), filename));
+
+    ++DBCFileCount;
+    context.Add(storage, dbcPath, filename, customFormat, customIndexName);
 }
 
-void LoadDBCStores(const std::string& dataPath)
+void LoadDBCStores(const std::string& dataPath, uint32 threads)
 {
     uint32 oldMSTime = getMSTime();
 
     std::string dbcPath = dataPath+"dbc/";
 
-    StoreProblemList bad_dbc_files;
-    uint32 availableDbcLocales = 0xFFFFFFFF;
-
-    LoadDBC(availableDbcLocales, bad_dbc_files, sAreaStore,                   dbcPath, "AreaTable.dbc");
+    DBCLoadContext context;
+
+    LoadDBC(context, sAreaStore,                   dbcPath, "AreaTable.dbc");
+    LoadDBC(context, sAchievementStore,            dbcPath, "Achievement.dbc", &CustomAchievementfmt, &CustomAchievementIndex);
+    LoadDBC(context, sAchievementCriteriaStore,    dbcPath, "Achievement_Criteria.dbc");
+    LoadDBC(context, sAreaTriggerStore,            dbcPath, "AreaTrigger.dbc");
+    LoadDBC(context, sAreaGroupStore,              dbcPath, "AreaGroup.dbc");
+    LoadDBC(context, sAreaPOIStore,                dbcPath, "AreaPOI.dbc");
+    LoadDBC(context, sAuctionHouseStore,           dbcPath, "AuctionHouse.dbc");
+    LoadDBC(context, sBankBagSlotPricesStore,      dbcPath, "BankBagSlotPrices.dbc");
+    LoadDBC(context, sBattlemasterListStore,       dbcPath, "BattlemasterList.dbc");
+    LoadDBC(context, sBarberShopStyleStore,        dbcPath, "BarberShopStyle.dbc");
+    LoadDBC(context, sCharStartOutfitStore,        dbcPath, "CharStartOutfit.dbc");
+    LoadDBC(context, sCharTitlesStore,             dbcPath, "CharTitles.dbc");
+    LoadDBC(context, sChatChannelsStore,           dbcPath, "ChatChannels.dbc");
+    LoadDBC(context, sChrClassesStore,             dbcPath, "ChrClasses.dbc");
+    LoadDBC(context, sChrRacesStore,               dbcPath, "ChrRaces.dbc");
+    LoadDBC(context, sCinematicSequencesStore,     dbcPath, "CinematicSequences.dbc");
+    LoadDBC(context, sCreatureDisplayInfoStore,    dbcPath, "CreatureDisplayInfo.dbc");
+    LoadDBC(context, sCreatureFamilyStore,         dbcPath, "CreatureFamily.dbc");
+    LoadDBC(context, sCreatureSpellDataStore,      dbcPath, "CreatureSpellData.dbc");
+    LoadDBC(context, sCreatureTypeStore,           dbcPath, "CreatureType.dbc");
+    LoadDBC(context, sCurrencyTypesStore,          dbcPath, "CurrencyTypes.dbc");
+    LoadDBC(context, sDestructibleModelDataStore,  dbcPath, "DestructibleModelData.dbc");
+    LoadDBC(context, sDungeonEncounterStore,       dbcPath, "DungeonEncounter.dbc");
+    LoadDBC(context, sDurabilityCostsStore,        dbcPath, "DurabilityCosts.dbc");
+    LoadDBC(context, sDurabilityQualityStore,      dbcPath, "DurabilityQuality.dbc");
+    LoadDBC(context, sEmotesStore,                 dbcPath, "Emotes.dbc");
+    LoadDBC(context, sEmotesTextStore,             dbcPath, "EmotesText.dbc");
+    LoadDBC(context, sFactionStore,                dbcPath, "Faction.dbc");
+    LoadDBC(context, sFactionTemplateStore,        dbcPath, "FactionTemplate.dbc");
+    LoadDBC(context, sGameObjectDisplayInfoStore,  dbcPath, "GameObjectDisplayInfo.dbc");
+    LoadDBC(context, sGemPropertiesStore,          dbcPath, "GemProperties.dbc");
+    LoadDBC(context, sGlyphPropertiesStore,        dbcPath, "GlyphProperties.dbc");
+    LoadDBC(context, sGlyphSlotStore,              dbcPath, "GlyphSlot.dbc");
+    LoadDBC(context, sGtBarberShopCostBaseStore,   dbcPath, "gtBarberShopCostBase.dbc");
+    LoadDBC(context, sGtCombatRatingsStore,        dbcPath, "gtCombatRatings.dbc");
+    LoadDBC(context, sGtChanceToMeleeCritBaseStore, dbcPath, "gtChanceToMeleeCritBase.dbc");
+    LoadDBC(context, sGtChanceToMeleeCritStore,    dbcPath, "gtChanceToMeleeCrit.dbc");
+    LoadDBC(context, sGtChanceToSpellCritBaseStore, dbcPath, "gtChanceToSpellCritBase.dbc");
+    LoadDBC(context, sGtChanceToSpellCritStore,    dbcPath, "gtChanceToSpellCrit.dbc");
+    LoadDBC(context, sGtOCTClassCombatRatingScalarStore,    dbcPath, "gtOCTClassCombatRatingScalar.dbc");
+    LoadDBC(context, sGtOCTRegenHPStore,           dbcPath, "gtOCTRegenHP.dbc");
+    LoadDBC(context, sGtRegenHPPerSptStore,        dbcPath, "gtRegenHPPerSpt.dbc");
+    LoadDBC(context, sGtRegenMPPerSptStore,        dbcPath, "gtRegenMPPerSpt.dbc");
+    LoadDBC(context, sHolidaysStore,               dbcPath, "Holidays.dbc");
+    LoadDBC(context, sItemStore,                   dbcPath, "Item.dbc");
+    LoadDBC(context, sItemBagFamilyStore,          dbcPath, "ItemBagFamily.dbc");
+    LoadDBC(context, sItemExtendedCostStore,       dbcPath, "ItemExtendedCost.dbc");
+    LoadDBC(context, sItemLimitCategoryStore,      dbcPath, "ItemLimitCategory.dbc");
+    LoadDBC(context, sItemRandomPropertiesStore,   dbcPath, "ItemRandomProperties.dbc");
+    LoadDBC(context, sItemRandomSuffixStore,       dbcPath, "ItemRandomSuffix.dbc");
+    LoadDBC(context, sItemSetStore,                dbcPath, "ItemSet.dbc");
+    LoadDBC(context, sLFGDungeonStore,             dbcPath, "LFGDungeons.dbc");
+    LoadDBC(context, sLockStore,                   dbcPath, "Lock.dbc");
+    LoadDBC(context, sMailTemplateStore,           dbcPath, "MailTemplate.dbc");
+    LoadDBC(context, sMapStore,                    dbcPath, "Map.dbc");
+    LoadDBC(context, sMapDifficultyStore,          dbcPath, "MapDifficulty.dbc");
+    LoadDBC(context, sMovieStore,                  dbcPath, "Movie.dbc");
+    LoadDBC(context, sOverrideSpellDataStore,      dbcPath, "OverrideSpellData.dbc");
+    LoadDBC(context, sPvPDifficultyStore,          dbcPath, "PvpDifficulty.dbc");
+    LoadDBC(context, sQuestXPStore,                dbcPath, "QuestXP.dbc");
+    LoadDBC(context, sQuestFactionRewardStore,     dbcPath, "QuestFactionReward.dbc");
+    LoadDBC(context, sQuestSortStore,              dbcPath, "QuestSort.dbc");
+    LoadDBC(context, sRandomPropertiesPointsStore, dbcPath, "RandPropPoints.dbc");
+    LoadDBC(context, sScalingStatDistributionStore, dbcPath, "ScalingStatDistribution.dbc");
+    LoadDBC(context, sScalingStatValuesStore,      dbcPath, "ScalingStatValues.dbc");
+    LoadDBC(context, sSkillLineStore,              dbcPath, "SkillLine.dbc");
+    LoadDBC(context, sSkillLineAbilityStore,       dbcPath, "SkillLineAbility.dbc");
+    LoadDBC(context, sSoundEntriesStore,           dbcPath, "SoundEntries.dbc");
+    LoadDBC(context, sSpellStore,                  dbcPath, "Spell.dbc", &CustomSpellEntryfmt, &CustomSpellEntryIndex);
+    LoadDBC(context, sSpellCastTimesStore,         dbcPath, "SpellCastTimes.dbc");
+    LoadDBC(context, sSpellDifficultyStore,        dbcPath, "SpellDifficulty.dbc", &CustomSpellDifficultyfmt, &CustomSpellDifficultyIndex);
+    LoadDBC(context, sSpellDurationStore,          dbcPath, "SpellDuration.dbc");
+    LoadDBC(context, sSpellFocusObjectStore,       dbcPath, "SpellFocusObject.dbc");
+    LoadDBC(context, sSpellItemEnchantmentStore,   dbcPath, "SpellItemEnchantment.dbc");
+    LoadDBC(context, sSpellItemEnchantmentConditionStore, dbcPath, "SpellItemEnchantmentCondition.dbc");
+    LoadDBC(context, sSpellRadiusStore,            dbcPath, "SpellRadius.dbc");
+    LoadDBC(context, sSpellRangeStore,             dbcPath, "SpellRange.dbc");
+    LoadDBC(context, sSpellRuneCostStore,          dbcPath, "SpellRuneCost.dbc");
+    LoadDBC(context, sSpellShapeshiftStore,        dbcPath, "SpellShapeshiftForm.dbc");
+    LoadDBC(context, sStableSlotPricesStore,       dbcPath, "StableSlotPrices.dbc");
+    LoadDBC(context, sSummonPropertiesStore,       dbcPath, "SummonProperties.dbc");
+    LoadDBC(context, sTalentStore,                 dbcPath, "Talent.dbc");
+    LoadDBC(context, sTalentTabStore,              dbcPath, "TalentTab.dbc");
+    LoadDBC(context, sTaxiNodesStore,              dbcPath, "TaxiNodes.dbc");
+    LoadDBC(context, sTaxiPathStore,               dbcPath, "TaxiPath.dbc");
+    LoadDBC(context, sTaxiPathNodeStore,           dbcPath, "TaxiPathNode.dbc");
+    LoadDBC(context, sTeamContributionPointsStore, dbcPath, "TeamContributionPoints.dbc");
+    LoadDBC(context, sTotemCategoryStore,          dbcPath, "TotemCategory.dbc");
+    LoadDBC(context, sVehicleStore,                dbcPath, "Vehicle.dbc");
+    LoadDBC(context, sVehicleSeatStore,            dbcPath, "VehicleSeat.dbc");
+    LoadDBC(context, sWMOAreaTableStore,           dbcPath, "WMOAreaTable.dbc");
+    LoadDBC(context, sWorldMapAreaStore,           dbcPath, "WorldMapArea.dbc");
+    LoadDBC(context, sWorldMapOverlayStore,        dbcPath, "WorldMapOverlay.dbc");
+    LoadDBC(context, sWorldSafeLocsStore,          dbcPath, "WorldSafeLocs.dbc");
+
+    context.Run(threads);
+
+    StoreProblemList const& bad_dbc_files = context.GetErrors();
 
     // must be after sAreaStore loading
     for (uint32 i = 0; i < sAreaStore.GetNumRows(); ++i)           // areaflag numbered from 0
@@ -275,33 +447,6 @@ void LoadDBCStores(const std::string& dataPath)
         }
     }
 
-    LoadDBC(availableDbcLocales, bad_dbc_files, sAchievementStore,            dbcPath, "Achievement.dbc", &CustomAchievementfmt, &CustomAchievementIndex);
-    LoadDBC(availableDbcLocales, bad_dbc_files, sAchievementCriteriaStore,    dbcPath, "Achievement_Criteria.dbc");
-    LoadDBC(availableDbcLocales, bad_dbc_files, sAreaTriggerStore,            dbcPath, "AreaTrigger.dbc");
-    LoadDBC(availableDbcLocales, bad_dbc_files, sAreaGroupStore,              dbcPath, "AreaGroup.dbc");
-    LoadDBC(availableDbcLocales, bad_dbc_files, sAreaPOIStore,                dbcPath, "AreaPOI.dbc");
-    LoadDBC(availableDbcLocales, bad_dbc_files, sAuctionHouseStore,           dbcPath, "AuctionHouse.dbc");
-    LoadDBC(availableDbcLocales, bad_dbc_files, sBankBagSlotPricesStore,      dbcPath, "BankBagSlotPrices.dbc");
-    LoadDBC(availableDbcLocales, bad_dbc_files, sBattlemasterListStore,       dbcPath, "BattlemasterList.dbc");
-    LoadDBC(availableDbcLocales, bad_dbc_files, sBarberShopStyleStore,        dbcPath, "BarberShopStyle.dbc");
-    LoadDBC(availableDbcLocales, bad_dbc_files, sCharStartOutfitStore,        dbcPath, "CharStartOutfit.dbc");
-    LoadDBC(availableDbcLocales, bad_dbc_files, sCharTitlesStore,             dbcPath, "CharTitles.dbc");
-    LoadDBC(availableDbcLocales, bad_dbc_files, sChatChannelsStore,           dbcPath, "ChatChannels.dbc");
-    LoadDBC(availableDbcLocales, bad_dbc_files, sChrClassesStore,             dbcPath, "ChrClasses.dbc");
-    LoadDBC(availableDbcLocales, bad_dbc_files, sChrRacesStore,               dbcPath, "ChrRaces.dbc");
-    LoadDBC(availableDbcLocales, bad_dbc_files, sCinematicSequencesStore,     dbcPath, "CinematicSequences.dbc");
-    LoadDBC(availableDbcLocales, bad_dbc_files, sCreatureDisplayInfoStore,    dbcPath, "CreatureDisplayInfo.dbc");
-    LoadDBC(availableDbcLocales, bad_dbc_files, sCreatureFamilyStore,         dbcPath, "CreatureFamily.dbc");
-    LoadDBC(availableDbcLocales, bad_dbc_files, sCreatureSpellDataStore,      dbcPath, "CreatureSpellData.dbc");
-    LoadDBC(availableDbcLocales, bad_dbc_files, sCreatureTypeStore,           dbcPath, "CreatureType.dbc");
-    LoadDBC(availableDbcLocales, bad_dbc_files, sCurrencyTypesStore,          dbcPath, "CurrencyTypes.dbc");
-    LoadDBC(availableDbcLocales, bad_dbc_files, sDestructibleModelDataStore,  dbcPath, "DestructibleModelData.dbc");
-    LoadDBC(availableDbcLocales, bad_dbc_files, sDungeonEncounterStore,       dbcPath, "DungeonEncounter.dbc");
-    LoadDBC(availableDbcLocales, bad_dbc_files, sDurabilityCostsStore,        dbcPath, "DurabilityCosts.dbc");
-    LoadDBC(availableDbcLocales, bad_dbc_files, sDurabilityQualityStore,      dbcPath, "DurabilityQuality.dbc");
-    LoadDBC(availableDbcLocales, bad_dbc_files, sEmotesStore,                 dbcPath, "Emotes.dbc");
-    LoadDBC(availableDbcLocales, bad_dbc_files, sEmotesTextStore,             dbcPath, "EmotesText.dbc");
-    LoadDBC(availableDbcLocales, bad_dbc_files, sFactionStore,                dbcPath, "Faction.dbc");
     for (uint32 i=0; i<sFactionStore.GetNumRows(); ++i)
     {
         FactionEntry const* faction = sFactionStore.LookupEntry(i);
@@ -312,8 +457,6 @@ void LoadDBCStores(const std::string& dataPath)
         }
     }
 
-    LoadDBC(availableDbcLocales, bad_dbc_files, sFactionTemplateStore,        dbcPath, "FactionTemplate.dbc");
-    LoadDBC(availableDbcLocales, bad_dbc_files, sGameObjectDisplayInfoStore,  dbcPath, "GameObjectDisplayInfo.dbc");
     for (uint32 i = 0; i < sGameObjectDisplayInfoStore.GetNumRows(); ++i)
     {
         if (GameObjectDisplayInfoEntry const* info = sGameObjectDisplayInfoStore.LookupEntry(i))
@@ -327,67 +470,22 @@ void LoadDBCStores(const std::string& dataPath)
         }
     }
 
-    LoadDBC(availableDbcLocales, bad_dbc_files, sGemPropertiesStore,          dbcPath, "GemProperties.dbc");
-    LoadDBC(availableDbcLocales, bad_dbc_files, sGlyphPropertiesStore,        dbcPath, "GlyphProperties.dbc");
-    LoadDBC(availableDbcLocales, bad_dbc_files, sGlyphSlotStore,              dbcPath, "GlyphSlot.dbc");
-    LoadDBC(availableDbcLocales, bad_dbc_files, sGtBarberShopCostBaseStore,   dbcPath, "gtBarberShopCostBase.dbc");
-    LoadDBC(availableDbcLocales, bad_dbc_files, sGtCombatRatingsStore,        dbcPath, "gtCombatRatings.dbc");
-    LoadDBC(availableDbcLocales, bad_dbc_files, sGtChanceToMeleeCritBaseStore, dbcPath, "gtChanceToMeleeCritBase.dbc");
-    LoadDBC(availableDbcLocales, bad_dbc_files, sGtChanceToMeleeCritStore,    dbcPath, "gtChanceToMeleeCrit.dbc");
-    LoadDBC(availableDbcLocales, bad_dbc_files, sGtChanceToSpellCritBaseStore, dbcPath, "gtChanceToSpellCritBase.dbc");
-    LoadDBC(availableDbcLocales, bad_dbc_files, sGtChanceToSpellCritStore,    dbcPath, "gtChanceToSpellCrit.dbc");
-    LoadDBC(availableDbcLocales, bad_dbc_files, sGtOCTClassCombatRatingScalarStore,    dbcPath, "gtOCTClassCombatRatingScalar.dbc");
-    LoadDBC(availableDbcLocales, bad_dbc_files, sGtOCTRegenHPStore,           dbcPath, "gtOCTRegenHP.dbc");
     //LoadDBC(dbcCount, availableDbcLocales, bad_dbc_files, sGtOCTRegenMPStore,           dbcPath, "gtOCTRegenMP.dbc");       -- not used currently
-    LoadDBC(availableDbcLocales, bad_dbc_files, sGtRegenHPPerSptStore,        dbcPath, "gtRegenHPPerSpt.dbc");
-    LoadDBC(availableDbcLocales, bad_dbc_files, sGtRegenMPPerSptStore,        dbcPath, "gtRegenMPPerSpt.dbc");
-
-    LoadDBC(availableDbcLocales, bad_dbc_files, sHolidaysStore,               dbcPath, "Holidays.dbc");
 
-    LoadDBC(availableDbcLocales, bad_dbc_files, sItemStore,                   dbcPath, "Item.dbc");
-    LoadDBC(availableDbcLocales, bad_dbc_files, sItemBagFamilyStore,          dbcPath, "ItemBagFamily.dbc");
     //LoadDBC(dbcCount, availableDbcLocales, bad_dbc_files, sItemDisplayInfoStore,        dbcPath, "ItemDisplayInfo.dbc");     -- not used currently
     //LoadDBC(dbcCount, availableDbcLocales, bad_dbc_files, sItemCondExtCostsStore,       dbcPath, "ItemCondExtCosts.dbc");
-    LoadDBC(availableDbcLocales, bad_dbc_files, sItemExtendedCostStore,       dbcPath, "ItemExtendedCost.dbc");
-    LoadDBC(availableDbcLocales, bad_dbc_files, sItemLimitCategoryStore,      dbcPath, "ItemLimitCategory.dbc");
-    LoadDBC(availableDbcLocales, bad_dbc_files, sItemRandomPropertiesStore,   dbcPath, "ItemRandomProperties.dbc");
-    LoadDBC(availableDbcLocales, bad_dbc_files, sItemRandomSuffixStore,       dbcPath, "ItemRandomSuffix.dbc");
-    LoadDBC(availableDbcLocales, bad_dbc_files, sItemSetStore,                dbcPath, "ItemSet.dbc");
-
-    LoadDBC(availableDbcLocales, bad_dbc_files, sLFGDungeonStore,             dbcPath, "LFGDungeons.dbc");
-    LoadDBC(availableDbcLocales, bad_dbc_files, sLockStore,                   dbcPath, "Lock.dbc");
-
-    LoadDBC(availableDbcLocales, bad_dbc_files, sMailTemplateStore,           dbcPath, "MailTemplate.dbc");
-    LoadDBC(availableDbcLocales, bad_dbc_files, sMapStore,                    dbcPath, "Map.dbc");
-    LoadDBC(availableDbcLocales, bad_dbc_files, sMapDifficultyStore,          dbcPath, "MapDifficulty.dbc");
+
     // fill data
     for (uint32 i = 1; i < sMapDifficultyStore.GetNumRows(); ++i)
         if (MapDifficultyEntry const* entry = sMapDifficultyStore.LookupEntry(i))
             sMapDifficultyMap[MAKE_PAIR32(entry->MapId, entry->Difficulty)] = MapDifficulty(entry->resetTime, entry->maxPlayers, entry->areaTriggerText[0] != '\0');
     sMapDifficultyStore.Clear();
 
-    LoadDBC(availableDbcLocales, bad_dbc_files, sMovieStore,                  dbcPath, "Movie.dbc");
-
-    LoadDBC(availableDbcLocales, bad_dbc_files, sOverrideSpellDataStore,      dbcPath, "OverrideSpellData.dbc");
-
-    LoadDBC(availableDbcLocales, bad_dbc_files, sPvPDifficultyStore,          dbcPath, "PvpDifficulty.dbc");
     for (uint32 i = 0; i < sPvPDifficultyStore.GetNumRows(); ++i)
         if (PvPDifficultyEntry const* entry = sPvPDifficultyStore.LookupEntry(i))
             if (entry->bracketId > MAX_BATTLEGROUND_BRACKETS)
                 ASSERT(false && "Need update MAX_BATTLEGROUND_BRACKETS by DBC data");
 
-    LoadDBC(availableDbcLocales, bad_dbc_files, sQuestXPStore,                dbcPath, "QuestXP.dbc");
-    LoadDBC(availableDbcLocales, bad_dbc_files, sQuestFactionRewardStore,     dbcPath, "QuestFactionReward.dbc");
-    LoadDBC(availableDbcLocales, bad_dbc_files, sQuestSortStore,              dbcPath, "QuestSort.dbc");
-
-    LoadDBC(availableDbcLocales, bad_dbc_files, sRandomPropertiesPointsStore, dbcPath, "RandPropPoints.dbc");
-
-    LoadDBC(availableDbcLocales, bad_dbc_files, sScalingStatDistributionStore, dbcPath, "ScalingStatDistribution.dbc");
-    LoadDBC(availableDbcLocales, bad_dbc_files, sScalingStatValuesStore,      dbcPath, "ScalingStatValues.dbc");
-    LoadDBC(availableDbcLocales, bad_dbc_files, sSkillLineStore,              dbcPath, "SkillLine.dbc");
-    LoadDBC(availableDbcLocales, bad_dbc_files, sSkillLineAbilityStore,       dbcPath, "SkillLineAbility.dbc");
-    LoadDBC(availableDbcLocales, bad_dbc_files, sSoundEntriesStore,           dbcPath, "SoundEntries.dbc");
-    LoadDBC(availableDbcLocales, bad_dbc_files, sSpellStore,                  dbcPath, "Spell.dbc", &CustomSpellEntryfmt, &CustomSpellEntryIndex);
     for (uint32 i = 1; i < sSpellStore.GetNumRows(); ++i)
     {
         SpellEntry const* spell = sSpellStore.LookupEntry(i);
@@ -425,21 +523,6 @@ void LoadDBCStores(const std::string& dataPath)
         }
     }
 
-    LoadDBC(availableDbcLocales, bad_dbc_files, sSpellCastTimesStore,         dbcPath, "SpellCastTimes.dbc");
-    LoadDBC(availableDbcLocales, bad_dbc_files, sSpellDifficultyStore,        dbcPath, "SpellDifficulty.dbc", &CustomSpellDifficultyfmt, &CustomSpellDifficultyIndex);
-    LoadDBC(availableDbcLocales, bad_dbc_files, sSpellDurationStore,          dbcPath, "SpellDuration.dbc");
-    LoadDBC(availableDbcLocales, bad_dbc_files, sSpellFocusObjectStore,       dbcPath, "SpellFocusObject.dbc");
-    LoadDBC(availableDbcLocales, bad_dbc_files, sSpellItemEnchantmentStore,   dbcPath, "SpellItemEnchantment.dbc");
-    LoadDBC(availableDbcLocales, bad_dbc_files, sSpellItemEnchantmentConditionStore, dbcPath, "SpellItemEnchantmentCondition.dbc");
-    LoadDBC(availableDbcLocales, bad_dbc_files, sSpellRadiusStore,            dbcPath, "SpellRadius.dbc");
-    LoadDBC(availableDbcLocales, bad_dbc_files, sSpellRangeStore,             dbcPath, "SpellRange.dbc");
-    LoadDBC(availableDbcLocales, bad_dbc_files, sSpellRuneCostStore,          dbcPath, "SpellRuneCost.dbc");
-    LoadDBC(availableDbcLocales, bad_dbc_files, sSpellShapeshiftStore,        dbcPath, "SpellShapeshiftForm.dbc");
-    LoadDBC(availableDbcLocales, bad_dbc_files, sStableSlotPricesStore,       dbcPath, "StableSlotPrices.dbc");
-    LoadDBC(availableDbcLocales, bad_dbc_files, sSummonPropertiesStore,       dbcPath, "SummonProperties.dbc");
-
-    LoadDBC(availableDbcLocales, bad_dbc_files, sTalentStore,                 dbcPath, "Talent.dbc");
-
     // Create Spelldifficulty searcher
     for (uint32 i = 0; i < sSpellDifficultyStore.GetNumRows(); ++i)
     {
@@ -477,8 +560,6 @@ void LoadDBCStores(const std::string& dataPath)
                 sTalentSpellPosMap[talentInfo->RankID[j]] = TalentSpellPos(i, j);
     }
 
-    LoadDBC(availableDbcLocales, bad_dbc_files, sTalentTabStore,              dbcPath, "TalentTab.dbc");
-
     // prepare fast data access to bit pos of talent ranks for use at inspecting
     {
         // now have all max ranks (and then bit amount used for store talent ranks in inspect)
@@ -500,15 +581,12 @@ void LoadDBCStores(const std::string& dataPath)
         }
     }
 
-    LoadDBC(availableDbcLocales, bad_dbc_files, sTaxiNodesStore,              dbcPath, "TaxiNodes.dbc");
-    LoadDBC(availableDbcLocales, bad_dbc_files, sTaxiPathStore,               dbcPath, "TaxiPath.dbc");
     for (uint32 i = 1; i < sTaxiPathStore.GetNumRows(); ++i)
         if (TaxiPathEntry const* entry = sTaxiPathStore.LookupEntry(i))
             sTaxiPathSetBySource[entry->from][entry->to] = TaxiPathBySourceAndDestination(entry->ID, entry->price);
     uint32 pathCount = sTaxiPathStore.GetNumRows();
 
     //## TaxiPathNode.dbc ## Loaded only for initialization different structures
-    LoadDBC(availableDbcLocales, bad_dbc_files, sTaxiPathNodeStore,           dbcPath, "TaxiPathNode.dbc");
     // Calculate path nodes count
     std::vector<uint32> pathLength;
     pathLength.resize(pathCount);                           // 0 and some other indexes not used
@@ -589,19 +667,9 @@ void LoadDBCStores(const std::string& dataPath)
         }
     }
 
-    LoadDBC(availableDbcLocales, bad_dbc_files, sTeamContributionPointsStore, dbcPath, "TeamContributionPoints.dbc");
-    LoadDBC(availableDbcLocales, bad_dbc_files, sTotemCategoryStore,          dbcPath, "TotemCategory.dbc");
-
-    LoadDBC(availableDbcLocales, bad_dbc_files, sVehicleStore,                dbcPath, "Vehicle.dbc");
-    LoadDBC(availableDbcLocales, bad_dbc_files, sVehicleSeatStore,            dbcPath, "VehicleSeat.dbc");
-
-    LoadDBC(availableDbcLocales, bad_dbc_files, sWMOAreaTableStore,           dbcPath, "WMOAreaTable.dbc");
     for (uint32 i = 0; i < sWMOAreaTableStore.GetNumRows(); ++i)
         if (WMOAreaTableEntry const* entry = sWMOAreaTableStore.LookupEntry(i))
             sWMOAreaInfoByTripple.insert(WMOAreaInfoByTripple::value_type(WMOAreaTableTripple(entry->rootId, entry->adtId, entry->groupId), entry));
-    LoadDBC(availableDbcLocales, bad_dbc_files, sWorldMapAreaStore,           dbcPath, "WorldMapArea.dbc");
-    LoadDBC(availableDbcLocales, bad_dbc_files, sWorldMapOverlayStore,        dbcPath, "WorldMapOverlay.dbc");
-    LoadDBC(availableDbcLocales, bad_dbc_files, sWorldSafeLocsStore,          dbcPath, "WorldSafeLocs.dbc");
 
     // error checks
     if (bad_dbc_files.size() >= DBCFileCount)
@@ -612,7 +680,7 @@ void LoadDBCStores(const std::string& dataPath)
     else if (!bad_dbc_files.empty())
     {
         std::string str;
-        for (StoreProblemList::iterator i = bad_dbc_files.begin(); i != bad_dbc_files.end(); ++i)
+        for (StoreProblemList::const_iterator i = bad_dbc_files.begin(); i != bad_dbc_files.end(); ++i)
             str += *i + "\n";
 
         sLog->outError("Some required *.dbc files (%u from %d) not found or not compatible:\n%s", (uint32)bad_dbc_files.size(), DBCFileCount, str.c_str());
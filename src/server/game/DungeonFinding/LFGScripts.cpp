@@ -27,7 +27,8 @@
 #include "LFGScripts.h"
 #include "LFGMgr.h"
 
-LFGScripts::LFGScripts(): GroupScript("LFGScripts"), PlayerScript("LFGScripts") {}
+LFGScripts::LFGScripts(): GroupScript("LFGScripts"), PlayerScript("LFGScripts",
+    SCRIPT_HOOK_MASK(PLAYERHOOK_LEVEL_CHANGED) | SCRIPT_HOOK_MASK(PLAYERHOOK_LOGOUT) | SCRIPT_HOOK_MASK(PLAYERHOOK_LOGIN) | SCRIPT_HOOK_MASK(PLAYERHOOK_BIND_TO_INSTANCE)) {}
 
 void LFGScripts::OnAddMember(Group* group, uint64 guid)
 {
@@ -48,6 +48,7 @@
 #include "Vehicle.h"
 #include "SpellAuraEffects.h"
 #include "Group.h"
+#include "TickProfiler.h"
 // apply implementation of the singletons
 
 TrainerSpell const* TrainerSpellData::Find(uint32 spell_id) const
@@ -139,11 +140,11 @@ bool ForcedDespawnDelayEvent::Execute(uint64 /*e_time*/, uint32 /*p_time*/)
 
 Creature::Creature(): Unit(),
 lootForPickPocketed(false), lootForBody(false), m_groupLootTimer(0), lootingGroupLowGUID(0),
-m_PlayerDamageReq(0), m_lootMoney(0), m_lootRecipient(0), m_lootRecipientGroup(0), m_corpseRemoveTime(0), m_respawnTime(0),
+m_PlayerDamageReq(0), m_lootMoney(0), m_lootRecipient(0), m_lootRecipientGroup(0), m_lootPending(false), m_lootSeed(0), m_corpseRemoveTime(0), m_respawnTime(0),
 m_respawnDelay(300), m_corpseDelay(60), m_respawnradius(0.0f), m_reactState(REACT_AGGRESSIVE),
 m_defaultMovementType(IDLE_MOTION_TYPE), m_DBTableGuid(0), m_equipmentId(0), m_AlreadyCallAssistance(false),
 m_AlreadySearchedAssistance(false), m_regenHealth(true), m_AI_locked(false), m_meleeDamageSchoolMask(SPELL_SCHOOL_MASK_NORMAL),
-m_creatureInfo(NULL), m_creatureData(NULL), m_formation(NULL),
+m_creatureInfo(NULL), m_creatureData(NULL), m_sleepTimer(0), m_sleptTime(0), m_formation(NULL),
 MapCreature()
 {
     m_regenTimer = CREATURE_REGEN_INTERVAL;
@@ -427,6 +428,8 @@ bool Creature::UpdateEntry(uint32 Entry, uint32 team, const CreatureData* data)
 
 void Creature::Update(uint32 diff)
 {
+    TickProfileScope profile("Creature::Update", GetGUIDLow());
+
     if (IsAIEnabled && TriggerJustRespawned)
     {
         TriggerJustRespawned = false;
@@ -575,6 +578,100 @@ void Creature::Update(uint32 diff)
     sScriptMgr->OnCreatureUpdate(this, diff);
 }
 
+void Creature::UpdateScheduled(uint32 diff)
+{
+    // the cheap checks are repeated while asleep, anything else must wake the creature explicitly
+    if (m_sleepTimer > diff && _IsIdle())
+    {
+        m_sleepTimer -= diff;
+        m_sleptTime += diff;
+        return;
+    }
+
+    diff += m_sleptTime;
+    m_sleptTime = 0;
+
+    Update(diff);
+
+    m_sleepTimer = IsInWorld() ? _GetSleepTime() : 0;
+}
+
+bool Creature::_IsIdle() const
+{
+    if (!m_Events.Empty())
+        return false;
+
+    switch (m_deathState)
+    {
+        case ALIVE:
+            break;
+        case DEAD:
+            return true;
+        case CORPSE:
+            return !m_groupLootTimer;
+        default:
+            return false;
+    }
+
+    if (isInCombat() || getVictim() || HasUnitState(UNIT_STAT_EVADE | UNIT_STAT_MOVING | UNIT_STAT_MOVE | UNIT_STAT_FOLLOW |
+        UNIT_STAT_LOST_CONTROL | UNIT_STAT_CONFUSED | UNIT_STAT_ROTATING | UNIT_STAT_DISTRACTED | UNIT_STAT_CASTING))
+        return false;
+
+    for (uint32 i = 0; i < CURRENT_MAX_SPELL; ++i)
+        if (m_currentSpells[i])
+            return false;
+
+    if (GetMotionMaster()->GetCurrentMovementGeneratorType() != IDLE_MOTION_TYPE)
+        return false;
+
+    // regeneration ticks are not summed up, keep updating until full
+    return GetHealth() >= GetMaxHealth() && GetPower(getPowerType()) >= GetMaxPower(getPowerType());
+}
+
+uint32 Creature::_GetSleepTime() const
+{
+    uint32 maxSleep = sWorld->getIntConfig(CONFIG_CREATURE_IDLE_SLEEP_TIME);
+    if (!maxSleep || !_IsIdle())
+        return 0;
+
+    // controlled, summoned and vehicle creatures follow their owners, passengers and duration timers
+    if (isSummon() || isPet() || isTotem() || IsVehicle() || GetCharmerOrOwnerGUID() || GetVehicle())
+        return 0;
+
+    time_t now = time(NULL);
+    switch (m_deathState)
+    {
+        case DEAD:
+            return m_respawnTime > now ? std::min<uint32>(maxSleep, uint32(m_respawnTime - now) * IN_MILLISECONDS) : 0;
+        case CORPSE:
+            return m_corpseRemoveTime > now ? std::min<uint32>(maxSleep, uint32(m_corpseRemoveTime - now) * IN_MILLISECONDS) : 0;
+        default:
+            break;
+    }
+
+    if (TriggerJustRespawned || NeedChangeAI || (IsAIEnabled && !AI()->CanSleep()))
+        return 0;
+
+    for (uint32 i = 0; i < MAX_REACTIVE; ++i)
+        if (m_reactiveTimer[i])
+            return 0;
+
+    // timed and periodic auras are ticked by every update
+    for (AuraMap::const_iterator itr = GetOwnedAuras().begin(); itr != GetOwnedAuras().end(); ++itr)
+    {
+        Aura const* aura = itr->second;
+        if (!aura->IsPermanent())
+            return 0;
+
+        for (uint8 i = 0; i < MAX_SPELL_EFFECTS; ++i)
+            if (AuraEffect const* effect = aura->GetEffect(i))
+                if (effect->IsPeriodic())
+                    return 0;
+    }
+
+    return maxSleep;
+}
+
 void Creature::RegenerateMana()
 {
     uint32 curValue = GetPower(POWER_MANA);
@@ -1480,6 +1577,7 @@ float Creature::GetAttackDistance(Unit const* pl) const
 
 void Creature::setDeathState(DeathState s)
 {
+    WakeUp();
     Unit::setDeathState(s);
 
     if (s == JUST_DIED)
@@ -1584,6 +1682,7 @@ void Creature::Respawn(bool force)
         m_respawnTime = 0;
         lootForPickPocketed = false;
         lootForBody         = false;
+        m_lootPending       = false;
 
         if (m_originalEntry != GetEntry())
             UpdateEntry(m_originalEntry);
@@ -2233,6 +2332,36 @@ void Creature::GetRespawnCoord(float &x, float &y, float &z, float* ori, float*
         *dist = 0;
 }
 
+void Creature::ScheduleLootGeneration()
+{
+    loot.clear();
+    m_lootPending = true;
+    m_lootSeed = GetGUIDLow() ^ getMSTime();
+}
+
+void Creature::GenerateLoot(Player* looter)
+{
+    if (!m_lootPending)
+        return;
+
+    // rights and quest items go to the recipient's group, whoever opens the corpse first
+    if (Player* recipient = GetLootRecipient())
+        looter = recipient;
+    if (!looter)
+        return;
+
+    m_lootPending = false;
+
+    RandomSeedScope seed(m_lootSeed);
+    if (uint32 lootid = GetCreatureInfo()->lootid)
+        loot.FillLoot(lootid, LootTemplates_Creature, looter, false, false, GetLootMode());
+
+    loot.generateMoneyLoot(GetCreatureInfo()->mingold, GetCreatureInfo()->maxgold);
+
+    // players around only had an estimate of their loot rights (see Player::isAllowedToLoot)
+    ForceValuesUpdateAtIndex(UNIT_DYNAMIC_FLAGS);
+}
+
 void Creature::AllLootRemovedFromCorpse()
 {
     if (!HasFlag(UNIT_FIELD_FLAGS, UNIT_FLAG_SKINNABLE))
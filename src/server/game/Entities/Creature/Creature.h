@@ -456,6 +456,11 @@ class Creature : public Unit, public GridObject<Creature>, public MapCreature
         uint32 GetDBTableGUIDLow() const { return m_DBTableGuid; }
 
         void Update(uint32 time);                         // overwrited Unit::Update
+        // grid update entry: idle creatures are put to sleep and skip updates until they are
+        // woken up or their sleep time runs out, the skipped time is handed to the next Update
+        void UpdateScheduled(uint32 diff);
+        void WakeUp() { m_sleepTimer = 0; }
+        bool IsSleeping() const { return m_sleepTimer != 0; }
         void GetRespawnCoord(float &x, float &y, float &z, float* ori = NULL, float* dist =NULL) const;
         uint32 GetEquipmentId() const { return GetCreatureInfo()->equipmentId; }
 
@@ -592,6 +597,11 @@ class Creature : public Unit, public GridObject<Creature>, public MapCreature
         void SetLootRecipient (Unit* unit);
         void AllLootRemovedFromCorpse();
 
+        // corpse loot is rolled when it is first needed (looted, group rolls, skinning check), not at death
+        void ScheduleLootGeneration();
+        void GenerateLoot(Player* looter);
+        bool IsLootPending() const { return m_lootPending; }
+
         uint16 GetLootMode() { return m_LootMode; }
         bool HasLootMode(uint16 lootMode) { return m_LootMode & lootMode; }
         void SetLootMode(uint16 lootMode) { m_LootMode = lootMode; }
@@ -718,6 +728,8 @@ class Creature : public Unit, public GridObject<Creature>, public MapCreature
         uint32 m_lootMoney;
         uint64 m_lootRecipient;
         uint32 m_lootRecipientGroup;
+        bool m_lootPending;
+        uint32 m_lootSeed;                                  // loot rolls of the corpse only depend on this
 
         /// Timers
         time_t m_corpseRemoveTime;                          // (msecs)timer for death or corpse disappearance
@@ -754,6 +766,12 @@ class Creature : public Unit, public GridObject<Creature>, public MapCreature
 
         bool IsInvisibleDueToDespawn() const;
         bool CanAlwaysSee(WorldObject const* obj) const;
+
+        bool _IsIdle() const;
+        uint32 _GetSleepTime() const;
+
+        uint32 m_sleepTimer;                                // (msecs) updates may still be skipped for
+        uint32 m_sleptTime;                                 // (msecs) skipped so far
     private:
         //WaypointMovementGenerator vars
         uint32 m_waypointID;
@@ -996,6 +996,15 @@ void GameObject::UseDoorOrButton(uint32 time_to_restore, bool alternative /* = f
     m_cooldownTime = time(NULL) + time_to_restore;
 }
 
+void GameObject::SetGoState(GOState state)
+{
+    SetByteValue(GAMEOBJECT_BYTES_1, 0, state);
+
+    // doors are what dynamic LOS objects model, drop cached LOS results of the map
+    if (GetGoType() == GAMEOBJECT_TYPE_DOOR && IsInWorld())
+        GetMap()->InvalidateQueryCache();
+}
+
 void GameObject::SetGoArtKit(uint8 kit)
 {
     SetByteValue(GAMEOBJECT_BYTES_1, 2, kit);
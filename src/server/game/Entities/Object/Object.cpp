@@ -951,6 +951,9 @@ void Object::SetFloatValue(uint16 index, float value)
             sObjectAccessor->AddUpdateObject(this);
             m_objectUpdated = true;
         }
+
+        if (index == UNIT_FIELD_COMBATREACH && isType(TYPEMASK_UNIT))
+            static_cast<WorldObject*>(this)->UpdateCellIndex();
     }
 }
 
@@ -1224,7 +1227,7 @@ void MovementInfo::OutDebug()
 WorldObject::WorldObject(): WorldLocation(),
 m_isWorldObject(false), m_name(""), m_isActive(false), m_zoneScript(NULL),
 m_transport(NULL), m_currMap(NULL), m_InstanceId(0),
-m_phaseMask(PHASEMASK_NORMAL), m_notifyflags(0), m_executed_notifies(0)
+m_phaseMask(PHASEMASK_NORMAL), m_cellIndex(NULL), m_cellIndexSlot(0), m_notifyflags(0), m_executed_notifies(0)
 {
     m_serverSideVisibility.SetValue(SERVERSIDE_VISIBILITY_GHOST, GHOST_VISIBILITY_ALIVE | GHOST_VISIBILITY_GHOST);
     m_serverSideVisibilityDetect.SetValue(SERVERSIDE_VISIBILITY_GHOST, GHOST_VISIBILITY_ALIVE);
@@ -1347,15 +1350,14 @@ bool WorldObject::IsWithinLOSInMap(const WorldObject* obj) const
 
     float ox, oy, oz;
     obj->GetPosition(ox, oy, oz);
-    return (IsWithinLOS(ox, oy, oz) && GetMap()->IsInDynLOS(GetPositionX(), GetPositionY(), GetPositionZ(), ox, oy, oz));
+    return IsWithinLOS(ox, oy, oz);
 }
 
 bool WorldObject::IsWithinLOS(float ox, float oy, float oz) const
 {
     float x, y, z;
     GetPosition(x, y, z);
-    VMAP::IVMapManager* vMapManager = VMAP::VMapFactory::createOrGetVMapManager();
-    return (vMapManager->isInLineOfSight(GetMapId(), x, y, z+2.0f, ox, oy, oz+2.0f) && GetMap()->IsInDynLOS(GetPositionX(), GetPositionY(), GetPositionZ(), ox, oy, oz));
+    return GetMap()->IsInLineOfSight(x, y, z, ox, oy, oz);
 }
 
 bool WorldObject::GetDistanceOrder(WorldObject const* obj1, WorldObject const* obj2, bool is3D /* = true */) const
@@ -2034,6 +2036,17 @@ void WorldObject::SendMessageToSet(WorldPacket* data, Player const* skipped_rcvr
     VisitNearbyWorldObject(GetVisibilityRange(), notifier);
 }
 
+void WorldObject::SendMovementMessageToSet(WorldPacket* data, Player const* skipped_rcvr)
+{
+    if (GetTypeId() == TYPEID_PLAYER && skipped_rcvr != this)
+        ((Player*)this)->GetSession()->SendPacket(data);
+
+    // never 0, that would disable the filter
+    uint32 relayTime = getMSTime() | 1;
+    Trinity::MessageDistDeliverer notifier(this, data, GetVisibilityRange(), false, skipped_rcvr, relayTime);
+    VisitNearbyWorldObject(GetVisibilityRange(), notifier);
+}
+
 void WorldObject::SendObjectDeSpawnAnim(uint64 guid)
 {
     WorldPacket data(SMSG_GAMEOBJECT_DESPAWN_ANIM, 8);
@@ -2703,6 +2716,8 @@ void WorldObject::MovePositionToFirstCollision(Position &pos, float dist, float
 void WorldObject::SetPhaseMask(uint32 newPhaseMask, bool update)
 {
     m_phaseMask = newPhaseMask;
+    if (m_cellIndex)
+        m_cellIndex->SetPhaseMask(m_cellIndexSlot, newPhaseMask);
 
     if (update && IsInWorld())
         UpdateObjectVisibility();
@@ -558,11 +558,27 @@ class FlaggedValuesArray32
 
 class WorldObject : public Object, public WorldLocation
 {
+    friend class CellPositionIndex;
     protected:
         explicit WorldObject();
     public:
         virtual ~WorldObject();
 
+        // Position::Relocate is not virtual, these hide it to keep the cell position index in sync
+        void Relocate(float x, float y)
+            { Position::Relocate(x, y); UpdateCellIndex(); }
+        void Relocate(float x, float y, float z)
+            { Position::Relocate(x, y, z); UpdateCellIndex(); }
+        void Relocate(float x, float y, float z, float orientation)
+            { Position::Relocate(x, y, z, orientation); UpdateCellIndex(); }
+        void Relocate(const Position &pos)
+            { Position::Relocate(pos); UpdateCellIndex(); }
+        void Relocate(const Position* pos)
+            { Position::Relocate(pos); UpdateCellIndex(); }
+        // also called when the object size changes
+        void UpdateCellIndex()
+            { if (m_cellIndex) m_cellIndex->Update(m_cellIndexSlot, m_positionX, m_positionY, GetObjectSize()); }
+
         virtual void Update (uint32 /*time_diff*/) { }
 
         void _Create(uint32 guidlow, HighGuid guidhigh, uint32 phaseMask);
@@ -707,6 +723,8 @@ class WorldObject : public Object, public WorldLocation
         virtual void SendMessageToSet(WorldPacket* data, bool self);
         virtual void SendMessageToSetInRange(WorldPacket* data, float dist, bool self);
         virtual void SendMessageToSet(WorldPacket* data, Player const* skipped_rcvr);
+        // movement relay, heartbeats are thinned per receiver by distance (see MovementRelayFilter)
+        void SendMovementMessageToSet(WorldPacket* data, Player const* skipped_rcvr);
 
         virtual uint8 getLevelForTarget(WorldObject const* /*target*/) const { return 1; }
 
@@ -846,6 +864,9 @@ class WorldObject : public Object, public WorldLocation
         uint32 m_InstanceId;                                // in map copy with instance id
         uint32 m_phaseMask;                                 // in area phase state
 
+        CellPositionIndex* m_cellIndex;                     // units only, set while listed in a grid cell
+        uint32 m_cellIndexSlot;
+
         uint16 m_notifyflags;
         uint16 m_executed_notifies;
 
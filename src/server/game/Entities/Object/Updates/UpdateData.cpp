@@ -23,6 +23,7 @@
 #include "Log.h"
 #include "Opcodes.h"
 #include "World.h"
+#include "OpcodeStats.h"
 #include "zlib.h"
 
 UpdateData::UpdateData() : m_blockCount(0)
@@ -136,6 +137,7 @@ bool UpdateData::BuildPacket(WorldPacket* packet)
 
         packet->resize(destsize + sizeof(uint32));
         packet->SetOpcode(SMSG_COMPRESSED_UPDATE_OBJECT);
+        sOpcodeStats->RecordCompression(SMSG_COMPRESSED_UPDATE_OBJECT, pSize, destsize);
     }
     else                                                    // send small packets without compression
     {
@@ -278,6 +278,14 @@ uint32 PlayerTaxi::GetCurrentTaxiPath() const
     return path;
 }
 
+std::string PlayerTaxi::SaveTaximaskToString() const
+{
+    std::ostringstream ss;
+    for (uint8 i = 0; i < TaxiMaskSize; ++i)
+        ss << m_taximask[i] << ' ';
+    return ss.str();
+}
+
 std::ostringstream& operator<< (std::ostringstream& ss, PlayerTaxi const& taxi)
 {
     ss << '\'';
@@ -788,11 +796,16 @@ Player::Player (WorldSession* session): Unit(), m_achievementMgr(this), m_reputa
 
     m_activeSpec = 0;
     m_specsCount = 1;
+    m_savedGlyphSpecs = 0;
+    _instanceResetTimesChanged = false;
 
     for (uint8 i = 0; i < MAX_TALENT_SPECS; ++i)
     {
         for (uint8 g = 0; g < MAX_GLYPH_SLOT_INDEX; ++g)
+        {
             m_Glyphs[i][g] = 0;
+            m_savedGlyphs[i][g] = 0;
+        }
 
         m_talents[i] = new PlayerTalentMap();
     }
@@ -1723,11 +1736,8 @@ void Player::Update(uint32 p_time)
     if (m_nextSave > 0)
     {
         if (p_time >= m_nextSave)
-        {
-            // m_nextSave reseted in SaveToDB call
-            SaveToDB();
-            sLog->outDetail("Player '%s' (GUID: %u) saved", GetName(), GetGUIDLow());
-        }
+            // saved by the map within its per update budget, m_nextSave reseted in SaveToDB call
+            GetMap()->GetPlayerSaveScheduler().Enqueue(this, getMSTime());
         else
             m_nextSave -= p_time;
     }
@@ -1786,7 +1796,10 @@ void Player::Update(uint32 p_time)
         for (InstanceTimeMap::iterator itr = _instanceResetTimes.begin(); itr != _instanceResetTimes.end();)
         {
             if (itr->second < now)
+            {
                 _instanceResetTimes.erase(itr++);
+                _instanceResetTimesChanged = true;
+            }
             else
                 ++itr;
         }
@@ -8937,11 +8950,13 @@ void Player::SendLoot(uint64 guid, LootType loot_type)
             if (!recipient)
                 return;
 
+            creature->GenerateLoot(recipient);
+
             if (!creature->lootForBody)
             {
                 creature->lootForBody = true;
 
-                // for creature, loot is filled when creature is killed.
+                // for creature, loot is rolled on first use by GenerateLoot() above
 
                 if (Group* group = recipient->GetGroup())
                 {
@@ -15368,7 +15383,7 @@ bool Player::SatisfyQuestStatus(Quest const* qInfo, bool msg)
 
 bool Player::SatisfyQuestConditions(Quest const* qInfo, bool msg)
 {
-    ConditionList conditions = sConditionMgr->GetConditionsForNotGroupedEntry(CONDITION_SOURCE_TYPE_QUEST_ACCEPT, qInfo->GetQuestId());
+    ConditionList const& conditions = sConditionMgr->GetConditionsForNotGroupedEntry(CONDITION_SOURCE_TYPE_QUEST_ACCEPT, qInfo->GetQuestId());
     if (!sConditionMgr->IsPlayerMeetToConditions(this, conditions))
     {
         if (msg)
@@ -17183,8 +17198,9 @@ bool Player::isAllowedToLoot(const Creature* creature)
     if (HasPendingBind())
         return false;
 
+    // loot not rolled yet, the rights below are decided as if nothing was looted
     const Loot* loot = &creature->loot;
-    if (loot->isLooted()) // nothing to loot or everything looted.
+    if (!creature->IsLootPending() && loot->isLooted()) // nothing to loot or everything looted.
         return false;
 
     Group* thisGroup = GetGroup();
@@ -18344,6 +18360,91 @@ bool Player::_LoadHomeBind(PreparedQueryResult result)
 /***                   SAVE SYSTEM                     ***/
 /*********************************************************/
 
+namespace
+{
+    // rows of the tables that are inserted in CHAR_SAVE_BATCH_ROWS wide multi row statements on save
+    struct SpellSaveRow
+    {
+        SpellSaveRow(uint32 guid, uint32 spell, bool active, bool disabled) : guid(guid), spell(spell), active(active), disabled(disabled) {}
+        void Bind(PreparedStatement* stmt, uint8& index) const
+        {
+            stmt->setUInt32(index++, guid);
+            stmt->setUInt32(index++, spell);
+            stmt->setBool(index++, active);
+            stmt->setBool(index++, disabled);
+        }
+        uint32 guid, spell;
+        bool active, disabled;
+    };
+
+    struct TalentSaveRow
+    {
+        TalentSaveRow(uint32 guid, uint32 spell, uint8 spec) : guid(guid), spell(spell), spec(spec) {}
+        void Bind(PreparedStatement* stmt, uint8& index) const
+        {
+            stmt->setUInt32(index++, guid);
+            stmt->setUInt32(index++, spell);
+            stmt->setUInt8(index++, spec);
+        }
+        uint32 guid, spell;
+        uint8 spec;
+    };
+
+    struct SkillSaveRow
+    {
+        SkillSaveRow(uint32 guid, uint16 skill, uint16 value, uint16 max) : guid(guid), skill(skill), value(value), max(max) {}
+        void Bind(PreparedStatement* stmt, uint8& index) const
+        {
+            stmt->setUInt32(index++, guid);
+            stmt->setUInt16(index++, skill);
+            stmt->setUInt16(index++, value);
+            stmt->setUInt16(index++, max);
+        }
+        uint32 guid;
+        uint16 skill, value, max;
+    };
+
+    struct ActionSaveRow
+    {
+        ActionSaveRow(uint32 guid, uint8 spec, uint8 button, uint32 action, uint8 type) : guid(guid), spec(spec), button(button), action(action), type(type) {}
+        void Bind(PreparedStatement* stmt, uint8& index) const
+        {
+            stmt->setUInt32(index++, guid);
+            stmt->setUInt8(index++, spec);
+            stmt->setUInt8(index++, button);
+            stmt->setUInt32(index++, action);
+            stmt->setUInt8(index++, type);
+        }
+        uint32 guid;
+        uint8 spec, button;
+        uint32 action;
+        uint8 type;
+    };
+
+    // full batches go through the multi row statement, the remainder row by row
+    template<class Row>
+    void AppendInsertRows(SQLTransaction& trans, std::vector<Row> const& rows, CharacterDatabaseStatements single, CharacterDatabaseStatements batch)
+    {
+        size_t i = 0;
+        for (; i + CHAR_SAVE_BATCH_ROWS <= rows.size(); i += CHAR_SAVE_BATCH_ROWS)
+        {
+            PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(batch);
+            uint8 index = 0;
+            for (size_t j = i; j < i + CHAR_SAVE_BATCH_ROWS; ++j)
+                rows[j].Bind(stmt, index);
+            trans->Append(stmt);
+        }
+
+        for (; i < rows.size(); ++i)
+        {
+            PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(single);
+            uint8 index = 0;
+            rows[i].Bind(stmt, index);
+            trans->Append(stmt);
+        }
+    }
+}
+
 void Player::SaveToDB()
 {
     // delay auto save at any saves (manual, in code, or autosave)
@@ -18362,128 +18463,92 @@ void Player::SaveToDB()
     sLog->outDebug(LOG_FILTER_UNITS, "The value of player %s at save: ", m_name.c_str());
     outDebugValues();
 
-    std::string sql_name = m_name;
-    CharacterDatabase.EscapeString(sql_name);
-
-    std::ostringstream ss;
-    ss << "REPLACE INTO characters (guid, account, name, race, class, gender, level, xp, money, playerBytes, playerBytes2, playerFlags, "
-        "map, instance_id, instance_mode_mask, position_x, position_y, position_z, orientation, "
-        "taximask, online, cinematic, "
-        "totaltime, leveltime, rest_bonus, logout_time, is_logout_resting, resettalents_cost, resettalents_time, "
-        "trans_x, trans_y, trans_z, trans_o, transguid, extra_flags, stable_slots, at_login, zone, "
-        "death_expire_time, taxi_path, arenaPoints, totalHonorPoints, todayHonorPoints, yesterdayHonorPoints, totalKills, "
-        "todayKills, yesterdayKills, chosenTitle, knownCurrencies, watchedFaction, drunk, health, power1, power2, power3, "
-        "power4, power5, power6, power7, latency, speccount, activespec, exploredZones, equipmentCache, ammoId, knownTitles, actionBars, grantableLevels) VALUES ("
-        << GetGUIDLow() << ','
-        << GetSession()->GetAccountId() << ", '"
-        << sql_name << "', "
-        << uint32(getRace()) << ','
-        << uint32(getClass()) << ','
-        << uint32(getGender()) << ','
-        << uint32(getLevel()) << ','
-        << GetUInt32Value(PLAYER_XP) << ','
-        << GetMoney() << ','
-        << GetUInt32Value(PLAYER_BYTES) << ','
-        << GetUInt32Value(PLAYER_BYTES_2) << ','
-        << GetUInt32Value(PLAYER_FLAGS) << ',';
+    uint8 index = 0;
+    PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_REP_CHARACTER);
+    stmt->setUInt32(index++, GetGUIDLow());
+    stmt->setUInt32(index++, GetSession()->GetAccountId());
+    stmt->setString(index++, m_name);
+    stmt->setUInt8(index++, getRace());
+    stmt->setUInt8(index++, getClass());
+    stmt->setUInt8(index++, getGender());
+    stmt->setUInt8(index++, getLevel());
+    stmt->setUInt32(index++, GetUInt32Value(PLAYER_XP));
+    stmt->setUInt32(index++, GetMoney());
+    stmt->setUInt32(index++, GetUInt32Value(PLAYER_BYTES));
+    stmt->setUInt32(index++, GetUInt32Value(PLAYER_BYTES_2));
+    stmt->setUInt32(index++, GetUInt32Value(PLAYER_FLAGS));
 
     if (!IsBeingTeleported())
     {
-        ss << GetMapId() << ','
-        << (uint32)GetInstanceId() << ','
-        << uint32(uint8(GetDungeonDifficulty()) | uint8(GetRaidDifficulty()) << 4) << ','
-        << finiteAlways(GetPositionX()) << ','
-        << finiteAlways(GetPositionY()) << ','
-        << finiteAlways(GetPositionZ()) << ','
-        << finiteAlways(GetOrientation()) << ',';
+        stmt->setUInt16(index++, GetMapId());
+        stmt->setUInt32(index++, GetInstanceId());
+        stmt->setUInt8(index++, uint8(GetDungeonDifficulty()) | uint8(GetRaidDifficulty()) << 4);
+        stmt->setFloat(index++, finiteAlways(GetPositionX()));
+        stmt->setFloat(index++, finiteAlways(GetPositionY()));
+        stmt->setFloat(index++, finiteAlways(GetPositionZ()));
+        stmt->setFloat(index++, finiteAlways(GetOrientation()));
     }
     else
     {
-        ss << GetTeleportDest().GetMapId() << ','
-        << (uint32)0 << ','
-        << uint32(uint8(GetDungeonDifficulty()) | uint8(GetRaidDifficulty()) << 4) << ','
-        << finiteAlways(GetTeleportDest().GetPositionX()) << ','
-        << finiteAlways(GetTeleportDest().GetPositionY()) << ','
-        << finiteAlways(GetTeleportDest().GetPositionZ()) << ','
-        << finiteAlways(GetTeleportDest().GetOrientation()) << ',';
-    }
-
-    ss << m_taxi << ',';                                    // string with TaxiMaskSize numbers
-
-    ss << (IsInWorld() ? 1 : 0) << ',';
-
-    ss << uint32(m_cinematic) << ',';
-
-    ss << m_Played_time[PLAYED_TIME_TOTAL] << ',';
-    ss << m_Played_time[PLAYED_TIME_LEVEL] << ',';
-
-    ss << finiteAlways(m_rest_bonus) << ',';
-    ss << uint32(time(NULL)) << ',';
-    ss << (HasFlag(PLAYER_FLAGS, PLAYER_FLAGS_RESTING) ? 1 : 0) << ',';
+        stmt->setUInt16(index++, GetTeleportDest().GetMapId());
+        stmt->setUInt32(index++, 0);
+        stmt->setUInt8(index++, uint8(GetDungeonDifficulty()) | uint8(GetRaidDifficulty()) << 4);
+        stmt->setFloat(index++, finiteAlways(GetTeleportDest().GetPositionX()));
+        stmt->setFloat(index++, finiteAlways(GetTeleportDest().GetPositionY()));
+        stmt->setFloat(index++, finiteAlways(GetTeleportDest().GetPositionZ()));
+        stmt->setFloat(index++, finiteAlways(GetTeleportDest().GetOrientation()));
+    }
+
+    stmt->setString(index++, m_taxi.SaveTaximaskToString());  // string with TaxiMaskSize numbers
+    stmt->setUInt8(index++, IsInWorld() ? 1 : 0);
+    stmt->setUInt8(index++, m_cinematic);
+    stmt->setUInt32(index++, m_Played_time[PLAYED_TIME_TOTAL]);
+    stmt->setUInt32(index++, m_Played_time[PLAYED_TIME_LEVEL]);
+    stmt->setFloat(index++, finiteAlways(m_rest_bonus));
+    stmt->setUInt32(index++, uint32(time(NULL)));
+    stmt->setUInt8(index++, HasFlag(PLAYER_FLAGS, PLAYER_FLAGS_RESTING) ? 1 : 0);
                                                             //save, far from tavern/city
                                                             //save, but in tavern/city
-    ss << m_resetTalentsCost << ',';
-    ss << uint32(m_resetTalentsTime) << ',';
-
-    ss << finiteAlways(m_movementInfo.t_pos.GetPositionX()) << ',';
-    ss << finiteAlways(m_movementInfo.t_pos.GetPositionY()) << ',';
-    ss << finiteAlways(m_movementInfo.t_pos.GetPositionZ()) << ',';
-    ss << finiteAlways(m_movementInfo.t_pos.GetOrientation()) << ',';
-    if (m_transport)
-        ss << m_transport->GetGUIDLow();
-    else
-        ss << '0';
-    ss << ',';
-
-    ss << m_ExtraFlags << ',';
-
-    ss << uint32(m_stableSlots) << ',';                     // to prevent save uint8 as char
-
-    ss << uint32(m_atLoginFlags) << ',';
-
-    ss << GetZoneId() << ',';
-
-    ss << uint32(m_deathExpireTime) << ", '";
-
-    ss << m_taxi.SaveTaxiDestinationsToString() << "', ";
-
-    ss << GetArenaPoints() << ',';
-
-    ss << GetHonorPoints() << ',';
-
-    ss << GetUInt32Value(PLAYER_FIELD_TODAY_CONTRIBUTION) << ',';
-
-    ss << GetUInt32Value(PLAYER_FIELD_YESTERDAY_CONTRIBUTION) << ',';
-
-    ss << GetUInt32Value(PLAYER_FIELD_LIFETIME_HONORABLE_KILLS) << ',';
-
-    ss << GetUInt16Value(PLAYER_FIELD_KILLS, 0) << ',';
-
-    ss << GetUInt16Value(PLAYER_FIELD_KILLS, 1) << ',';
-
-    ss << GetUInt32Value(PLAYER_CHOSEN_TITLE) << ',';
-
-    ss << GetUInt64Value(PLAYER_FIELD_KNOWN_CURRENCIES) << ',';
-
-    ss << GetUInt32Value(PLAYER_FIELD_WATCHED_FACTION_INDEX) << ',';
+    stmt->setUInt32(index++, m_resetTalentsCost);
+    stmt->setUInt32(index++, uint32(m_resetTalentsTime));
+    stmt->setFloat(index++, finiteAlways(m_movementInfo.t_pos.GetPositionX()));
+    stmt->setFloat(index++, finiteAlways(m_movementInfo.t_pos.GetPositionY()));
+    stmt->setFloat(index++, finiteAlways(m_movementInfo.t_pos.GetPositionZ()));
+    stmt->setFloat(index++, finiteAlways(m_movementInfo.t_pos.GetOrientation()));
+    stmt->setUInt32(index++, m_transport ? m_transport->GetGUIDLow() : 0);
+    stmt->setUInt32(index++, m_ExtraFlags);
+    stmt->setUInt8(index++, m_stableSlots);
+    stmt->setUInt32(index++, m_atLoginFlags);
+    stmt->setUInt32(index++, GetZoneId());
+    stmt->setUInt32(index++, uint32(m_deathExpireTime));
+    stmt->setString(index++, m_taxi.SaveTaxiDestinationsToString());
+    stmt->setUInt32(index++, GetArenaPoints());
+    stmt->setUInt32(index++, GetHonorPoints());
+    stmt->setUInt32(index++, GetUInt32Value(PLAYER_FIELD_TODAY_CONTRIBUTION));
+    stmt->setUInt32(index++, GetUInt32Value(PLAYER_FIELD_YESTERDAY_CONTRIBUTION));
+    stmt->setUInt32(index++, GetUInt32Value(PLAYER_FIELD_LIFETIME_HONORABLE_KILLS));
+    stmt->setUInt16(index++, GetUInt16Value(PLAYER_FIELD_KILLS, 0));
+    stmt->setUInt16(index++, GetUInt16Value(PLAYER_FIELD_KILLS, 1));
+    stmt->setUInt32(index++, GetUInt32Value(PLAYER_CHOSEN_TITLE));
+    stmt->setUInt64(index++, GetUInt64Value(PLAYER_FIELD_KNOWN_CURRENCIES));
+    stmt->setUInt32(index++, GetUInt32Value(PLAYER_FIELD_WATCHED_FACTION_INDEX));
+    stmt->setUInt16(index++, uint16(GetUInt32Value(PLAYER_BYTES_3) & 0xFFFE));
+    stmt->setUInt32(index++, GetHealth());
 
-    ss << (uint16)(GetUInt32Value(PLAYER_BYTES_3) & 0xFFFE) << ',';
+    for (uint32 i = 0; i < MAX_POWERS; ++i)
+        stmt->setUInt32(index++, GetPower(Powers(i)));
 
-    ss << GetHealth();
+    stmt->setUInt32(index++, GetSession()->GetLatency());
+    stmt->setUInt8(index++, m_specsCount);
+    stmt->setUInt8(index++, m_activeSpec);
 
-    for (uint32 i = 0; i < MAX_POWERS; ++i)
-        ss << ',' << GetPower(Powers(i));
-    ss << ',';
-    ss << GetSession()->GetLatency();
-    ss << ',';
-    ss << uint32(m_specsCount);
-    ss << ',';
-    ss << uint32(m_activeSpec) << ", '";
+    std::ostringstream ss;
     for (uint32 i = 0; i < PLAYER_EXPLORED_ZONES_SIZE; ++i)
         ss << GetUInt32Value(PLAYER_EXPLORED_ZONES_1 + i) << ' ';
+    stmt->setString(index++, ss.str());
 
     // cache equipment...
-    ss << "', '";
+    ss.str("");
     for (uint32 i = 0; i < EQUIPMENT_SLOT_END * 2; ++i)
         ss << GetUInt32Value(PLAYER_VISIBLE_ITEM_1_ENTRYID + i) << ' ';
 
@@ -18496,22 +18561,21 @@ void Player::SaveToDB()
             ss << '0';
         ss << " 0 ";
     }
+    stmt->setString(index++, ss.str());
 
-    ss << "',";
+    stmt->setUInt32(index++, GetUInt32Value(PLAYER_AMMO_ID));
 
-    ss << GetUInt32Value(PLAYER_AMMO_ID) << ", '";
+    ss.str("");
     for (uint32 i = 0; i < KNOWN_TITLES_SIZE*2; ++i)
         ss << GetUInt32Value(PLAYER__FIELD_KNOWN_TITLES + i) << ' ';
+    stmt->setString(index++, ss.str());
 
-    ss << "',";
-    ss << uint32(GetByteValue(PLAYER_FIELD_BYTES, 2));
-    ss << ",";
-    ss << uint32(m_grantableLevels);
-    ss << ')';
+    stmt->setUInt8(index++, GetByteValue(PLAYER_FIELD_BYTES, 2));
+    stmt->setUInt32(index++, m_grantableLevels);
 
     SQLTransaction trans = CharacterDatabase.BeginTransaction();
 
-    trans->Append(ss.str().c_str());
+    trans->Append(stmt);
 
     if (m_mailsUpdated)                                     //save mails only when needed
         _SaveMail(trans);
@@ -18539,6 +18603,9 @@ void Player::SaveToDB()
     if (m_session->isLogingOut() || !sWorld->getBoolConfig(CONFIG_STATS_SAVE_ONLY_ON_LOGOUT))
         _SaveStats(trans);
 
+    sLog->outDebug(LOG_FILTER_UNITS, "Player::SaveToDB: %s (GUID: %u) saved with %u prepared and %u ad-hoc statements (%u ad-hoc query bytes)",
+        m_name.c_str(), GetGUIDLow(), trans->GetPreparedCount(), trans->GetRawCount(), trans->GetRawBytes());
+
     CharacterDatabase.CommitTransaction(trans);
 
     // we save the data here to prevent spamming
@@ -18561,29 +18628,43 @@ void Player::SaveInventoryAndGoldToDB(SQLTransaction& trans)
 
 void Player::SaveGoldToDB(SQLTransaction& trans)
 {
-    trans->PAppend("UPDATE characters SET money = '%u' WHERE guid = '%u'", GetMoney(), GetGUIDLow());
+    PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_SET_CHAR_MONEY);
+    stmt->setUInt32(0, GetMoney());
+    stmt->setUInt32(1, GetGUIDLow());
+    trans->Append(stmt);
 }
 
 void Player::_SaveActions(SQLTransaction& trans)
 {
+    std::vector<ActionSaveRow> inserts;
+    PreparedStatement* stmt = NULL;
+
     for (ActionButtonList::iterator itr = m_actionButtons.begin(); itr != m_actionButtons.end();)
     {
         switch (itr->second.uState)
         {
             case ACTIONBUTTON_NEW:
-                trans->PAppend("INSERT INTO character_action (guid, spec, button, action, type) VALUES ('%u', '%u', '%u', '%u', '%u')",
-                    GetGUIDLow(), m_activeSpec, (uint32)itr->first, (uint32)itr->second.GetAction(), (uint32)itr->second.GetType());
+                inserts.push_back(ActionSaveRow(GetGUIDLow(), m_activeSpec, itr->first, itr->second.GetAction(), itr->second.GetType()));
                 itr->second.uState = ACTIONBUTTON_UNCHANGED;
                 ++itr;
                 break;
             case ACTIONBUTTON_CHANGED:
-                trans->PAppend("UPDATE character_action SET action = '%u', type = '%u' WHERE guid = '%u' AND button = '%u' AND spec = '%u'",
-                    (uint32)itr->second.GetAction(), (uint32)itr->second.GetType(), GetGUIDLow(), (uint32)itr->first, m_activeSpec);
+                stmt = CharacterDatabase.GetPreparedStatement(CHAR_SET_CHAR_ACTION);
+                stmt->setUInt32(0, itr->second.GetAction());
+                stmt->setUInt8(1, uint8(itr->second.GetType()));
+                stmt->setUInt32(2, GetGUIDLow());
+                stmt->setUInt8(3, itr->first);
+                stmt->setUInt8(4, m_activeSpec);
+                trans->Append(stmt);
                 itr->second.uState = ACTIONBUTTON_UNCHANGED;
                 ++itr;
                 break;
             case ACTIONBUTTON_DELETED:
-                trans->PAppend("DELETE FROM character_action WHERE guid = '%u' and button = '%u' and spec = '%u'", GetGUIDLow(), (uint32)itr->first, m_activeSpec);
+                stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_CHAR_ACTION);
+                stmt->setUInt32(0, GetGUIDLow());
+                stmt->setUInt8(1, itr->first);
+                stmt->setUInt8(2, m_activeSpec);
+                trans->Append(stmt);
                 m_actionButtons.erase(itr++);
                 break;
             default:
@@ -18591,6 +18672,8 @@ void Player::_SaveActions(SQLTransaction& trans)
                 break;
         }
     }
+
+    AppendInsertRows(trans, inserts, CHAR_ADD_CHAR_ACTION, CHAR_ADD_CHAR_ACTION_BATCH);
 }
 
 void Player::_SaveAuras(SQLTransaction& trans)
@@ -18658,8 +18741,10 @@ void Player::_SaveInventory(SQLTransaction& trans)
         Item* item = m_items[i];
         if (!item || item->GetState() == ITEM_NEW)
             continue;
-        trans->PAppend("DELETE FROM character_inventory WHERE item = '%u'", item->GetGUIDLow());
-        PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_ITEM_INSTANCE);
+        PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_INVENTORY_ITEM);
+        stmt->setUInt32(0, item->GetGUIDLow());
+        trans->Append(stmt);
+        stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_ITEM_INSTANCE);
         stmt->setUInt32(0, item->GetGUIDLow());
         trans->Append(stmt);
         m_items[i]->FSetState(ITEM_NEW);
@@ -18717,7 +18802,11 @@ void Player::_SaveInventory(SQLTransaction& trans)
                     bagTestGUID = test2->GetGUIDLow();
                 sLog->outError("Player(GUID: %u Name: %s)::_SaveInventory - the bag(%u) and slot(%u) values for the item with guid %u (state %d) are incorrect, the player doesn't have an item at that position!", lowGuid, GetName(), item->GetBagSlot(), item->GetSlot(), item->GetGUIDLow(), (int32)item->GetState());
                 // according to the test that was just performed nothing should be in this slot, delete
-                trans->PAppend("DELETE FROM character_inventory WHERE bag=%u AND slot=%u AND guid=%u", bagTestGUID, item->GetSlot(), lowGuid);
+                PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_INVENTORY_BY_BAG_SLOT);
+                stmt->setUInt32(0, bagTestGUID);
+                stmt->setUInt8(1, item->GetSlot());
+                stmt->setUInt32(2, lowGuid);
+                trans->Append(stmt);
                 // also THIS item should be somewhere else, cheat attempt
                 item->FSetState(ITEM_REMOVED); // we are IN updateQueue right now, can't use SetState which modifies the queue
                 DeleteRefundReference(item->GetGUIDLow());
@@ -18822,6 +18911,7 @@ void Player::_SaveQuestStatus(SQLTransaction& trans)
 
     QuestStatusSaveMap::iterator saveItr;
     QuestStatusMap::iterator statusItr;
+    PreparedStatement* stmt = NULL;
 
     bool keepAbandoned = !(sWorld->GetCleaningFlags() & CharacterDatabaseCleaner::CLEANING_FLAG_QUESTSTATUS);
 
@@ -18831,12 +18921,30 @@ void Player::_SaveQuestStatus(SQLTransaction& trans)
         {
             statusItr = m_QuestStatus.find(saveItr->first);
             if (statusItr != m_QuestStatus.end() && (keepAbandoned || statusItr->second.m_status != QUEST_STATUS_NONE))
-                trans->PAppend("REPLACE INTO character_queststatus (guid, quest, status, explored, timer, mobcount1, mobcount2, mobcount3, mobcount4, itemcount1, itemcount2, itemcount3, itemcount4, playercount) "
-                    "VALUES ('%u', '%u', '%u', '%u', '" UI64FMTD "', '%u', '%u', '%u', '%u', '%u', '%u', '%u', '%u', '%u')",
-                    GetGUIDLow(), statusItr->first, statusItr->second.m_status, statusItr->second.m_explored, uint64(statusItr->second.m_timer / IN_MILLISECONDS+ sWorld->GetGameTime()), statusItr->second.m_creatureOrGOcount[0], statusItr->second.m_creatureOrGOcount[1], statusItr->second.m_creatureOrGOcount[2], statusItr->second.m_creatureOrGOcount[3], statusItr->second.m_itemcount[0], statusItr->second.m_itemcount[1], statusItr->second.m_itemcount[2], statusItr->second.m_itemcount[3], statusItr->second.m_playercount);
+            {
+                QuestStatusData const& status = statusItr->second;
+                uint8 index = 0;
+                stmt = CharacterDatabase.GetPreparedStatement(CHAR_REP_CHAR_QUESTSTATUS);
+                stmt->setUInt32(index++, GetGUIDLow());
+                stmt->setUInt32(index++, statusItr->first);
+                stmt->setUInt8(index++, uint8(status.m_status));
+                stmt->setBool(index++, status.m_explored);
+                stmt->setUInt64(index++, uint64(status.m_timer / IN_MILLISECONDS + sWorld->GetGameTime()));
+                for (uint8 i = 0; i < QUEST_OBJECTIVES_COUNT; ++i)
+                    stmt->setUInt16(index++, status.m_creatureOrGOcount[i]);
+                for (uint8 i = 0; i < 4; ++i)                       // only itemcount1..4 are stored
+                    stmt->setUInt16(index++, status.m_itemcount[i]);
+                stmt->setUInt16(index, status.m_playercount);
+                trans->Append(stmt);
+            }
         }
         else
-            trans->PAppend("DELETE FROM character_queststatus WHERE guid = %u AND quest = %u", GetGUIDLow(), saveItr->first);
+        {
+            stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_CHAR_QUESTSTATUS);
+            stmt->setUInt32(0, GetGUIDLow());
+            stmt->setUInt32(1, saveItr->first);
+            trans->Append(stmt);
+        }
     }
 
     m_QuestStatusSave.clear();
@@ -18844,9 +18952,15 @@ void Player::_SaveQuestStatus(SQLTransaction& trans)
     for (saveItr = m_RewardedQuestsSave.begin(); saveItr != m_RewardedQuestsSave.end(); ++saveItr)
     {
         if (saveItr->second)
-            trans->PAppend("INSERT IGNORE INTO character_queststatus_rewarded (guid, quest) VALUES (%u, %u)", GetGUIDLow(), saveItr->first);
+            stmt = CharacterDatabase.GetPreparedStatement(CHAR_ADD_CHAR_QUESTSTATUS_REWARDED);
         else if (!keepAbandoned)
-            trans->PAppend("DELETE FROM character_queststatus_rewarded WHERE guid = %u AND quest = %u", GetGUIDLow(), saveItr->first);
+            stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_CHAR_QUESTSTATUS_REWARDED);
+        else
+            continue;
+
+        stmt->setUInt32(0, GetGUIDLow());
+        stmt->setUInt32(1, saveItr->first);
+        trans->Append(stmt);
     }
 
     m_RewardedQuestsSave.clear();
@@ -18865,20 +18979,30 @@ void Player::_SaveDailyQuestStatus(SQLTransaction& trans)
     // save last daily quest time for all quests: we need only mostly reset time for reset check anyway
 
     // we don't need transactions here.
-    trans->PAppend("DELETE FROM character_queststatus_daily WHERE guid = '%u'", GetGUIDLow());
-    for (uint32 quest_daily_idx = 0; quest_daily_idx < PLAYER_MAX_DAILY_QUESTS; ++quest_daily_idx)
-        if (GetUInt32Value(PLAYER_FIELD_DAILY_QUESTS_1+quest_daily_idx))
-            trans->PAppend("INSERT INTO character_queststatus_daily (guid, quest, time) VALUES ('%u', '%u', '" UI64FMTD "')",
-                GetGUIDLow(), GetUInt32Value(PLAYER_FIELD_DAILY_QUESTS_1+quest_daily_idx), uint64(m_lastDailyQuestTime));
+    PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_CHAR_QUESTSTATUS_DAILY);
+    stmt->setUInt32(0, GetGUIDLow());
+    trans->Append(stmt);
 
-    if (!m_DFQuests.empty())
+    for (uint32 quest_daily_idx = 0; quest_daily_idx < PLAYER_MAX_DAILY_QUESTS; ++quest_daily_idx)
     {
-        for (DFQuestsDoneList::iterator itr = m_DFQuests.begin(); itr != m_DFQuests.end(); ++itr)
+        if (GetUInt32Value(PLAYER_FIELD_DAILY_QUESTS_1+quest_daily_idx))
         {
-            trans->PAppend("INSERT INTO character_queststatus_daily (guid, quest, time) VALUES ('%u', '%u', '" UI64FMTD "')",
-            GetGUIDLow(), (*itr), uint64(m_lastDailyQuestTime));
+            stmt = CharacterDatabase.GetPreparedStatement(CHAR_ADD_CHAR_QUESTSTATUS_DAILY);
+            stmt->setUInt32(0, GetGUIDLow());
+            stmt->setUInt32(1, GetUInt32Value(PLAYER_FIELD_DAILY_QUESTS_1+quest_daily_idx));
+            stmt->setUInt64(2, uint64(m_lastDailyQuestTime));
+            trans->Append(stmt);
         }
     }
+
+    for (DFQuestsDoneList::iterator itr = m_DFQuests.begin(); itr != m_DFQuests.end(); ++itr)
+    {
+        stmt = CharacterDatabase.GetPreparedStatement(CHAR_ADD_CHAR_QUESTSTATUS_DAILY);
+        stmt->setUInt32(0, GetGUIDLow());
+        stmt->setUInt32(1, *itr);
+        stmt->setUInt64(2, uint64(m_lastDailyQuestTime));
+        trans->Append(stmt);
+    }
 }
 
 void Player::_SaveWeeklyQuestStatus(SQLTransaction& trans)
@@ -18887,13 +19011,16 @@ void Player::_SaveWeeklyQuestStatus(SQLTransaction& trans)
         return;
 
     // we don't need transactions here.
-    trans->PAppend("DELETE FROM character_queststatus_weekly WHERE guid = '%u'", GetGUIDLow());
+    PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_CHAR_QUESTSTATUS_WEEKLY);
+    stmt->setUInt32(0, GetGUIDLow());
+    trans->Append(stmt);
 
     for (QuestSet::const_iterator iter = m_weeklyquests.begin(); iter != m_weeklyquests.end(); ++iter)
     {
-        uint32 quest_id  = *iter;
-
-        trans->PAppend("INSERT INTO character_queststatus_weekly (guid, quest) VALUES ('%u', '%u')", GetGUIDLow(), quest_id);
+        stmt = CharacterDatabase.GetPreparedStatement(CHAR_ADD_CHAR_QUESTSTATUS_WEEKLY);
+        stmt->setUInt32(0, GetGUIDLow());
+        stmt->setUInt32(1, *iter);
+        trans->Append(stmt);
     }
 
     m_WeeklyQuestChanged = false;
@@ -18901,6 +19028,9 @@ void Player::_SaveWeeklyQuestStatus(SQLTransaction& trans)
 
 void Player::_SaveSkills(SQLTransaction& trans)
 {
+    std::vector<SkillSaveRow> inserts;
+    PreparedStatement* stmt = NULL;
+
     // we don't need transactions here.
     for (SkillStatusMap::iterator itr = mSkillStatus.begin(); itr != mSkillStatus.end();)
     {
@@ -18912,7 +19042,10 @@ void Player::_SaveSkills(SQLTransaction& trans)
 
         if (itr->second.uState == SKILL_DELETED)
         {
-            trans->PAppend("DELETE FROM character_skills WHERE guid = '%u' AND skill = '%u' ", GetGUIDLow(), itr->first);
+            stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_CHAR_SKILL);
+            stmt->setUInt32(0, GetGUIDLow());
+            stmt->setUInt16(1, uint16(itr->first));
+            trans->Append(stmt);
             mSkillStatus.erase(itr++);
             continue;
         }
@@ -18924,12 +19057,15 @@ void Player::_SaveSkills(SQLTransaction& trans)
         switch (itr->second.uState)
         {
             case SKILL_NEW:
-                trans->PAppend("INSERT INTO character_skills (guid, skill, value, max) VALUES ('%u', '%u', '%u', '%u')",
-                    GetGUIDLow(), itr->first, value, max);
+                inserts.push_back(SkillSaveRow(GetGUIDLow(), uint16(itr->first), value, max));
                 break;
             case SKILL_CHANGED:
-                trans->PAppend("UPDATE character_skills SET value = '%u', max = '%u'WHERE guid = '%u' AND skill = '%u' ",
-                    value, max, GetGUIDLow(), itr->first);
+                stmt = CharacterDatabase.GetPreparedStatement(CHAR_SET_CHAR_SKILL);
+                stmt->setUInt16(0, value);
+                stmt->setUInt16(1, max);
+                stmt->setUInt32(2, GetGUIDLow());
+                stmt->setUInt16(3, uint16(itr->first));
+                trans->Append(stmt);
                 break;
             default:
                 break;
@@ -18938,18 +19074,27 @@ void Player::_SaveSkills(SQLTransaction& trans)
 
         ++itr;
     }
+
+    AppendInsertRows(trans, inserts, CHAR_ADD_CHAR_SKILL, CHAR_ADD_CHAR_SKILL_BATCH);
 }
 
 void Player::_SaveSpells(SQLTransaction& trans)
 {
-    for (PlayerSpellMap::iterator itr = m_spells.begin(), next = m_spells.begin(); itr != m_spells.end();)
+    std::vector<SpellSaveRow> inserts;
+
+    for (PlayerSpellMap::iterator itr = m_spells.begin(); itr != m_spells.end();)
     {
         if (itr->second->state == PLAYERSPELL_REMOVED || itr->second->state == PLAYERSPELL_CHANGED)
-            trans->PAppend("DELETE FROM character_spell WHERE guid = '%u' and spell = '%u'", GetGUIDLow(), itr->first);
+        {
+            PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_CHAR_SPELL);
+            stmt->setUInt32(0, GetGUIDLow());
+            stmt->setUInt32(1, itr->first);
+            trans->Append(stmt);
+        }
 
-        // add only changed/new not dependent spells
+        // add only changed/new not dependent spells, the deletes above always precede them
         if (!itr->second->dependent && (itr->second->state == PLAYERSPELL_NEW || itr->second->state == PLAYERSPELL_CHANGED))
-            trans->PAppend("INSERT INTO character_spell (guid, spell, active, disabled) VALUES ('%u', '%u', '%u', '%u')", GetGUIDLow(), itr->first, itr->second->active ? 1 : 0, itr->second->disabled ? 1 : 0);
+            inserts.push_back(SpellSaveRow(GetGUIDLow(), itr->first, itr->second->active, itr->second->disabled));
 
         if (itr->second->state == PLAYERSPELL_REMOVED)
         {
@@ -18962,6 +19107,8 @@ void Player::_SaveSpells(SQLTransaction& trans)
             ++itr;
         }
     }
+
+    AppendInsertRows(trans, inserts, CHAR_ADD_CHAR_SPELL, CHAR_ADD_CHAR_SPELL_BATCH);
 }
 
 // save player stats -- only for external usage
@@ -19633,7 +19780,7 @@ void Player::VehicleSpellInitialize()
             continue;
         }
 
-        ConditionList conditions = sConditionMgr->GetConditionsForVehicleSpell(veh->GetEntry(), spellId);
+        ConditionList const& conditions = sConditionMgr->GetConditionsForVehicleSpell(veh->GetEntry(), spellId);
         if (!sConditionMgr->IsPlayerMeetToConditions(this, conditions))
         {
             sLog->outDebug(LOG_FILTER_CONDITIONSYS, "VehicleSpellInitialize: conditions not met for Vehicle entry %u spell %u", veh->ToCreature()->GetEntry(), spellId);
@@ -21230,6 +21377,8 @@ inline void UpdateVisibilityOf_helper(std::set<uint64>& s64, Creature* target, s
 {
     s64.insert(target->GetGUID());
     v.insert(target);
+    // a player came into range, let the AI react at full update rate
+    target->WakeUp();
 }
 
 template<>
@@ -24214,6 +24363,11 @@ void Player::_SaveEquipmentSets(SQLTransaction& trans)
 
 void Player::_SaveBGData(SQLTransaction& trans)
 {
+    if (m_savedBGData.Matches(m_bgData))
+        return;
+
+    m_savedBGData.Store(m_bgData);
+
     PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_PLAYER_BGDATA);
     stmt->setUInt32(0, GetGUIDLow());
     trans->Append(stmt);
@@ -24308,11 +24462,24 @@ void Player::_LoadGlyphs(PreparedQueryResult result)
 
 void Player::_SaveGlyphs(SQLTransaction& trans)
 {
-    trans->PAppend("DELETE FROM character_glyphs WHERE guid='%u'", GetGUIDLow());
+    if (m_savedGlyphSpecs == m_specsCount && !memcmp(m_savedGlyphs, m_Glyphs, sizeof(m_Glyphs)))
+        return;
+
+    memcpy(m_savedGlyphs, m_Glyphs, sizeof(m_Glyphs));
+    m_savedGlyphSpecs = m_specsCount;
+
+    PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_CHAR_GLYPHS);
+    stmt->setUInt32(0, GetGUIDLow());
+    trans->Append(stmt);
+
     for (uint8 spec = 0; spec < m_specsCount; ++spec)
     {
-        trans->PAppend("INSERT INTO character_glyphs VALUES('%u', '%u', '%u', '%u', '%u', '%u', '%u', '%u')",
-            GetGUIDLow(), spec, m_Glyphs[spec][0], m_Glyphs[spec][1], m_Glyphs[spec][2], m_Glyphs[spec][3], m_Glyphs[spec][4], m_Glyphs[spec][5]);
+        stmt = CharacterDatabase.GetPreparedStatement(CHAR_ADD_CHAR_GLYPHS);
+        stmt->setUInt32(0, GetGUIDLow());
+        stmt->setUInt8(1, spec);
+        for (uint8 i = 0; i < MAX_GLYPH_SLOT_INDEX; ++i)
+            stmt->setUInt16(2 + i, uint16(m_Glyphs[spec][i]));
+        trans->Append(stmt);
     }
 }
 
@@ -24329,15 +24496,23 @@ void Player::_LoadTalents(PreparedQueryResult result)
 
 void Player::_SaveTalents(SQLTransaction& trans)
 {
+    std::vector<TalentSaveRow> inserts;
+
     for (uint8 i = 0; i < MAX_TALENT_SPECS; ++i)
     {
         for (PlayerTalentMap::iterator itr = m_talents[i]->begin(); itr != m_talents[i]->end();)
         {
             if (itr->second->state == PLAYERSPELL_REMOVED || itr->second->state == PLAYERSPELL_CHANGED)
-                trans->PAppend("DELETE FROM character_talent WHERE guid = '%u' and spell = '%u' and spec = '%u'", GetGUIDLow(), itr->first, itr->second->spec);
+            {
+                PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_CHAR_TALENT);
+                stmt->setUInt32(0, GetGUIDLow());
+                stmt->setUInt32(1, itr->first);
+                stmt->setUInt8(2, itr->second->spec);
+                trans->Append(stmt);
+            }
 
             if (itr->second->state == PLAYERSPELL_NEW || itr->second->state == PLAYERSPELL_CHANGED)
-                trans->PAppend("INSERT INTO character_talent (guid, spell, spec) VALUES ('%u', '%u', '%u')", GetGUIDLow(), itr->first, itr->second->spec);
+                inserts.push_back(TalentSaveRow(GetGUIDLow(), itr->first, itr->second->spec));
 
             if (itr->second->state == PLAYERSPELL_REMOVED)
             {
@@ -24351,6 +24526,8 @@ void Player::_SaveTalents(SQLTransaction& trans)
             }
         }
     }
+
+    AppendInsertRows(trans, inserts, CHAR_ADD_CHAR_TALENT, CHAR_ADD_CHAR_TALENT_BATCH);
 }
 
 void Player::UpdateSpecCount(uint8 count)
@@ -24810,9 +24987,11 @@ void Player::_LoadInstanceTimeRestrictions(PreparedQueryResult result)
 
 void Player::_SaveInstanceTimeRestrictions(SQLTransaction& trans)
 {
-    if (_instanceResetTimes.empty())
+    if (!_instanceResetTimesChanged)
         return;
 
+    _instanceResetTimesChanged = false;
+
     PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_ACCOUNT_INSTANCE_LOCK_TIMES);
     stmt->setUInt32(0, GetSession()->GetAccountId());
     trans->Append(stmt);
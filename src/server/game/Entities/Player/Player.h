@@ -29,6 +29,7 @@
 #include "ItemPrototype.h"
 #include "Item.h"
 #include "MapReference.h"
+#include "MovementRelayFilter.h"
 #include "NPCHandler.h"
 #include "Pet.h"
 #include "QuestDef.h"
@@ -927,6 +928,7 @@ class PlayerTaxi
                 return false;
         }
         void AppendTaximaskTo(ByteBuffer& data, bool all);
+        std::string SaveTaximaskToString() const;
 
         // Destinations
         bool LoadTaxiDestinationsFromString(const std::string& values, uint32 team);
@@ -979,6 +981,43 @@ struct BGData
     bool HasTaxiPath() const { return taxiPath[0] && taxiPath[1]; }
 };
 
+// Columns of character_battleground_data as last written by Player::_SaveBGData
+struct BGSaveData
+{
+    BGSaveData() : saved(false), bgInstanceID(0), bgTeam(0), mountSpell(0), mapId(0), x(0.0f), y(0.0f), z(0.0f), o(0.0f)
+    {
+        taxiPath[0] = taxiPath[1] = 0;
+    }
+
+    bool Matches(BGData const& data) const
+    {
+        return saved && bgInstanceID == data.bgInstanceID && bgTeam == data.bgTeam && mountSpell == data.mountSpell &&
+            taxiPath[0] == data.taxiPath[0] && taxiPath[1] == data.taxiPath[1] && mapId == data.joinPos.GetMapId() &&
+            x == data.joinPos.GetPositionX() && y == data.joinPos.GetPositionY() && z == data.joinPos.GetPositionZ() &&
+            o == data.joinPos.GetOrientation();
+    }
+
+    void Store(BGData const& data)
+    {
+        saved = true;
+        bgInstanceID = data.bgInstanceID;
+        bgTeam = data.bgTeam;
+        mountSpell = data.mountSpell;
+        taxiPath[0] = data.taxiPath[0];
+        taxiPath[1] = data.taxiPath[1];
+        mapId = data.joinPos.GetMapId();
+        data.joinPos.GetPosition(x, y, z, o);
+    }
+
+    bool saved;
+    uint32 bgInstanceID;
+    uint32 bgTeam;
+    uint32 mountSpell;
+    uint32 taxiPath[2];
+    uint32 mapId;
+    float x, y, z, o;
+};
+
 class TradeData
 {
     public:                                                 // constructors
@@ -2293,6 +2332,7 @@ class Player : public Unit, public GridObject<Player>
             m_mover->m_movedPlayer = this;
         }
         void SetSeer(WorldObject* target) { m_seer = target; }
+        MovementRelayFilter& GetMovementRelayFilter() { return m_movementRelayFilter; }
         void SetViewpoint(WorldObject* target, bool apply);
         WorldObject* GetViewpoint() const;
         void StopCastingCharm();
@@ -2300,6 +2340,11 @@ class Player : public Unit, public GridObject<Player>
 
         uint32 GetSaveTimer() const { return m_nextSave; }
         void   SetSaveTimer(uint32 timer) { m_nextSave = timer; }
+        // rough amount of unsaved data, used to order queued autosaves
+        uint32 GetPendingSaveChangeCount() const
+        {
+            return uint32(m_itemUpdateQueue.size() + m_QuestStatusSave.size() + m_RewardedQuestsSave.size()) + (m_mailsUpdated ? 1 : 0);
+        }
 
         // Recall position
         uint32 m_recallMap;
@@ -2398,7 +2443,10 @@ class Player : public Unit, public GridObject<Player>
         void AddInstanceEnterTime(uint32 instanceId, time_t enterTime)
         {
             if (_instanceResetTimes.find(instanceId) == _instanceResetTimes.end())
+            {
                 _instanceResetTimes.insert(InstanceTimeMap::value_type(instanceId, enterTime + HOUR));
+                _instanceResetTimesChanged = true;
+            }
         }
 
         // last used pet number (for BG's)
@@ -2507,6 +2555,7 @@ class Player : public Unit, public GridObject<Player>
 
         BgBattlegroundQueueID_Rec m_bgBattlegroundQueueID[PLAYER_MAX_BATTLEGROUND_QUEUES];
         BGData                    m_bgData;
+        BGSaveData                m_savedBGData;
 
         bool m_IsBGRandomWinner;
 
@@ -2636,6 +2685,8 @@ class Player : public Unit, public GridObject<Player>
         uint8 m_specsCount;
 
         uint32 m_Glyphs[MAX_TALENT_SPECS][MAX_GLYPH_SLOT_INDEX];
+        uint32 m_savedGlyphs[MAX_TALENT_SPECS][MAX_GLYPH_SLOT_INDEX];
+        uint8 m_savedGlyphSpecs;                            // specs written by the last _SaveGlyphs, 0 if none yet
 
         ActionButtonList m_actionButtons;
 
@@ -2778,6 +2829,8 @@ class Player : public Unit, public GridObject<Player>
         uint32 m_lastFallTime;
         float  m_lastFallZ;
 
+        MovementRelayFilter m_movementRelayFilter;
+
         int32 m_MirrorTimer[MAX_TIMERS];
         uint8 m_MirrorTimerFlags;
         uint8 m_MirrorTimerFlagsLast;
@@ -2810,6 +2863,7 @@ class Player : public Unit, public GridObject<Player>
         uint32 m_timeSyncServer;
 
         InstanceTimeMap _instanceResetTimes;
+        bool _instanceResetTimesChanged;
         uint32 _pendingBindId;
         uint32 _pendingBindTimer;
 };
@@ -100,6 +100,7 @@ void MapManager::LoadTransports()
         //If we someday decide to use the grid to track transports, here:
         t->SetMap(sMapMgr->CreateMap(mapid, t, 0));
         t->AddToWorld();
+        t->GetMap()->AddTransport(t);
 
         ++count;
     }
@@ -171,7 +172,7 @@ void MapManager::LoadTransportNPCs()
 }
 
 Transport::Transport(uint32 period, uint32 script) : GameObject(), m_pathTime(0), m_timer(0),
-currenttguid(0), m_period(period), ScriptId(script), m_nextNodeTime(0)
+currenttguid(0), m_period(period), ScriptId(script), m_teleportPending(false), m_nextNodeTime(0)
 {
     m_updateFlag = (UPDATEFLAG_TRANSPORT | UPDATEFLAG_HIGHGUID | UPDATEFLAG_HAS_POSITION | UPDATEFLAG_ROTATION);
 }
@@ -484,7 +485,7 @@ Transport::WayPointMap::const_iterator Transport::GetNextWayPoint()
 
 void Transport::TeleportTransport(uint32 newMapid, float x, float y, float z)
 {
-    Map const* oldMap = GetMap();
+    Map* oldMap = GetMap();
     Relocate(x, y, z);
 
     for (PlayerSet::const_iterator itr = m_passengers.begin(); itr != m_passengers.end();)
@@ -501,12 +502,14 @@ void Transport::TeleportTransport(uint32 newMapid, float x, float y, float z)
     //we need to create and save new Map object with 'newMapid' because if not done -> lead to invalid Map object reference...
     //player far teleport would try to create same instance, but we need it NOW for transport...
 
+    oldMap->RemoveTransport(this);
     RemoveFromWorld();
     ResetMap();
     Map* newMap = sMapMgr->CreateMap(newMapid, this, 0);
     SetMap(newMap);
     ASSERT (GetMap());
     AddToWorld();
+    newMap->AddTransport(this);
 
     if (oldMap != newMap)
     {
@@ -545,7 +548,8 @@ void Transport::Update(uint32 p_diff)
     } else
         AI()->UpdateAI(p_diff);
 
-    if (m_WayPoints.size() <= 1)
+    // waiting at a map boundary until MapManager moves us
+    if (m_WayPoints.size() <= 1 || m_teleportPending)
         return;
 
     m_timer = getMSTime() % m_period;
@@ -561,27 +565,42 @@ void Transport::Update(uint32 p_diff)
         // first check help in case client-server transport coordinates de-synchronization
         if (m_curr->second.mapid != GetMapId() || m_curr->second.teleport)
         {
-            TeleportTransport(m_curr->second.mapid, m_curr->second.x, m_curr->second.y, m_curr->second.z);
+            // this runs inside our map's update, teleporting touches other maps so it has to wait
+            m_teleportPending = true;
+            break;
         }
-        else
-        {
-            Relocate(m_curr->second.x, m_curr->second.y, m_curr->second.z, GetAngle(m_next->second.x, m_next->second.y) + float(M_PI));
-            UpdateNPCPositions(); // COME BACK MARKER
-        }
-
-        sScriptMgr->OnRelocate(this, m_curr->first, m_curr->second.mapid, m_curr->second.x, m_curr->second.y, m_curr->second.z);
-
-        m_nextNodeTime = m_curr->first;
 
-        if (m_curr == m_WayPoints.begin())
-            sLog->outDebug(LOG_FILTER_TRANSPORTS, " ************ BEGIN ************** %s", m_name.c_str());
+        Relocate(m_curr->second.x, m_curr->second.y, m_curr->second.z, GetAngle(m_next->second.x, m_next->second.y) + float(M_PI));
+        UpdateNPCPositions(); // COME BACK MARKER
 
-        sLog->outDebug(LOG_FILTER_TRANSPORTS, "%s moved to %d %f %f %f %d", m_name.c_str(), m_curr->second.id, m_curr->second.x, m_curr->second.y, m_curr->second.z, m_curr->second.mapid);
+        NodeReached();
     }
 
     sScriptMgr->OnTransportUpdate(this, p_diff);
 }
 
+void Transport::DoPendingTeleport()
+{
+    if (!m_teleportPending)
+        return;
+
+    m_teleportPending = false;
+    TeleportTransport(m_curr->second.mapid, m_curr->second.x, m_curr->second.y, m_curr->second.z);
+    NodeReached();
+}
+
+void Transport::NodeReached()
+{
+    sScriptMgr->OnRelocate(this, m_curr->first, m_curr->second.mapid, m_curr->second.x, m_curr->second.y, m_curr->second.z);
+
+    m_nextNodeTime = m_curr->first;
+
+    if (m_curr == m_WayPoints.begin())
+        sLog->outDebug(LOG_FILTER_TRANSPORTS, " ************ BEGIN ************** %s", m_name.c_str());
+
+    sLog->outDebug(LOG_FILTER_TRANSPORTS, "%s moved to %d %f %f %f %d", m_name.c_str(), m_curr->second.id, m_curr->second.x, m_curr->second.y, m_curr->second.z, m_curr->second.mapid);
+}
+
 void Transport::UpdateForMap(Map const* targetMap)
 {
     Map::PlayerList const& pl = targetMap->GetPlayers();
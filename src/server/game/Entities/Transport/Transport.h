@@ -34,6 +34,9 @@ class Transport : public GameObject
         bool Create(uint32 guidlow, uint32 entry, uint32 mapid, float x, float y, float z, float ang, uint32 animprogress, uint32 dynflags);
         bool GenerateWaypoints(uint32 pathid, std::set<uint32> &mapids);
         void Update(uint32 p_time);
+        // map changes found by Update(), must be called while no map is updating
+        bool IsTeleportPending() const { return m_teleportPending; }
+        void DoPendingTeleport();
         bool AddPassenger(Player* passenger);
         bool RemovePassenger(Player* passenger);
 
@@ -82,6 +85,7 @@ class Transport : public GameObject
         uint32 currenttguid;
         uint32 m_period;
         uint32 ScriptId;
+        bool m_teleportPending;
     public:
         WayPointMap m_WayPoints;
         uint32 m_nextNodeTime;
@@ -90,6 +94,7 @@ class Transport : public GameObject
         void TeleportTransport(uint32 newMapid, float x, float y, float z);
         void UpdateForMap(Map const* map);
         void DoEventIfAny(WayPointMap::value_type const& node, bool departure);
+        void NodeReached();
         WayPointMap::const_iterator GetNextWayPoint();
 };
 #endif
@@ -3206,6 +3206,10 @@ Aura* Unit::_TryStackingOrRefreshingExistingAura(SpellInfo const* newAura, uint8
 void Unit::_AddAura(UnitAura* aura, Unit* caster)
 {
     ASSERT(!m_cleanupDone);
+    // new auras may have durations and ticks, see Creature::_GetSleepTime
+    if (Creature* creature = ToCreature())
+        creature->WakeUp();
+
     m_ownedAuras.insert(AuraMap::value_type(aura->GetId(), aura));
 
     _RemoveNoStackAurasDueToAura(aura);
@@ -12034,6 +12038,8 @@ void Unit::SetInCombatState(bool PvP, Unit* enemy)
 
     if (Creature* creature = ToCreature())
     {
+        creature->WakeUp();
+
         // Set home position at place of engaging combat for escorted creatures
         if ((IsAIEnabled && creature->AI()->IsEscorted()) ||
             GetMotionMaster()->GetCurrentMovementGeneratorType() == WAYPOINT_MOTION_TYPE ||
@@ -15404,15 +15410,11 @@ void Unit::Kill(Unit* victim, bool durabilityLoss)
 
         if (creature)
         {
-            Loot* loot = &creature->loot;
             if (creature->lootForPickPocketed)
                 creature->lootForPickPocketed = false;
 
-            loot->clear();
-            if (uint32 lootid = creature->GetCreatureInfo()->lootid)
-                loot->FillLoot(lootid, LootTemplates_Creature, looter, false, false, creature->GetLootMode());
-
-            loot->generateMoneyLoot(creature->GetCreatureInfo()->mingold, creature->GetCreatureInfo()->maxgold);
+            // most corpses are never opened, the loot is rolled when it is first needed
+            creature->ScheduleLootGeneration();
         }
 
         player->RewardPlayerAndGroupAtKill(victim, false);
@@ -45,6 +45,7 @@
 #include "ScriptMgr.h"
 #include "SpellScript.h"
 #include "PoolMgr.h"
+#include "WorldSnapshot.h"
 
 ScriptMapMap sQuestEndScripts;
 ScriptMapMap sQuestStartScripts;
@@ -1407,10 +1408,54 @@ bool ObjectMgr::SetCreatureLinkedRespawn(uint32 guidLow, uint32 linkedGuidLow)
     return true;
 }
 
+namespace
+{
+    // spawn row as kept in the world snapshot
+    template<class T>
+    struct SnapshotSpawn
+    {
+        uint32 guid;
+        T data;
+    };
+
+    template<class T>
+    void StoreSnapshotSpawns(uint32 dataSection, uint32 gridSection, UNORDERED_MAP<uint32, T> const& spawns, std::vector<uint32> const& gridGuids)
+    {
+        std::vector<SnapshotSpawn<T> > rows;
+        rows.reserve(spawns.size());
+        for (typename UNORDERED_MAP<uint32, T>::const_iterator itr = spawns.begin(); itr != spawns.end(); ++itr)
+        {
+            SnapshotSpawn<T> row;
+            row.guid = itr->first;
+            row.data = itr->second;
+            rows.push_back(row);
+        }
+
+        sWorldSnapshot->StoreRows(dataSection, rows);
+        sWorldSnapshot->StoreRows(gridSection, gridGuids);
+    }
+}
+
 void ObjectMgr::LoadCreatures()
 {
     uint32 oldMSTime = getMSTime();
 
+    SnapshotSpawn<CreatureData> const* snapshotRows;
+    uint32 const* snapshotGrid;
+    uint32 rowCount, gridCount;
+    if (sWorldSnapshot->GetRows(SNAPSHOT_CREATURE_DATA, snapshotRows, rowCount) && sWorldSnapshot->GetRows(SNAPSHOT_CREATURE_GRID, snapshotGrid, gridCount))
+    {
+        for (uint32 i = 0; i < rowCount; ++i)
+            mCreatureDataMap[snapshotRows[i].guid] = snapshotRows[i].data;
+
+        for (uint32 i = 0; i < gridCount; ++i)
+            AddCreatureToGrid(snapshotGrid[i], &mCreatureDataMap[snapshotGrid[i]]);
+
+        sLog->outString(">> Loaded %u creatures from world snapshot in %u ms", rowCount, GetMSTimeDiffToNow(oldMSTime));
+        sLog->outString();
+        return;
+    }
+
     //                                                         0     1   2      3           4            5         6            7           8            9            10
     QueryResult result = WorldDatabase.Query("SELECT creature.guid, id, map, modelid, equipment_id, position_x, position_y, position_z, orientation, spawntimesecs, spawndist, "
     //          11            12        13        14           15           16        17          18          19                 20                  21
@@ -1443,6 +1488,7 @@ void ObjectMgr::LoadCreatures()
                 if (GetMapDifficultyData(i, Difficulty(k)))
                     spawnMasks[i] |= (1 << k);
 
+    std::vector<uint32> gridGuids;
     uint32 count = 0;
     do
     {
@@ -1551,12 +1597,17 @@ void ObjectMgr::LoadCreatures()
 
         // Add to grid if not managed by the game event or pool system
         if (gameEvent == 0 && PoolId == 0)
+        {
             AddCreatureToGrid(guid, &data);
+            gridGuids.push_back(guid);
+        }
 
         ++count;
 
     } while (result->NextRow());
 
+    StoreSnapshotSpawns(SNAPSHOT_CREATURE_DATA, SNAPSHOT_CREATURE_GRID, mCreatureDataMap, gridGuids);
+
     sLog->outString(">> Loaded %u creatures in %u ms", count, GetMSTimeDiffToNow(oldMSTime));
     sLog->outString();
 }
@@ -1736,6 +1787,22 @@ void ObjectMgr::LoadGameobjects()
 {
     uint32 oldMSTime = getMSTime();
 
+    SnapshotSpawn<GameObjectData> const* snapshotRows;
+    uint32 const* snapshotGrid;
+    uint32 rowCount, gridCount;
+    if (sWorldSnapshot->GetRows(SNAPSHOT_GAMEOBJECT_DATA, snapshotRows, rowCount) && sWorldSnapshot->GetRows(SNAPSHOT_GAMEOBJECT_GRID, snapshotGrid, gridCount))
+    {
+        for (uint32 i = 0; i < rowCount; ++i)
+            mGameObjectDataMap[snapshotRows[i].guid] = snapshotRows[i].data;
+
+        for (uint32 i = 0; i < gridCount; ++i)
+            AddGameobjectToGrid(snapshotGrid[i], &mGameObjectDataMap[snapshotGrid[i]]);
+
+        sLog->outString(">> Loaded %lu gameobjects from world snapshot in %u ms", (unsigned long)mGameObjectDataMap.size(), GetMSTimeDiffToNow(oldMSTime));
+        sLog->outString();
+        return;
+    }
+
     uint32 count = 0;
 
     //                                                0                1   2    3           4           5           6
@@ -1760,6 +1827,7 @@ void ObjectMgr::LoadGameobjects()
                 if (GetMapDifficultyData(i, Difficulty(k)))
                     spawnMasks[i] |= (1 << k);
 
+    std::vector<uint32> gridGuids;
     do
     {
         Field* fields = result->Fetch();
@@ -1864,11 +1932,16 @@ void ObjectMgr::LoadGameobjects()
         }
 
         if (gameEvent == 0 && PoolId == 0)                      // if not this is to be managed by GameEvent System or Pool system
+        {
             AddGameobjectToGrid(guid, &data);
+            gridGuids.push_back(guid);
+        }
         ++count;
 
     } while (result->NextRow());
 
+    StoreSnapshotSpawns(SNAPSHOT_GAMEOBJECT_DATA, SNAPSHOT_GAMEOBJECT_GRID, mGameObjectDataMap, gridGuids);
+
     sLog->outString(">> Loaded %lu gameobjects in %u ms", (unsigned long)mGameObjectDataMap.size(), GetMSTimeDiffToNow(oldMSTime));
     sLog->outString();
 }
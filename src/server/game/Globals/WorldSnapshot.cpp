@@ -0,0 +1,272 @@
+/*
+ * Copyright (C) 2008-2011 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "WorldSnapshot.h"
+#include "DatabaseEnv.h"
+#include "SystemConfig.h"
+#include "Log.h"
+#include "Timer.h"
+
+#define SNAPSHOT_MAGIC          0x504E5357                  // "WSNP"
+#define SNAPSHOT_VERSION        1
+#define SNAPSHOT_ALIGNMENT      8
+
+namespace
+{
+    struct SnapshotHeader
+    {
+        uint32 magic;
+        uint32 version;
+        uint64 key;
+        uint32 sectionCount;
+        uint32 payloadChecksum;                             // of everything behind the section table
+    };
+
+    // every table whose content ends up in a section, directly or through validation
+    char const* const SnapshotSourceTables =
+        "creature, creature_template, creature_equip_template, game_event_creature, pool_creature, "
+        "gameobject, gameobject_template, game_event_gameobject, pool_gameobject";
+
+    inline uint64 HashBytes(uint64 hash, void const* data, size_t size)
+    {
+        uint8 const* bytes = static_cast<uint8 const*>(data);
+        for (size_t i = 0; i < size; ++i)
+        {
+            hash ^= bytes[i];
+            hash *= UI64LIT(0x100000001b3);
+        }
+        return hash;
+    }
+
+    inline uint32 Align(uint32 offset)
+    {
+        return (offset + SNAPSHOT_ALIGNMENT - 1) & ~uint32(SNAPSHOT_ALIGNMENT - 1);
+    }
+}
+
+WorldSnapshot::WorldSnapshot() : _enabled(false), _valid(false), _key(0)
+{
+}
+
+WorldSnapshot::~WorldSnapshot()
+{
+    _Close();
+}
+
+void WorldSnapshot::Open(std::string const& filename)
+{
+    uint32 oldMSTime = getMSTime();
+
+    _filename = filename;
+    _enabled = _ComputeKey();
+    if (!_enabled)
+    {
+        sLog->outError("World snapshot: could not checksum the source tables, snapshot disabled.");
+        return;
+    }
+
+    if (_map.map(filename.c_str(), static_cast<size_t>(-1), O_RDONLY, ACE_DEFAULT_FILE_PERMS, PROT_READ, ACE_MAP_PRIVATE) == -1)
+    {
+        sLog->outString(">> No world snapshot found at %s, it will be created from the database.", filename.c_str());
+        return;
+    }
+
+    _valid = _Validate();
+    if (!_valid)
+    {
+        sLog->outString(">> World snapshot %s is stale, it will be rebuilt from the database.", filename.c_str());
+        _Close();
+        return;
+    }
+
+    sLog->outString(">> World snapshot %s with %u sections opened in %u ms", filename.c_str(), uint32(_sections.size()), GetMSTimeDiffToNow(oldMSTime));
+}
+
+bool WorldSnapshot::_ComputeKey()
+{
+    QueryResult result = WorldDatabase.PQuery("CHECKSUM TABLE %s", SnapshotSourceTables);
+    if (!result)
+        return false;
+
+    uint64 key = UI64LIT(0xcbf29ce484222325);
+    uint32 version = SNAPSHOT_VERSION;
+    key = HashBytes(key, &version, sizeof(version));
+    key = HashBytes(key, _FULLVERSION, sizeof(_FULLVERSION));
+
+    do
+    {
+        Field* fields = result->Fetch();
+        // a missing table has a NULL checksum and the query does not fail
+        if (!fields[1].GetCString())
+            return false;
+
+        std::string table = fields[0].GetString();
+        std::string checksum = fields[1].GetString();
+        key = HashBytes(key, table.c_str(), table.size() + 1);
+        key = HashBytes(key, checksum.c_str(), checksum.size() + 1);
+    }
+    while (result->NextRow());
+
+    _key = key;
+    return true;
+}
+
+bool WorldSnapshot::_Validate()
+{
+    size_t size = _map.size();
+    uint8 const* base = static_cast<uint8 const*>(_map.addr());
+    if (size < sizeof(SnapshotHeader))
+        return false;
+
+    SnapshotHeader header;
+    memcpy(&header, base, sizeof(header));
+    if (header.magic != SNAPSHOT_MAGIC || header.version != SNAPSHOT_VERSION || header.key != _key)
+        return false;
+
+    size_t tableEnd = sizeof(SnapshotHeader) + size_t(header.sectionCount) * sizeof(SectionInfo);
+    if (tableEnd > size)
+        return false;
+
+    if (uint32(HashBytes(UI64LIT(0xcbf29ce484222325), base + tableEnd, size - tableEnd)) != header.payloadChecksum)
+    {
+        sLog->outError("World snapshot %s is corrupted.", _filename.c_str());
+        return false;
+    }
+
+    for (uint32 i = 0; i < header.sectionCount; ++i)
+    {
+        SectionInfo info;
+        memcpy(&info, base + sizeof(SnapshotHeader) + i * sizeof(SectionInfo), sizeof(info));
+        if (size_t(info.offset) + size_t(info.rowSize) * info.rowCount > size || info.offset % SNAPSHOT_ALIGNMENT)
+            return false;
+
+        _sections[info.id] = info;
+    }
+
+    return true;
+}
+
+bool WorldSnapshot::_GetSection(uint32 section, uint32 rowSize, void const*& data, uint32& count) const
+{
+    if (!_valid)
+        return false;
+
+    std::map<uint32, SectionInfo>::const_iterator itr = _sections.find(section);
+    if (itr == _sections.end() || itr->second.rowSize != rowSize)
+        return false;
+
+    data = static_cast<uint8 const*>(_map.addr()) + itr->second.offset;
+    count = itr->second.rowCount;
+    return true;
+}
+
+void WorldSnapshot::_StoreSection(uint32 section, uint32 rowSize, void const* data, uint32 count)
+{
+    if (!_enabled)
+        return;
+
+    StoredSection& stored = _stored[section];
+    stored.rowSize = rowSize;
+    stored.rowCount = count;
+    stored.data.assign(static_cast<char const*>(data), size_t(rowSize) * count);
+}
+
+void WorldSnapshot::Save()
+{
+    if (!_enabled)
+        return;
+
+    // the file is current and nothing was reloaded from the database
+    if (_stored.empty())
+    {
+        _Close();
+        return;
+    }
+
+    // sections of an up to date file that nobody reloaded are carried over
+    if (_valid)
+    {
+        for (std::map<uint32, SectionInfo>::const_iterator itr = _sections.begin(); itr != _sections.end(); ++itr)
+        {
+            if (_stored.find(itr->first) != _stored.end())
+                continue;
+
+            StoredSection& stored = _stored[itr->first];
+            stored.rowSize = itr->second.rowSize;
+            stored.rowCount = itr->second.rowCount;
+            stored.data.assign(static_cast<char const*>(_map.addr()) + itr->second.offset, size_t(stored.rowSize) * stored.rowCount);
+        }
+    }
+
+    _Close();
+
+    std::string file;
+    file.resize(sizeof(SnapshotHeader) + _stored.size() * sizeof(SectionInfo));
+    uint32 tableEnd = uint32(file.size());
+
+    uint32 index = 0;
+    for (std::map<uint32, StoredSection>::const_iterator itr = _stored.begin(); itr != _stored.end(); ++itr, ++index)
+    {
+        file.resize(Align(uint32(file.size())), '\0');
+
+        SectionInfo info;
+        info.id = itr->first;
+        info.rowSize = itr->second.rowSize;
+        info.rowCount = itr->second.rowCount;
+        info.offset = uint32(file.size());
+        memcpy(&file[sizeof(SnapshotHeader) + index * sizeof(SectionInfo)], &info, sizeof(info));
+
+        file.append(itr->second.data);
+    }
+
+    SnapshotHeader header;
+    header.magic = SNAPSHOT_MAGIC;
+    header.version = SNAPSHOT_VERSION;
+    header.key = _key;
+    header.sectionCount = uint32(_stored.size());
+    header.payloadChecksum = uint32(HashBytes(UI64LIT(0xcbf29ce484222325), file.data() + tableEnd, file.size() - tableEnd));
+    memcpy(&file[0], &header, sizeof(header));
+
+    _stored.clear();
+
+    // write aside and rename, a crash while writing must not leave a broken snapshot
+    std::string tmpName = _filename + ".tmp";
+    FILE* out = fopen(tmpName.c_str(), "wb");
+    if (!out)
+    {
+        sLog->outError("World snapshot: can't create %s.", tmpName.c_str());
+        return;
+    }
+
+    bool written = fwrite(file.data(), 1, file.size(), out) == file.size();
+    written = !fclose(out) && written;
+    if (!written || ACE_OS::rename(tmpName.c_str(), _filename.c_str()) == -1)
+    {
+        sLog->outError("World snapshot: can't write %s.", _filename.c_str());
+        remove(tmpName.c_str());
+        return;
+    }
+
+    sLog->outString(">> World snapshot %s written (%u bytes)", _filename.c_str(), uint32(file.size()));
+}
+
+void WorldSnapshot::_Close()
+{
+    _map.close();
+    _sections.clear();
+    _valid = false;
+}
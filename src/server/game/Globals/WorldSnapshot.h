@@ -0,0 +1,103 @@
+/*
+ * Copyright (C) 2008-2011 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRINITY_WORLDSNAPSHOT_H
+#define TRINITY_WORLDSNAPSHOT_H
+
+#include "Define.h"
+#include <ace/Singleton.h>
+#include <ace/Mem_Map.h>
+#include <map>
+#include <string>
+#include <vector>
+
+enum WorldSnapshotSections
+{
+    SNAPSHOT_CREATURE_DATA          = 1,
+    SNAPSHOT_CREATURE_GRID          = 2,
+    SNAPSHOT_GAMEOBJECT_DATA        = 3,
+    SNAPSHOT_GAMEOBJECT_GRID        = 4,
+};
+
+// Binary copy of world DB tables as they were after loading and validation, so the next
+// start can fill its containers from one read-only mapped file instead of querying and
+// re-checking every row. The file is keyed by CHECKSUM TABLE of every source table and the
+// core revision: any change to the tables makes it stale, the loaders then fall back to SQL
+// and hand their results over for a new file, written by Save().
+// Rows are stored as raw structs and must be plain data.
+class WorldSnapshot
+{
+    friend class ACE_Singleton<WorldSnapshot, ACE_Null_Mutex>;
+    WorldSnapshot();
+    ~WorldSnapshot();
+
+    public:
+        void Open(std::string const& filename);
+        void Save();
+
+        // true when the rows of a section come from an up to date snapshot
+        template<class T>
+        bool GetRows(uint32 section, T const*& rows, uint32& count) const
+        {
+            void const* data;
+            if (!_GetSection(section, sizeof(T), data, count))
+                return false;
+            rows = static_cast<T const*>(data);
+            return true;
+        }
+
+        // rows loaded from SQL, written by the next Save() if the snapshot was stale
+        template<class T>
+        void StoreRows(uint32 section, std::vector<T> const& rows)
+        {
+            _StoreSection(section, sizeof(T), rows.empty() ? NULL : &rows[0], uint32(rows.size()));
+        }
+
+    private:
+        struct SectionInfo
+        {
+            uint32 id;
+            uint32 rowSize;
+            uint32 rowCount;
+            uint32 offset;
+        };
+
+        bool _ComputeKey();
+        bool _Validate();
+        bool _GetSection(uint32 section, uint32 rowSize, void const*& data, uint32& count) const;
+        void _StoreSection(uint32 section, uint32 rowSize, void const* data, uint32 count);
+        void _Close();
+
+        bool _enabled;
+        bool _valid;                                        // mapping matches the current tables
+        std::string _filename;
+        uint64 _key;
+        ACE_Mem_Map _map;
+        std::map<uint32, SectionInfo> _sections;
+
+        struct StoredSection
+        {
+            uint32 rowSize;
+            uint32 rowCount;
+            std::string data;
+        };
+        std::map<uint32, StoredSection> _stored;
+};
+
+#define sWorldSnapshot ACE_Singleton<WorldSnapshot, ACE_Null_Mutex>::instance()
+
+#endif
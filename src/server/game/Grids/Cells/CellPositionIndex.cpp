@@ -0,0 +1,157 @@
+/*
+ * Copyright (C) 2008-2011 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "CellPositionIndex.h"
+#include "Creature.h"
+#include "Player.h"
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#include <xmmintrin.h>
+#define CELL_INDEX_SSE
+#endif
+
+CellPositionIndex::~CellPositionIndex()
+{
+    for (std::vector<WorldObject*>::const_iterator itr = _objects.begin(); itr != _objects.end(); ++itr)
+        (*itr)->m_cellIndex = NULL;
+}
+
+void CellPositionIndex::Insert(CellPositionIndex*& index, WorldObject* obj)
+{
+    if (!index)
+        index = new CellPositionIndex();
+
+    obj->m_cellIndex = index;
+    obj->m_cellIndexSlot = index->size();
+
+    index->_x.push_back(obj->GetPositionX());
+    index->_y.push_back(obj->GetPositionY());
+    index->_size.push_back(obj->GetObjectSize());
+    index->_phaseMask.push_back(obj->GetPhaseMask());
+    index->_objects.push_back(obj);
+}
+
+void CellPositionIndex::Erase(CellPositionIndex* index, WorldObject* obj)
+{
+    ASSERT(index && obj->m_cellIndex == index);
+
+    uint32 slot = obj->m_cellIndexSlot;
+    uint32 last = index->size() - 1;
+    if (slot != last)
+    {
+        WorldObject* moved = index->_objects[last];
+        index->_x[slot] = index->_x[last];
+        index->_y[slot] = index->_y[last];
+        index->_size[slot] = index->_size[last];
+        index->_phaseMask[slot] = index->_phaseMask[last];
+        index->_objects[slot] = moved;
+        moved->m_cellIndexSlot = slot;
+    }
+
+    index->_x.pop_back();
+    index->_y.pop_back();
+    index->_size.pop_back();
+    index->_phaseMask.pop_back();
+    index->_objects.pop_back();
+
+    obj->m_cellIndex = NULL;
+}
+
+uint32 CellPositionIndex::FilterBlock(uint32 first, float x, float y, float range, uint32 phaseMask) const
+{
+    uint32 count = std::min<uint32>(size() - first, CELL_INDEX_BLOCK);
+    float const* px = &_x[first];
+    float const* py = &_y[first];
+    float const* psize = &_size[first];
+    range += CELL_INDEX_SLACK;
+
+    uint32 mask = 0;
+    uint32 i = 0;
+#ifdef CELL_INDEX_SSE
+    __m128 vx = _mm_set1_ps(x), vy = _mm_set1_ps(y), vrange = _mm_set1_ps(range);
+    for (; i + 4 <= count; i += 4)
+    {
+        __m128 dx = _mm_sub_ps(_mm_loadu_ps(px + i), vx);
+        __m128 dy = _mm_sub_ps(_mm_loadu_ps(py + i), vy);
+        __m128 limit = _mm_add_ps(vrange, _mm_loadu_ps(psize + i));
+        __m128 inside = _mm_cmple_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(limit, limit));
+        mask |= uint32(_mm_movemask_ps(inside)) << i;
+    }
+#endif
+
+    for (; i < count; ++i)
+    {
+        float dx = px[i] - x, dy = py[i] - y;
+        float limit = range + psize[i];
+        if (dx*dx + dy*dy <= limit*limit)
+            mask |= uint32(1) << i;
+    }
+
+    // few units survive the distance test, check their phase one by one
+    for (uint32 bits = mask; bits; bits &= bits - 1)
+    {
+        uint32 bit = 0;
+        while (!(bits & (uint32(1) << bit)))
+            ++bit;
+        if (!(_phaseMask[first + bit] & phaseMask))
+            mask &= ~(uint32(1) << bit);
+    }
+
+    return mask;
+}
+
+WorldObject* CellPositionIndex::Cursor::Next()
+{
+    if (!_index)
+        return NULL;
+
+    while (!_mask)
+    {
+        if (_next >= _index->size())
+            return NULL;
+
+        _base = _next;
+        _mask = _index->FilterBlock(_next, _x, _y, _range, _phaseMask);
+        _next += CELL_INDEX_BLOCK;
+    }
+
+    uint32 bit = 0;
+    while (!(_mask & (uint32(1) << bit)))
+        ++bit;
+    _mask &= _mask - 1;
+    return _index->GetObject(_base + bit);
+}
+
+void CellIndexHook<Creature>::Insert(CellPositionIndex*& index, Creature* obj)
+{
+    CellPositionIndex::Insert(index, obj);
+}
+
+void CellIndexHook<Creature>::Erase(CellPositionIndex* index, Creature* obj)
+{
+    CellPositionIndex::Erase(index, obj);
+}
+
+void CellIndexHook<Player>::Insert(CellPositionIndex*& index, Player* obj)
+{
+    CellPositionIndex::Insert(index, obj);
+}
+
+void CellIndexHook<Player>::Erase(CellPositionIndex* index, Player* obj)
+{
+    CellPositionIndex::Erase(index, obj);
+}
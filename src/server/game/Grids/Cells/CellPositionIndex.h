@@ -0,0 +1,115 @@
+/*
+ * Copyright (C) 2008-2011 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRINITY_CELLPOSITIONINDEX_H
+#define TRINITY_CELLPOSITIONINDEX_H
+
+#include "Define.h"
+#include <vector>
+
+#define CELL_INDEX_BLOCK            32                      // slots filtered per FilterBlock() call
+#define CELL_INDEX_SLACK            0.01f                   // yards, covers rounding differences to the exact range checks
+
+class WorldObject;
+class Creature;
+class Player;
+
+// Compact mirror of the units listed in one grid cell container: positions, phase masks and
+// object sizes are kept as parallel arrays so range searches can reject far away units four
+// at a time (SSE) without touching the objects themselves. Every unit knows its slot and
+// refreshes it on relocation, removal moves the last slot into the hole.
+class CellPositionIndex
+{
+    public:
+        CellPositionIndex() {}
+        ~CellPositionIndex();
+
+        // index is created on first use
+        static void Insert(CellPositionIndex*& index, WorldObject* obj);
+        static void Erase(CellPositionIndex* index, WorldObject* obj);
+
+        void Update(uint32 slot, float x, float y, float size)
+        {
+            _x[slot] = x;
+            _y[slot] = y;
+            _size[slot] = size;
+        }
+        void SetPhaseMask(uint32 slot, uint32 phaseMask) { _phaseMask[slot] = phaseMask; }
+
+        uint32 size() const { return uint32(_objects.size()); }
+        WorldObject* GetObject(uint32 slot) const { return _objects[slot]; }
+
+        // bit n is set if slot first + n shares a phase with phaseMask and its 2d distance to (x, y)
+        // minus its object size is not above range, the caller adds its own object size to range
+        uint32 FilterBlock(uint32 first, float x, float y, float range, uint32 phaseMask) const;
+
+        // walks the slots accepted by FilterBlock(), the index must not change meanwhile
+        class Cursor
+        {
+            public:
+                Cursor() : _index(NULL), _x(0.0f), _y(0.0f), _range(0.0f), _phaseMask(0), _next(0), _base(0), _mask(0) {}
+                Cursor(CellPositionIndex const* index, float x, float y, float range, uint32 phaseMask)
+                    : _index(index), _x(x), _y(y), _range(range), _phaseMask(phaseMask), _next(0), _base(0), _mask(0) {}
+
+                // NULL once all accepted slots were returned
+                WorldObject* Next();
+
+            private:
+                CellPositionIndex const* _index;
+                float _x;
+                float _y;
+                float _range;
+                uint32 _phaseMask;
+                uint32 _next;
+                uint32 _base;
+                uint32 _mask;
+        };
+
+    private:
+        CellPositionIndex(CellPositionIndex const&);
+        CellPositionIndex& operator=(CellPositionIndex const&);
+
+        std::vector<float> _x;
+        std::vector<float> _y;
+        std::vector<float> _size;
+        std::vector<uint32> _phaseMask;
+        std::vector<WorldObject*> _objects;
+};
+
+// GridReference hooks, only unit lists keep a position index
+template<class OBJECT>
+struct CellIndexHook
+{
+    static void Insert(CellPositionIndex*& /*index*/, OBJECT* /*obj*/) {}
+    static void Erase(CellPositionIndex* /*index*/, OBJECT* /*obj*/) {}
+};
+
+template<>
+struct CellIndexHook<Creature>
+{
+    static void Insert(CellPositionIndex*& index, Creature* obj);
+    static void Erase(CellPositionIndex* index, Creature* obj);
+};
+
+template<>
+struct CellIndexHook<Player>
+{
+    static void Insert(CellPositionIndex*& index, Player* obj);
+    static void Erase(CellPositionIndex* index, Player* obj);
+};
+
+#endif
@@ -20,6 +20,7 @@
 #define _GRIDREFMANAGER
 
 #include "RefManager.h"
+#include "CellPositionIndex.h"
 
 template<class OBJECT>
 class GridReference;
@@ -30,6 +31,9 @@ class GridRefManager : public RefManager<GridRefManager<OBJECT>, OBJECT>
     public:
         typedef LinkedListHead::Iterator< GridReference<OBJECT> > iterator;
 
+        GridRefManager() : i_positionIndex(NULL) {}
+        ~GridRefManager() { delete i_positionIndex; }
+
         GridReference<OBJECT>* getFirst() { return (GridReference<OBJECT>*)RefManager<GridRefManager<OBJECT>, OBJECT>::getFirst(); }
         GridReference<OBJECT>* getLast() { return (GridReference<OBJECT>*)RefManager<GridRefManager<OBJECT>, OBJECT>::getLast(); }
 
@@ -37,6 +41,16 @@ class GridRefManager : public RefManager<GridRefManager<OBJECT>, OBJECT>
         iterator end() { return iterator(NULL); }
         iterator rbegin() { return iterator(getLast()); }
         iterator rend() { return iterator(NULL); }
+
+        // position mirror of the listed units, NULL for other object types or while no unit was listed
+        CellPositionIndex const* GetPositionIndex() const { return i_positionIndex; }
+        CellPositionIndex*& PositionIndexRef() { return i_positionIndex; }
+
+    private:
+        GridRefManager(GridRefManager const&);
+        GridRefManager& operator=(GridRefManager const&);
+
+        CellPositionIndex* i_positionIndex;
 };
 #endif
 
@@ -20,6 +20,7 @@
 #define _GRIDREFERENCE_H
 
 #include "LinkedReference/Reference.h"
+#include "CellPositionIndex.h"
 
 template<class OBJECT>
 class GridRefManager;
@@ -33,11 +34,16 @@ class GridReference : public Reference<GridRefManager<OBJECT>, OBJECT>
             // called from link()
             this->getTarget()->insertFirst(this);
             this->getTarget()->incSize();
+            CellIndexHook<OBJECT>::Insert(this->getTarget()->PositionIndexRef(), this->getSource());
         }
         void targetObjectDestroyLink()
         {
             // called from unlink()
-            if (this->isValid()) this->getTarget()->decSize();
+            if (this->isValid())
+            {
+                this->getTarget()->decSize();
+                CellIndexHook<OBJECT>::Erase(this->getTarget()->PositionIndexRef(), this->getSource());
+            }
         }
         void sourceObjectDestroyLink()
         {
@@ -244,12 +244,9 @@ void AIRelocationNotifier::Visit(CreatureMapType &m)
 void
 MessageDistDeliverer::Visit(PlayerMapType &m)
 {
-    for (PlayerMapType::iterator iter = m.begin(); iter != m.end(); ++iter)
+    CellUnitIterator<Player> itr(m, i_source->GetPositionX(), i_source->GetPositionY(), i_dist, i_phaseMask);
+    while (Player* target = itr.Next())
     {
-        Player* target = iter->getSource();
-        if (!target->InSamePhase(i_phaseMask))
-            continue;
-
         if (target->GetExactDist2dSq(i_source) > i_distSq)
             continue;
 
@@ -269,12 +266,9 @@ MessageDistDeliverer::Visit(PlayerMapType &m)
 
 void MessageDistDeliverer::Visit(CreatureMapType &m)
 {
-    for (CreatureMapType::iterator iter = m.begin(); iter != m.end(); ++iter)
+    CellUnitIterator<Creature> itr(m, i_source->GetPositionX(), i_source->GetPositionY(), i_dist, i_phaseMask);
+    while (Creature* target = itr.Next())
     {
-        Creature* target = iter->getSource();
-        if (!target->InSamePhase(i_phaseMask))
-            continue;
-
         if (target->GetExactDist2dSq(i_source) > i_distSq)
             continue;
 
@@ -36,6 +36,94 @@ class Player;
 
 namespace Trinity
 {
+    // Base of the unit checks only accepting units within i_range of i_obj (IsWithinDistInMap),
+    // unit searchers use it to skip the units outside of that range through the cell position index
+    class UnitInObjectRangeCheck
+    {
+        public:
+            WorldObject const* GetRangeCenter() const { return i_obj; }
+            float GetRange() const { return i_range; }
+        protected:
+            UnitInObjectRangeCheck(WorldObject const* obj, float range) : i_obj(obj), i_range(range) {}
+
+            WorldObject const* i_obj;
+            float i_range;
+    };
+
+    // overload resolution prefers the base class conversion over void const*
+    inline bool GetCheckRange(UnitInObjectRangeCheck const* check, WorldObject const*& center, float& range)
+    {
+        center = check->GetRangeCenter();
+        range = check->GetRange() + center->GetObjectSize();
+        return true;
+    }
+
+    inline bool GetCheckRange(void const* /*check*/, WorldObject const*& /*center*/, float& /*range*/)
+    {
+        return false;
+    }
+
+    // Units of one cell list sharing a phase with phaseMask. With a known search range and a
+    // position index on the list only the units the index could not rule out are returned,
+    // otherwise the whole list is walked.
+    template<class T>
+    class CellUnitIterator
+    {
+        public:
+            template<class Check>
+            CellUnitIterator(GridRefManager<T> &m, Check const& check, uint32 phaseMask)
+                : _itr(m.begin()), _end(m.end()), _phaseMask(phaseMask), _indexed(false)
+            {
+                WorldObject const* center;
+                float range;
+                if (GetCheckRange(&check, center, range))
+                    _InitCursor(m, center->GetPositionX(), center->GetPositionY(), range);
+            }
+
+            // range is compared against the 2d distance to (x, y) minus the unit's object size
+            CellUnitIterator(GridRefManager<T> &m, float x, float y, float range, uint32 phaseMask)
+                : _itr(m.begin()), _end(m.end()), _phaseMask(phaseMask), _indexed(false)
+            {
+                _InitCursor(m, x, y, range);
+            }
+
+            // whole list
+            CellUnitIterator(GridRefManager<T> &m, uint32 phaseMask)
+                : _itr(m.begin()), _end(m.end()), _phaseMask(phaseMask), _indexed(false) {}
+
+            T* Next()
+            {
+                if (_indexed)
+                    return static_cast<T*>(_cursor.Next());
+
+                while (_itr != _end)
+                {
+                    T* obj = _itr->getSource();
+                    ++_itr;
+                    if (obj->InSamePhase(_phaseMask))
+                        return obj;
+                }
+
+                return NULL;
+            }
+
+        private:
+            void _InitCursor(GridRefManager<T> &m, float x, float y, float range)
+            {
+                if (CellPositionIndex const* index = m.GetPositionIndex())
+                {
+                    _cursor = CellPositionIndex::Cursor(index, x, y, range, _phaseMask);
+                    _indexed = true;
+                }
+            }
+
+            typename GridRefManager<T>::iterator _itr;
+            typename GridRefManager<T>::iterator _end;
+            CellPositionIndex::Cursor _cursor;
+            uint32 _phaseMask;
+            bool _indexed;
+    };
+
     struct VisibleNotifier
     {
         Player &i_player;
@@ -123,13 +211,15 @@ namespace Trinity
         WorldObject* i_source;
         WorldPacket* i_message;
         uint32 i_phaseMask;
+        float i_dist;
         float i_distSq;
         uint32 team;
         Player const* skipped_receiver;
-        MessageDistDeliverer(WorldObject* src, WorldPacket* msg, float dist, bool own_team_only = false, Player const* skipped = NULL)
-            : i_source(src), i_message(msg), i_phaseMask(src->GetPhaseMask()), i_distSq(dist * dist)
+        uint32 i_relayTime;                                 // movement relay time, 0 for packets that are never thinned
+        MessageDistDeliverer(WorldObject* src, WorldPacket* msg, float dist, bool own_team_only = false, Player const* skipped = NULL, uint32 relayTime = 0)
+            : i_source(src), i_message(msg), i_phaseMask(src->GetPhaseMask()), i_dist(dist), i_distSq(dist * dist)
             , team((own_team_only && src->GetTypeId() == TYPEID_PLAYER) ? ((Player*)src)->GetTeam() : 0)
-            , skipped_receiver(skipped)
+            , skipped_receiver(skipped), i_relayTime(relayTime)
         {
         }
         void Visit(PlayerMapType &m);
@@ -146,6 +236,9 @@ namespace Trinity
             if (!plr->HaveAtClient(i_source))
                 return;
 
+            if (i_relayTime && !plr->GetMovementRelayFilter().ShouldRelay(i_source->GetGUID(), i_message->GetOpcode(), plr->m_seer->GetExactDist2dSq(i_source), i_relayTime))
+                return;
+
             if (WorldSession* session = plr->GetSession())
                 session->SendPacket(i_message);
         }
@@ -776,10 +869,10 @@ namespace Trinity
             uint32 i_spell;
     };
 
-    class AnyUnfriendlyUnitInObjectRangeCheck
+    class AnyUnfriendlyUnitInObjectRangeCheck : public UnitInObjectRangeCheck
     {
         public:
-            AnyUnfriendlyUnitInObjectRangeCheck(WorldObject const* obj, Unit const* funit, float range) : i_obj(obj), i_funit(funit), i_range(range) {}
+            AnyUnfriendlyUnitInObjectRangeCheck(WorldObject const* obj, Unit const* funit, float range) : UnitInObjectRangeCheck(obj, range), i_funit(funit) {}
             bool operator()(Unit* u)
             {
                 if (u->isAlive() && i_obj->IsWithinDistInMap(u, i_range) && !i_funit->IsFriendlyTo(u))
@@ -788,15 +881,13 @@ namespace Trinity
                     return false;
             }
         private:
-            WorldObject const* i_obj;
             Unit const* i_funit;
-            float i_range;
     };
 
-    class AnyUnfriendlyNoTotemUnitInObjectRangeCheck
+    class AnyUnfriendlyNoTotemUnitInObjectRangeCheck : public UnitInObjectRangeCheck
     {
         public:
-            AnyUnfriendlyNoTotemUnitInObjectRangeCheck(WorldObject const* obj, Unit const* funit, float range) : i_obj(obj), i_funit(funit), i_range(range) {}
+            AnyUnfriendlyNoTotemUnitInObjectRangeCheck(WorldObject const* obj, Unit const* funit, float range) : UnitInObjectRangeCheck(obj, range), i_funit(funit) {}
             bool operator()(Unit* u)
             {
                 if (!u->isAlive())
@@ -814,9 +905,7 @@ namespace Trinity
                 return i_obj->IsWithinDistInMap(u, i_range) && !i_funit->IsFriendlyTo(u);
             }
         private:
-            WorldObject const* i_obj;
             Unit const* i_funit;
-            float i_range;
     };
 
     class AnyUnfriendlyAttackableVisibleUnitInObjectRangeCheck
@@ -852,10 +941,10 @@ namespace Trinity
             uint32 i_lowguid;
     };
 
-    class AnyFriendlyUnitInObjectRangeCheck
+    class AnyFriendlyUnitInObjectRangeCheck : public UnitInObjectRangeCheck
     {
         public:
-            AnyFriendlyUnitInObjectRangeCheck(WorldObject const* obj, Unit const* funit, float range) : i_obj(obj), i_funit(funit), i_range(range) {}
+            AnyFriendlyUnitInObjectRangeCheck(WorldObject const* obj, Unit const* funit, float range) : UnitInObjectRangeCheck(obj, range), i_funit(funit) {}
             bool operator()(Unit* u)
             {
                 if (u->isAlive() && i_obj->IsWithinDistInMap(u, i_range) && i_funit->IsFriendlyTo(u))
@@ -864,15 +953,13 @@ namespace Trinity
                     return false;
             }
         private:
-            WorldObject const* i_obj;
             Unit const* i_funit;
-            float i_range;
     };
 
-    class AnyUnitInObjectRangeCheck
+    class AnyUnitInObjectRangeCheck : public UnitInObjectRangeCheck
     {
         public:
-            AnyUnitInObjectRangeCheck(WorldObject const* obj, float range) : i_obj(obj), i_range(range) {}
+            AnyUnitInObjectRangeCheck(WorldObject const* obj, float range) : UnitInObjectRangeCheck(obj, range) {}
             bool operator()(Unit* u)
             {
                 if (u->isAlive() && i_obj->IsWithinDistInMap(u, i_range))
@@ -880,9 +967,6 @@ namespace Trinity
 
                 return false;
             }
-        private:
-            WorldObject const* i_obj;
-            float i_range;
     };
 
     // Success at unit in range, range update for next check (this can be use with UnitLastSearcher to find nearest unit)
@@ -910,11 +994,11 @@ namespace Trinity
             NearestAttackableUnitInObjectRangeCheck(NearestAttackableUnitInObjectRangeCheck const&);
     };
 
-    class AnyAoETargetUnitInObjectRangeCheck
+    class AnyAoETargetUnitInObjectRangeCheck : public UnitInObjectRangeCheck
     {
         public:
             AnyAoETargetUnitInObjectRangeCheck(WorldObject const* obj, Unit const* funit, float range)
-                : i_obj(obj), i_funit(funit), i_range(range)
+                : UnitInObjectRangeCheck(obj, range), i_funit(funit)
             {
                 Unit const* check = i_funit;
                 Unit const* owner = i_funit->GetOwner();
@@ -935,9 +1019,7 @@ namespace Trinity
             }
         private:
             bool i_targetForPlayer;
-            WorldObject const* i_obj;
             Unit const* i_funit;
-            float i_range;
     };
 
     // do attack at call of help to friendly crearture
@@ -43,7 +43,7 @@ Trinity::ObjectUpdater::Visit(CreatureMapType &m)
 {
     for (CreatureMapType::iterator iter = m.begin(); iter != m.end(); ++iter)
         if (iter->getSource()->IsInWorld())
-            iter->getSource()->Update(i_timeDiff);
+            iter->getSource()->UpdateScheduled(i_timeDiff);
 }
 
 // SEARCHERS & LIST SEARCHERS & WORKERS
@@ -248,14 +248,12 @@ void Trinity::UnitSearcher<Check>::Visit(CreatureMapType &m)
     if (i_object)
         return;
 
-    for (CreatureMapType::iterator itr=m.begin(); itr != m.end(); ++itr)
+    CellUnitIterator<Creature> itr(m, i_check, i_phaseMask);
+    while (Creature* target = itr.Next())
     {
-        if (!itr->getSource()->InSamePhase(i_phaseMask))
-            continue;
-
-        if (i_check(itr->getSource()))
+        if (i_check(target))
         {
-            i_object = itr->getSource();
+            i_object = target;
             return;
         }
     }
@@ -268,14 +266,12 @@ void Trinity::UnitSearcher<Check>::Visit(PlayerMapType &m)
     if (i_object)
         return;
 
-    for (PlayerMapType::iterator itr=m.begin(); itr != m.end(); ++itr)
+    CellUnitIterator<Player> itr(m, i_check, i_phaseMask);
+    while (Player* target = itr.Next())
     {
-        if (!itr->getSource()->InSamePhase(i_phaseMask))
-            continue;
-
-        if (i_check(itr->getSource()))
+        if (i_check(target))
         {
-            i_object = itr->getSource();
+            i_object = target;
             return;
         }
     }
@@ -284,45 +280,37 @@ void Trinity::UnitSearcher<Check>::Visit(PlayerMapType &m)
 template<class Check>
 void Trinity::UnitLastSearcher<Check>::Visit(CreatureMapType &m)
 {
-    for (CreatureMapType::iterator itr=m.begin(); itr != m.end(); ++itr)
-    {
-        if (!itr->getSource()->InSamePhase(i_phaseMask))
-            continue;
-
-        if (i_check(itr->getSource()))
-            i_object = itr->getSource();
-    }
+    CellUnitIterator<Creature> itr(m, i_check, i_phaseMask);
+    while (Creature* target = itr.Next())
+        if (i_check(target))
+            i_object = target;
 }
 
 template<class Check>
 void Trinity::UnitLastSearcher<Check>::Visit(PlayerMapType &m)
 {
-    for (PlayerMapType::iterator itr=m.begin(); itr != m.end(); ++itr)
-    {
-        if (!itr->getSource()->InSamePhase(i_phaseMask))
-            continue;
-
-        if (i_check(itr->getSource()))
-            i_object = itr->getSource();
-    }
+    CellUnitIterator<Player> itr(m, i_check, i_phaseMask);
+    while (Player* target = itr.Next())
+        if (i_check(target))
+            i_object = target;
 }
 
 template<class Check>
 void Trinity::UnitListSearcher<Check>::Visit(PlayerMapType &m)
 {
-    for (PlayerMapType::iterator itr=m.begin(); itr != m.end(); ++itr)
-        if (itr->getSource()->InSamePhase(i_phaseMask))
-            if (i_check(itr->getSource()))
-                i_objects.push_back(itr->getSource());
+    CellUnitIterator<Player> itr(m, i_check, i_phaseMask);
+    while (Player* target = itr.Next())
+        if (i_check(target))
+            i_objects.push_back(target);
 }
 
 template<class Check>
 void Trinity::UnitListSearcher<Check>::Visit(CreatureMapType &m)
 {
-    for (CreatureMapType::iterator itr=m.begin(); itr != m.end(); ++itr)
-        if (itr->getSource()->InSamePhase(i_phaseMask))
-            if (i_check(itr->getSource()))
-                i_objects.push_back(itr->getSource());
+    CellUnitIterator<Creature> itr(m, i_check, i_phaseMask);
+    while (Creature* target = itr.Next())
+        if (i_check(target))
+            i_objects.push_back(target);
 }
 
 // Creature searchers
@@ -69,8 +69,10 @@ class LootTemplate::LootGroup                               // A set of loot def
     private:
         LootStoreItemList ExplicitlyChanced;                // Entries with chances defined in DB
         LootStoreItemList EqualChanced;                     // Zero chances - every entry takes the same chance
+        std::vector<float> ExplicitlyChancedSums;           // Running chance sums of ExplicitlyChanced, infinite from the first 100% entry on
 
-        LootStoreItem const* Roll() const;                 // Rolls an item from the group, returns NULL if all miss their chances
+        LootStoreItem const* Roll(uint32& missed) const;   // Rolls an item from the group, returns NULL if all miss their chances
+        static bool IsDuplicateDrop(Loot const& loot, LootStoreItem const& item);
 };
 
 //Remove all data and free all memory
@@ -242,18 +244,26 @@ void LootStore::ReportNotExistedId(uint32 id) const
 // Checks if the entry (quest, non-quest, reference) takes it's chance (at loot generation)
 // RATE_DROP_ITEMS is no longer used for all types of entries
 bool LootStoreItem::Roll(bool rate) const
+{
+    if (chance >= 100.0f)
+        return true;
+
+    return Roll(rate, rand_chance());
+}
+
+bool LootStoreItem::Roll(bool rate, double roll) const
 {
     if (chance >= 100.0f)
         return true;
 
     if (mincountOrRef < 0)                                   // reference case
-        return roll_chance_f(chance* (rate ? sWorld->getRate(RATE_DROP_ITEM_REFERENCED) : 1.0f));
+        return chance * (rate ? sWorld->getRate(RATE_DROP_ITEM_REFERENCED) : 1.0f) > roll;
 
     ItemTemplate const* pProto = sObjectMgr->GetItemTemplate(itemid);
 
     float qualityModifier = pProto && rate ? sWorld->getRate(qualityToRate[pProto->Quality]) : 1.0f;
 
-    return roll_chance_f(chance*qualityModifier);
+    return chance*qualityModifier > roll;
 }
 
 // Checks correctness of values
@@ -967,27 +977,30 @@ ByteBuffer& operator<<(ByteBuffer& b, LootView const& lv)
 void LootTemplate::LootGroup::AddEntry(LootStoreItem& item)
 {
     if (item.chance != 0)
+    {
         ExplicitlyChanced.push_back(item);
+
+        float sum = ExplicitlyChancedSums.empty() ? 0.0f : ExplicitlyChancedSums.back();
+        if (item.chance >= 100.0f)
+            sum = std::numeric_limits<float>::infinity();
+        ExplicitlyChancedSums.push_back(sum + item.chance);
+    }
     else
         EqualChanced.push_back(item);
 }
 
 // Rolls an item from the group, returns NULL if all miss their chances
-LootStoreItem const* LootTemplate::LootGroup::Roll() const
+// missed is set to the number of explicitly chanced entries the roll went past
+LootStoreItem const* LootTemplate::LootGroup::Roll(uint32& missed) const
 {
+    missed = 0;
     if (!ExplicitlyChanced.empty())                             // First explicitly chanced entries are checked
     {
-        float Roll = (float)rand_chance();
-
-        for (uint32 i = 0; i < ExplicitlyChanced.size(); ++i)   // check each explicitly chanced entry in the template and modify its chance based on quality.
-        {
-            if (ExplicitlyChanced[i].chance >= 100.0f)
-                return &ExplicitlyChanced[i];
-
-            Roll -= ExplicitlyChanced[i].chance;
-            if (Roll < 0)
-                return &ExplicitlyChanced[i];
-        }
+        // the hit is the first entry whose running chance sum exceeds the roll
+        std::vector<float>::const_iterator itr = std::upper_bound(ExplicitlyChancedSums.begin(), ExplicitlyChancedSums.end(), float(rand_chance()));
+        missed = uint32(itr - ExplicitlyChancedSums.begin());
+        if (itr != ExplicitlyChancedSums.end())
+            return &ExplicitlyChanced[missed];
     }
     if (!EqualChanced.empty())                              // If nothing selected yet - an item is taken from equal-chanced part
         return &EqualChanced[irand(0, EqualChanced.size()-1)];
@@ -1031,14 +1044,54 @@ void LootTemplate::LootGroup::CopyConditions(ConditionList /*conditions*/)
     }
 }
 
+// Non-equippable items are limited to 3 drops, equippable ones to 1
+bool LootTemplate::LootGroup::IsDuplicateDrop(Loot const& loot, LootStoreItem const& item)
+{
+    ItemTemplate const* proto = sObjectMgr->GetItemTemplate(item.itemid);
+    if (!proto)
+        return false;
+
+    uint8 count = 0;
+    for (LootItemList::const_iterator itr = loot.items.begin(); itr != loot.items.end(); ++itr)
+        if (itr->itemid == item.itemid)
+            ++count;
+
+    return count >= (proto->InventoryType == 0 ? 3 : 1);
+}
+
 // Rolls an item from the group (if any takes its chance) and adds the item to the loot
 void LootTemplate::LootGroup::Process(Loot& loot, uint16 lootMode) const
 {
-    // build up list of possible drops
+    // nearly always the first attempt decides, only copy the entry lists to reroll when its item can't drop
+    uint32 missed;
+    LootStoreItem const* rolled = Roll(missed);
+    if (!rolled)
+        return;
+
+    bool duplicate = false;
+    if (rolled->lootmode & lootMode)
+    {
+        if (!IsDuplicateDrop(loot, *rolled))
+        {
+            loot.AddItem(*rolled);
+            return;
+        }
+        duplicate = true;
+    }
+
+    // build up list of possible drops as the first attempt left them: explicitly chanced entries
+    // the roll went past are dropped, and so is the rolled entry if it was a duplicate
     LootStoreItemList EqualPossibleDrops = EqualChanced;
-    LootStoreItemList ExplicitPossibleDrops = ExplicitlyChanced;
+    LootStoreItemList ExplicitPossibleDrops(ExplicitlyChanced.begin() + missed, ExplicitlyChanced.end());
+    if (duplicate)
+    {
+        if (missed < ExplicitlyChanced.size())
+            ExplicitPossibleDrops.erase(ExplicitPossibleDrops.begin());
+        else
+            EqualPossibleDrops.erase(EqualPossibleDrops.begin() + (rolled - &EqualChanced[0]));
+    }
 
-    uint8 uiAttemptCount = 0;
+    uint8 uiAttemptCount = 1;
     const uint8 uiMaxAttempts = ExplicitlyChanced.size() + EqualChanced.size();
 
     while (!ExplicitPossibleDrops.empty() || !EqualPossibleDrops.empty())
@@ -1085,21 +1138,7 @@ void LootTemplate::LootGroup::Process(Loot& loot, uint16 lootMode) const
 
         if (item != NULL && item->lootmode & lootMode)   // only add this item if roll succeeds and the mode matches
         {
-            bool duplicate = false;
-            if (ItemTemplate const* _proto = sObjectMgr->GetItemTemplate(item->itemid))
-            {
-                uint8 _item_counter = 0;
-                for (LootItemList::const_iterator _item = loot.items.begin(); _item != loot.items.end(); ++_item)
-                    if (_item->itemid == item->itemid)                             // search through the items that have already dropped
-                    {
-                        ++_item_counter;
-                        if (_proto->InventoryType == 0 && _item_counter == 3)      // Non-equippable items are limited to 3 drops
-                            duplicate = true;
-                        else if (_proto->InventoryType != 0 && _item_counter == 1) // Equippable item are limited to 1 drop
-                            duplicate = true;
-                    }
-            }
-            if (duplicate) // if item->itemid is a duplicate, remove it
+            if (IsDuplicateDrop(loot, *item)) // if item->itemid is a duplicate, remove it
                 switch (itemSource)
                 {
                     case 1: // item came from ExplicitPossibleDrops
@@ -1219,13 +1258,24 @@ void LootTemplate::Process(Loot& loot, bool rate, uint16 lootMode, uint8 groupId
     }
 
     // Rolling non-grouped items
+    double rolls[LOOT_ROLL_BATCH];
+    uint32 nextRoll = LOOT_ROLL_BATCH;
     for (LootStoreItemList::const_iterator i = Entries.begin(); i != Entries.end(); ++i)
     {
         if (i->lootmode &~ lootMode)                          // Do not add if mode mismatch
             continue;
 
-        if (!i->Roll(rate))
-            continue;                                         // Bad luck for the entry
+        if (i->chance < 100.0f)
+        {
+            if (nextRoll == LOOT_ROLL_BATCH)
+            {
+                rand_chance_fill(rolls, std::min<uint32>(LOOT_ROLL_BATCH, Entries.end() - i));
+                nextRoll = 0;
+            }
+
+            if (!i->Roll(rate, rolls[nextRoll++]))
+                continue;                                     // Bad luck for the entry
+        }
 
         if (ItemTemplate const* _proto = sObjectMgr->GetItemTemplate(i->itemid))
         {
@@ -1368,7 +1418,7 @@ bool LootTemplate::addConditionItem(Condition* cond)
         {
             if (i->itemid == cond->mSourceEntry)
             {
-                i->conditions.push_back(cond);
+                ConditionMgr::AddToConditionList(i->conditions, cond);
                 return true;
             }
         }
@@ -1384,7 +1434,7 @@ bool LootTemplate::addConditionItem(Condition* cond)
                 {
                     if ((*i).itemid == cond->mSourceEntry)
                     {
-                        (*i).conditions.push_back(cond);
+                        ConditionMgr::AddToConditionList((*i).conditions, cond);
                         return true;
                     }
                 }
@@ -1396,7 +1446,7 @@ bool LootTemplate::addConditionItem(Condition* cond)
                 {
                     if ((*i).itemid == cond->mSourceEntry)
                     {
-                        (*i).conditions.push_back(cond);
+                        ConditionMgr::AddToConditionList((*i).conditions, cond);
                         return true;
                     }
                 }
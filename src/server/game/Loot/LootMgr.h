@@ -53,6 +53,9 @@ enum RollMask
 #define MAX_NR_QUEST_ITEMS 32
 // unrelated to the number of quest items shown, just for reserve
 
+// chance rolls of non-grouped entries are drawn this many at a time
+#define LOOT_ROLL_BATCH 32
+
 enum LootMethod
 {
     FREE_FOR_ALL      = 0,
@@ -120,6 +123,7 @@ struct LootStoreItem
          {}
 
     bool Roll(bool rate) const;                             // Checks if the entry takes it's chance (at loot generation)
+    bool Roll(bool rate, double roll) const;                // Same with an already drawn rand_chance() value
     bool IsValid(LootStore const& store, uint32 entry) const;
                                                             // Checks correctness of values
 };
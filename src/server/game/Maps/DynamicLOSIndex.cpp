@@ -0,0 +1,180 @@
+/*
+ * Copyright (C) 2008-2011 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "DynamicLOSIndex.h"
+#include <cmath>
+#include <limits>
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#include <xmmintrin.h>
+#define DYNLOS_SSE
+#endif
+
+uint32 DynamicLOSIndex::Add(float x, float y, float z, float radius, float height)
+{
+    uint32 index = size();
+
+    _x.push_back(x);
+    _y.push_back(y);
+    _radius.push_back(radius);
+    if (z != 0.0f || height != 0.0f)
+    {
+        _zMin.push_back(z);
+        _zMax.push_back(z + height);
+    }
+    else
+    {
+        // "over or under" can never be true for these
+        _zMin.push_back(std::numeric_limits<float>::infinity());
+        _zMax.push_back(-std::numeric_limits<float>::infinity());
+    }
+    _active.push_back(0);
+
+    int32 minX = _CellCoord(x - radius), maxX = _CellCoord(x + radius);
+    int32 minY = _CellCoord(y - radius), maxY = _CellCoord(y + radius);
+    for (int32 cx = minX; cx <= maxX; ++cx)
+        for (int32 cy = minY; cy <= maxY; ++cy)
+            _cells[_CellKey(cx, cy)].push_back(index);
+
+    return index + 1;
+}
+
+void DynamicLOSIndex::SetActiveState(uint32 id, bool state)
+{
+    if (id && id <= size())
+        _active[id - 1] = state ? 1 : 0;
+}
+
+bool DynamicLOSIndex::IsActive(uint32 id) const
+{
+    return id && id <= size() && _active[id - 1];
+}
+
+int32 DynamicLOSIndex::_CellCoord(float v)
+{
+    return int32(floor(v / DYNLOS_CELL_SIZE));
+}
+
+bool DynamicLOSIndex::IsInLOS(float x, float y, float /*z*/, float x2, float y2, float z2) const
+{
+    if (empty())
+        return true;
+
+    int32 minX = _CellCoord(std::min(x, x2)), maxX = _CellCoord(std::max(x, x2));
+    int32 minY = _CellCoord(std::min(y, y2)), maxY = _CellCoord(std::max(y, y2));
+
+    // an object may sit in several cells and be tested more than once, that's cheaper than deduplicating
+    if (uint32(maxX - minX + 1) * uint32(maxY - minY + 1) > DYNLOS_MAX_QUERY_CELLS)
+    {
+        std::vector<uint32> all(size());
+        for (uint32 i = 0; i < all.size(); ++i)
+            all[i] = i;
+        return !_IsBlocked(&all[0], all.size(), x, y, x2, y2, z2);
+    }
+
+    for (int32 cx = minX; cx <= maxX; ++cx)
+    {
+        for (int32 cy = minY; cy <= maxY; ++cy)
+        {
+            CellMap::const_iterator itr = _cells.find(_CellKey(cx, cy));
+            if (itr != _cells.end() && _IsBlocked(&itr->second[0], itr->second.size(), x, y, x2, y2, z2))
+                return false;
+        }
+    }
+
+    return true;
+}
+
+// An object blocks the segment if one of the end points stands inside its circle (unless the
+// target is within the object's height span), or if the segment bounding box reaches the circle
+// and the circle center is closer than radius to the line through both points.
+bool DynamicLOSIndex::_IsBlocked(uint32 const* indices, uint32 count, float x, float y, float x2, float y2, float z2) const
+{
+    float dx = x2 - x;
+    float dy = y2 - y;
+    float lenSq = dx*dx + dy*dy;
+    float boxMinX = std::min(x, x2), boxMaxX = std::max(x, x2);
+    float boxMinY = std::min(y, y2), boxMaxY = std::max(y, y2);
+
+    uint32 i = 0;
+#ifdef DYNLOS_SSE
+    __m128 px = _mm_set1_ps(x), py = _mm_set1_ps(y);
+    __m128 qx = _mm_set1_ps(x2), qy = _mm_set1_ps(y2);
+    __m128 vdx = _mm_set1_ps(dx), vdy = _mm_set1_ps(dy);
+    __m128 vlenSq = _mm_set1_ps(lenSq), vz2 = _mm_set1_ps(z2);
+    __m128 vBoxMinX = _mm_set1_ps(boxMinX), vBoxMaxX = _mm_set1_ps(boxMaxX);
+    __m128 vBoxMinY = _mm_set1_ps(boxMinY), vBoxMaxY = _mm_set1_ps(boxMaxY);
+
+    for (; i + 4 <= count; i += 4)
+    {
+        uint32 a = indices[i], b = indices[i + 1], c = indices[i + 2], d = indices[i + 3];
+        if (!(_active[a] | _active[b] | _active[c] | _active[d]))
+            continue;
+
+        __m128 active = _mm_cmpneq_ps(_mm_set_ps(_active[d], _active[c], _active[b], _active[a]), _mm_setzero_ps());
+        __m128 cx = _mm_set_ps(_x[d], _x[c], _x[b], _x[a]);
+        __m128 cy = _mm_set_ps(_y[d], _y[c], _y[b], _y[a]);
+        __m128 r = _mm_set_ps(_radius[d], _radius[c], _radius[b], _radius[a]);
+        __m128 zMin = _mm_set_ps(_zMin[d], _zMin[c], _zMin[b], _zMin[a]);
+        __m128 zMax = _mm_set_ps(_zMax[d], _zMax[c], _zMax[b], _zMax[a]);
+        __m128 rSq = _mm_mul_ps(r, r);
+
+        __m128 ex = _mm_sub_ps(px, cx), ey = _mm_sub_ps(py, cy);
+        __m128 insideP = _mm_cmplt_ps(_mm_add_ps(_mm_mul_ps(ex, ex), _mm_mul_ps(ey, ey)), rSq);
+        __m128 fx = _mm_sub_ps(qx, cx), fy = _mm_sub_ps(qy, cy);
+        __m128 insideQ = _mm_cmplt_ps(_mm_add_ps(_mm_mul_ps(fx, fx), _mm_mul_ps(fy, fy)), rSq);
+        __m128 inside = _mm_or_ps(insideP, insideQ);
+        __m128 overOrUnder = _mm_and_ps(_mm_cmplt_ps(vz2, zMax), _mm_cmpgt_ps(vz2, zMin));
+
+        __m128 boxHit = _mm_and_ps(
+            _mm_and_ps(_mm_cmpge_ps(vBoxMaxX, _mm_sub_ps(cx, r)), _mm_cmple_ps(vBoxMinX, _mm_add_ps(cx, r))),
+            _mm_and_ps(_mm_cmpge_ps(vBoxMaxY, _mm_sub_ps(cy, r)), _mm_cmple_ps(vBoxMinY, _mm_add_ps(cy, r))));
+        // cross(d, c - p)^2 < r^2 * |d|^2  <=>  distance of the center to the line < r
+        __m128 cross = _mm_sub_ps(_mm_mul_ps(vdx, _mm_sub_ps(cy, py)), _mm_mul_ps(vdy, _mm_sub_ps(cx, px)));
+        __m128 lineHit = _mm_and_ps(boxHit, _mm_cmplt_ps(_mm_mul_ps(cross, cross), _mm_mul_ps(rSq, vlenSq)));
+
+        __m128 blocked = _mm_or_ps(_mm_andnot_ps(overOrUnder, inside), _mm_andnot_ps(inside, lineHit));
+        if (_mm_movemask_ps(_mm_and_ps(active, blocked)))
+            return true;
+    }
+#endif
+
+    for (; i < count; ++i)
+    {
+        uint32 idx = indices[i];
+        if (!_active[idx])
+            continue;
+
+        float cx = _x[idx], cy = _y[idx], r = _radius[idx];
+        float rSq = r*r;
+        if ((x-cx)*(x-cx) + (y-cy)*(y-cy) < rSq || (x2-cx)*(x2-cx) + (y2-cy)*(y2-cy) < rSq)
+        {
+            if (!(z2 < _zMax[idx] && z2 > _zMin[idx]))
+                return true;
+            continue;
+        }
+
+        if (boxMaxX < cx - r || boxMinX > cx + r || boxMaxY < cy - r || boxMinY > cy + r)
+            continue;
+
+        float cross = dx * (cy - y) - dy * (cx - x);
+        if (cross*cross < rSq * lenSq)
+            return true;
+    }
+
+    return false;
+}
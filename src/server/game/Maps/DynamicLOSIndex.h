@@ -0,0 +1,69 @@
+/*
+ * Copyright (C) 2008-2011 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRINITY_DYNAMICLOSINDEX_H
+#define TRINITY_DYNAMICLOSINDEX_H
+
+#include "Define.h"
+#include "UnorderedMap.h"
+#include <vector>
+
+#define DYNLOS_CELL_SIZE            32.0f                   // yards per index cell
+#define DYNLOS_MAX_QUERY_CELLS      64                      // longer segments scan every object instead
+
+// Dynamic line of sight blockers of one map (arena pillars, waterfalls...), modeled as
+// vertical cylinders. Objects are kept as parallel arrays and bucketed into a uniform
+// 2D grid, a LOS query only tests the objects of the cells its segment bounding box
+// touches, four at a time when SSE is available.
+// Ids are handed out sequentially starting at 1 and stay valid for the lifetime of the map.
+class DynamicLOSIndex
+{
+    public:
+        DynamicLOSIndex() {}
+
+        // z == 0 and height == 0 means the object has no height info and blocks at any z
+        uint32 Add(float x, float y, float z, float radius, float height);
+        void SetActiveState(uint32 id, bool state);
+        bool IsActive(uint32 id) const;
+
+        bool empty() const { return _x.empty(); }
+        uint32 size() const { return uint32(_x.size()); }
+
+        // true if no active object blocks the segment
+        bool IsInLOS(float x, float y, float z, float x2, float y2, float z2) const;
+
+    private:
+        typedef std::vector<uint32> IndexList;
+        typedef UNORDERED_MAP<uint64, IndexList> CellMap;
+
+        static int32 _CellCoord(float v);
+        static uint64 _CellKey(int32 cx, int32 cy) { return (uint64(uint32(cx)) << 32) | uint32(cy); }
+
+        bool _IsBlocked(uint32 const* indices, uint32 count, float x, float y, float x2, float y2, float z2) const;
+
+        // object data, index = id - 1
+        std::vector<float> _x;
+        std::vector<float> _y;
+        std::vector<float> _radius;
+        std::vector<float> _zMin;                           // +inf for objects without height info
+        std::vector<float> _zMax;
+        std::vector<uint8> _active;
+
+        CellMap _cells;
+};
+
+#endif
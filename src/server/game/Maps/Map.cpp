@@ -30,12 +30,8 @@
 #include "MapManager.h"
 #include "ObjectMgr.h"
 #include "Group.h"
-
-union u_map_magic
-{
-    char asChar[4];
-    uint32 asUInt;
-};
+#include "TerrainStore.h"
+#include "TickProfiler.h"
 
 u_map_magic MapMagic        = { {'M','A','P','S'} };
 u_map_magic MapVersionMagic = { {'v','1','.','1'} };
@@ -66,6 +62,10 @@ Map::~Map()
 
     if (!m_scriptSchedule.empty())
         sScriptMgr->DecreaseScheduledScriptCount(m_scriptSchedule.size());
+
+    sLog->outDebug(LOG_FILTER_MAPS, "Map %u instance %u query cache: LOS %u hits / %u misses, height %u hits / %u misses, %u invalidations",
+        GetId(), GetInstanceId(), m_queryCache.GetLineOfSightHits(), m_queryCache.GetLineOfSightMisses(),
+        m_queryCache.GetHeightHits(), m_queryCache.GetHeightMisses(), m_queryCache.GetInvalidations());
 }
 
 bool Map::ExistMap(uint32 mapid, int gx, int gy)
@@ -152,6 +152,7 @@ void Map::LoadMap(int gx, int gy, bool reload)
         return;
 
     //map already load, delete it before reloading (Is it necessary? Do we really need the ability the reload maps during runtime?)
+    // the .map file itself stays mapped in sTerrainStore, only the GridMap is rebuilt from it
     if (GridMaps[gx][gy])
     {
         sLog->outDetail("Unloading previously loaded map %u before reloading.", GetId());
@@ -183,6 +184,9 @@ void Map::LoadMapAndVMap(int gx, int gy)
     LoadMap(gx, gy);
     if (i_InstanceId == 0)
         LoadVMap(gx, gy);                                   // Only load the data for the base map
+
+    // queries into this grid may have been answered without its vmap tile
+    m_queryCache.Invalidate();
 }
 
 void Map::InitStateMachine()
@@ -219,14 +223,9 @@ i_scriptLock(false), _creatureToMoveLock(false)
         }
     }
 
-    for (std::map<uint32, DynamicLOSObject*>::iterator i = m_dynamicLOSObjects.begin(); i != m_dynamicLOSObjects.end(); ++i)
-        delete i->second;
-
     //lets initialize visibility distance for map
     Map::InitVisibilityDistance();
 
-    m_dynamicLOSCounter = 0;
-
     sScriptMgr->OnCreateMap(this);
 }
 
@@ -534,16 +533,21 @@ void Map::VisitNearbyCellsOf(WorldObject* obj, TypeContainerVisitor<Trinity::Obj
 
 void Map::Update(const uint32 t_diff)
 {
+    TickProfileScope profile("Map::Update", GetId());
+
     /// update worldsessions for existing players
-    for (m_mapRefIter = m_mapRefManager.begin(); m_mapRefIter != m_mapRefManager.end(); ++m_mapRefIter)
     {
-        Player* plr = m_mapRefIter->getSource();
-        if (plr && plr->IsInWorld())
+        TickProfileScope profileSessions("Map::UpdateSessions", GetId());
+        for (m_mapRefIter = m_mapRefManager.begin(); m_mapRefIter != m_mapRefManager.end(); ++m_mapRefIter)
         {
-            //plr->Update(t_diff);
-            WorldSession* pSession = plr->GetSession();
-            MapSessionFilter updater(pSession);
-            pSession->Update(t_diff, updater);
+            Player* plr = m_mapRefIter->getSource();
+            if (plr && plr->IsInWorld())
+            {
+                //plr->Update(t_diff);
+                WorldSession* pSession = plr->GetSession();
+                MapSessionFilter updater(pSession);
+                pSession->Update(t_diff, updater);
+            }
         }
     }
     /// update active cells around players and active objects
@@ -565,11 +569,21 @@ void Map::Update(const uint32 t_diff)
             continue;
 
         // update players at tick
-        plr->Update(t_diff);
+        {
+            TickProfileScope profilePlayer("Player::Update", plr->GetGUIDLow());
+            plr->Update(t_diff);
+        }
 
+        TickProfileScope profileVisit("Map::VisitNearbyCells", GetId());
         VisitNearbyCellsOf(plr, grid_object_update, world_object_update);
     }
 
+    // autosaves queued by the player updates above
+    {
+        TickProfileScope profileSaves("Map::SavePlayers", GetId());
+        m_saveScheduler.Update(getMSTime(), sWorld->getIntConfig(CONFIG_PLAYER_SAVE_MAX_PER_UPDATE));
+    }
+
     // non-player active objects, increasing iterator in the loop in case of object removal
     for (m_activeNonPlayersIter = m_activeNonPlayers.begin(); m_activeNonPlayersIter != m_activeNonPlayers.end();)
     {
@@ -579,22 +593,38 @@ void Map::Update(const uint32 t_diff)
         if (!obj || !obj->IsInWorld())
             continue;
 
+        TickProfileScope profileVisit("Map::VisitNearbyCells", GetId());
         VisitNearbyCellsOf(obj, grid_object_update, world_object_update);
     }
 
     ///- Process necessary scripts
     if (!m_scriptSchedule.empty())
     {
+        TickProfileScope profileScripts("Map::ScriptsProcess", GetId());
         i_scriptLock = true;
         ScriptsProcess();
         i_scriptLock = false;
     }
 
-    MoveAllCreaturesInMoveList();
+    // transports only move along their path here, leaving the map is deferred to MapManager
+    {
+        TickProfileScope profileTransports("Map::UpdateTransports", GetId());
+        for (TransportSet::const_iterator itr = m_transports.begin(); itr != m_transports.end(); ++itr)
+            (*itr)->Update(t_diff);
+    }
+
+    {
+        TickProfileScope profileMoves("Map::MoveAllCreaturesInMoveList", GetId());
+        MoveAllCreaturesInMoveList();
+    }
 
     if (!m_mapRefManager.isEmpty() || !m_activeNonPlayers.empty())
+    {
+        TickProfileScope profileRelocation("Map::ProcessRelocationNotifies", GetId());
         ProcessRelocationNotifies(t_diff);
+    }
 
+    TickProfileScope profileScriptHooks("ScriptMgr::OnMapUpdate", GetId());
     sScriptMgr->OnMapUpdate(this, t_diff);
 }
 
@@ -689,6 +719,7 @@ void Map::ProcessRelocationNotifies(const uint32 diff)
 
 void Map::RemoveFromMap(Player* player, bool remove)
 {
+    m_saveScheduler.Remove(player);
     player->RemoveFromWorld();
     SendRemoveTransports(player);
 
@@ -1038,6 +1069,7 @@ bool Map::UnloadGrid(const uint32 x, const uint32 y, bool unloadAll)
             ((MapInstanced*)m_parentMap)->RemoveGridMapReference(GridPair(gx, gy));
 
         GridMaps[gx][gy] = NULL;
+        m_queryCache.Invalidate();
     }
     sLog->outStaticDebug("Unloading grid[%u, %u] for map %u finished", x, y, GetId());
     return true;
@@ -1103,61 +1135,35 @@ GridMap::~GridMap()
     unloadData();
 }
 
-bool GridMap::loadData(char *filename)
+bool GridMap::loadData(char const* filename)
 {
     // Unload old data if exist
     unloadData();
 
-    map_fileheader header;
-    // Not return error if file not found
-    FILE* in = fopen(filename, "rb");
-    if (!in)
-        return true;
-
-    if (fread(&header, sizeof(header), 1, in) != 1)
-    {
-        fclose(in);
+    // the file is mapped and validated only once, later loads of the same tile just reuse it
+    TerrainFile const* file = sTerrainStore->GetTerrainFile(filename);
+    if (!file)
         return false;
-    }
 
-    if (header.mapMagic == MapMagic.asUInt && header.versionMagic == MapVersionMagic.asUInt)
+    switch (file->GetState())
     {
-        // loadup area data
-        if (header.areaMapOffset && !loadAreaData(in, header.areaMapOffset, header.areaMapSize))
-        {
-            sLog->outError("Error loading map area data\n");
-            fclose(in);
-            return false;
-        }
-        // loadup height data
-        if (header.heightMapOffset && !loadHeihgtData(in, header.heightMapOffset, header.heightMapSize))
-        {
-            sLog->outError("Error loading map height data\n");
-            fclose(in);
-            return false;
-        }
-        // loadup liquid data
-        if (header.liquidMapOffset && !loadLiquidData(in, header.liquidMapOffset, header.liquidMapSize))
-        {
-            sLog->outError("Error loading map liquids data\n");
-            fclose(in);
+        case TERRAIN_FILE_MISSING:                          // Not return error if file not found
+            return true;
+        case TERRAIN_FILE_INVALID:
             return false;
-        }
-        fclose(in);
-        return true;
+        default:
+            break;
     }
-    sLog->outError("Map file '%s' is from an incompatible clientversion. Please recreate using the mapextractor.", filename);
-    fclose(in);
-    return false;
+
+    loadAreaData(file);
+    loadHeightData(file);
+    loadLiquidData(file);
+    return true;
 }
 
 void GridMap::unloadData()
 {
-    delete[] m_area_map;
-    delete[] m_V9;
-    delete[] m_V8;
-    delete[] m_liquid_type;
-    delete[] m_liquid_map;
+    // data is owned by sTerrainStore and stays mapped for the next load of this tile
     m_area_map = NULL;
     m_V9 = NULL;
     m_V8 = NULL;
@@ -1166,77 +1172,50 @@ void GridMap::unloadData()
     m_gridGetHeight = &GridMap::getHeightFromFlat;
 }
 
-bool GridMap::loadAreaData(FILE* in, uint32 offset, uint32 /*size*/)
+void GridMap::loadAreaData(TerrainFile const* file)
 {
-    map_areaHeader header;
-    fseek(in, offset, SEEK_SET);
-
-    if (fread(&header, sizeof(header), 1, in) != 1 || header.fourcc != MapAreaMagic.asUInt)
-        return false;
-
-    m_gridArea = header.gridArea;
-    if (!(header.flags & MAP_AREA_NO_AREA))
-    {
-        m_area_map = new uint16 [16*16];
-        if (fread(m_area_map, sizeof(uint16), 16*16, in) != 16*16)
-            return false;
-    }
-    return true;
+    m_gridArea = file->GetAreaHeader().gridArea;
+    m_area_map = file->GetAreaMap();
 }
 
-bool GridMap::loadHeihgtData(FILE* in, uint32 offset, uint32 /*size*/)
+void GridMap::loadHeightData(TerrainFile const* file)
 {
-    map_heightHeader header;
-    fseek(in, offset, SEEK_SET);
-
-    if (fread(&header, sizeof(header), 1, in) != 1 || header.fourcc != MapHeightMagic.asUInt)
-        return false;
+    map_heightHeader const& header = file->GetHeightHeader();
 
     m_gridHeight = header.gridHeight;
     if (!(header.flags & MAP_HEIGHT_NO_HEIGHT))
     {
         if ((header.flags & MAP_HEIGHT_AS_INT16))
         {
-            m_uint16_V9 = new uint16 [129*129];
-            m_uint16_V8 = new uint16 [128*128];
-            if (fread(m_uint16_V9, sizeof(uint16), 129*129, in) != 129*129 ||
-                fread(m_uint16_V8, sizeof(uint16), 128*128, in) != 128*128)
-                return false;
+            m_uint16_V9 = static_cast<uint16 const*>(file->GetV9());
+            m_uint16_V8 = static_cast<uint16 const*>(file->GetV8());
             m_gridIntHeightMultiplier = (header.gridMaxHeight - header.gridHeight) / 65535;
             m_gridGetHeight = &GridMap::getHeightFromUint16;
         }
         else if ((header.flags & MAP_HEIGHT_AS_INT8))
         {
-            m_uint8_V9 = new uint8 [129*129];
-            m_uint8_V8 = new uint8 [128*128];
-            if (fread(m_uint8_V9, sizeof(uint8), 129*129, in) != 129*129 ||
-                fread(m_uint8_V8, sizeof(uint8), 128*128, in) != 128*128)
-                return false;
+            m_uint8_V9 = static_cast<uint8 const*>(file->GetV9());
+            m_uint8_V8 = static_cast<uint8 const*>(file->GetV8());
             m_gridIntHeightMultiplier = (header.gridMaxHeight - header.gridHeight) / 255;
             m_gridGetHeight = &GridMap::getHeightFromUint8;
         }
         else
         {
-            m_V9 = new float [129*129];
-            m_V8 = new float [128*128];
-            if (fread(m_V9, sizeof(float), 129*129, in) != 129*129 ||
-                fread(m_V8, sizeof(float), 128*128, in) != 128*128)
-                return false;
+            m_V9 = static_cast<float const*>(file->GetV9());
+            m_V8 = static_cast<float const*>(file->GetV8());
             m_gridGetHeight = &GridMap::getHeightFromFloat;
         }
     }
     else
         m_gridGetHeight = &GridMap::getHeightFromFlat;
-    return true;
 }
 
-bool  GridMap::loadLiquidData(FILE* in, uint32 offset, uint32 /*size*/)
+void GridMap::loadLiquidData(TerrainFile const* file)
 {
-    map_liquidHeader header;
-    fseek(in, offset, SEEK_SET);
+    if (!file->HasLiquidData())
+        return;
 
-    if (fread(&header, sizeof(header), 1, in) != 1 || header.fourcc != MapLiquidMagic.asUInt)
-        return false;
+    map_liquidHeader const& header = file->GetLiquidHeader();
 
     m_liquidType   = header.liquidType;
     m_liquid_offX  = header.offsetX;
@@ -1244,20 +1223,8 @@ bool  GridMap::loadLiquidData(FILE* in, uint32 offset, uint32 /*size*/)
     m_liquid_width = header.width;
     m_liquid_height= header.height;
     m_liquidLevel  = header.liquidLevel;
-
-    if (!(header.flags & MAP_LIQUID_NO_TYPE))
-    {
-        m_liquid_type = new uint8 [16*16];
-        if (fread(m_liquid_type, sizeof(uint8), 16*16, in) != 16*16)
-            return false;
-    }
-    if (!(header.flags & MAP_LIQUID_NO_HEIGHT))
-    {
-        m_liquid_map = new float [m_liquid_width*m_liquid_height];
-        if (fread(m_liquid_map, sizeof(float), m_liquid_width*m_liquid_height, in) != m_liquid_width*m_liquid_height)
-            return false;
-    }
-    return true;
+    m_liquid_type  = file->GetLiquidType();
+    m_liquid_map   = file->GetLiquidMap();
 }
 
 uint16 GridMap::getArea(float x, float y)
@@ -1375,7 +1342,7 @@ float  GridMap::getHeightFromUint8(float x, float y) const
     y_int&=(MAP_RESOLUTION - 1);
 
     int32 a, b, c;
-    uint8 *V9_h1_ptr = &m_uint8_V9[x_int*128 + x_int + y_int];
+    uint8 const* V9_h1_ptr = &m_uint8_V9[x_int*128 + x_int + y_int];
     if (x+y < 1)
     {
         if (x > y)
@@ -1442,7 +1409,7 @@ float  GridMap::getHeightFromUint16(float x, float y) const
     y_int&=(MAP_RESOLUTION - 1);
 
     int32 a, b, c;
-    uint16 *V9_h1_ptr = &m_uint16_V9[x_int*128 + x_int + y_int];
+    uint16 const* V9_h1_ptr = &m_uint16_V9[x_int*128 + x_int + y_int];
     if (x+y < 1)
     {
         if (x > y)
@@ -1623,7 +1590,11 @@ float Map::GetHeight(float x, float y, float z, bool pUseVmaps, float maxSearchD
         if (vmgr->isHeightCalcEnabled())
         {
             // look from a bit higher pos to find the floor
-            vmapHeight = vmgr->getHeight(GetId(), x, y, z + 2.0f, maxSearchDist);
+            if (!m_queryCache.GetHeight(x, y, z, maxSearchDist, vmapHeight))
+            {
+                vmapHeight = vmgr->getHeight(GetId(), x, y, z + 2.0f, maxSearchDist);
+                m_queryCache.StoreHeight(x, y, z, maxSearchDist, vmapHeight);
+            }
         }
         else
             vmapHeight = VMAP_INVALID_HEIGHT_VALUE;
@@ -2730,143 +2701,76 @@ void Map::UpdateIteratorBack(Player* player)
  */
 uint32 Map::AddDynLOSObject(float x, float y, float radius)
 {
-    DynamicLOSObject* obj = new DynamicLOSObject();
-    obj->SetCoordinates(x, y);
-    obj->SetRadius(radius);
-
-    // Add the dynamic object to the map
-    m_dynamicLOSObjects[++m_dynamicLOSCounter] = obj;
-
-    return m_dynamicLOSCounter;
+    return m_dynamicLOS.Add(x, y, 0.0f, radius, 0.0f);
 }
 
 uint32 Map::AddDynLOSObject(float x, float y, float z, float radius, float height)
 {
-    DynamicLOSObject* obj = new DynamicLOSObject();
-    obj->SetCoordinates(x, y);
-    obj->SetZ(z);
-    obj->SetHeight(height);
-    obj->SetRadius(radius);
-
-    // Add the dynamic object to the map
-    m_dynamicLOSObjects[++m_dynamicLOSCounter] = obj;
-
-    return m_dynamicLOSCounter;
+    return m_dynamicLOS.Add(x, y, z, radius, height);
 }
 
 void Map::SetDynLOSObjectState(uint32 id, bool state)
 {
-    std::map<uint32, DynamicLOSObject*>::iterator iter = m_dynamicLOSObjects.find(id);
-    if (iter != m_dynamicLOSObjects.end())
-        iter->second->SetActiveState(state);
+    if (m_dynamicLOS.IsActive(id) == state)
+        return;
+
+    m_dynamicLOS.SetActiveState(id, state);
+    m_queryCache.Invalidate();
 }
 
 bool Map::GetDynLOSObjectState(uint32 id)
 {
-    std::map<uint32, DynamicLOSObject*>::iterator iter = m_dynamicLOSObjects.find(id);
-    if (iter != m_dynamicLOSObjects.end())
-        return (iter->second->IsActive());
-    return false;
+    return m_dynamicLOS.IsActive(id);
 }
 
 bool Map::IsInDynLOS(float x, float y, float z, float x2, float y2, float z2)
 {
-    if (!m_dynamicLOSCounter)
-        return true;
-
-    for (std::map<uint32, DynamicLOSObject*>::iterator iter = m_dynamicLOSObjects.begin(); iter != m_dynamicLOSObjects.end(); ++iter)
-        if (iter->second->IsActive() && iter->second->IsBetween(x, y, z, x2, y2, z2))
-            return false;
-
-    return true;
-}
-
-DynamicLOSObject::DynamicLOSObject()
-{
-    _x = 0.0f;
-    _y = 0.0f;
-    _z = 0.0f;
-    _height = 0.0f;
-    _radius = 0.0f;
-    _active = false;
-}
-
-bool DynamicLOSObject::IsBetween(float x, float y, float z, float x2, float y2, float z2)
-{
-    if (IsInside(x, y) || IsInside(x2, y2))
-    {
-        if(HasHeightInfo() && IsOverOrUnder(z2))
-            return false;
-
-        return true;
-    }
-
-    // For a real handling of Z coord is necessary to do some research from this point
-    // i.e. A player over a huge round plattaform, placed near the edge; and other player placed  down the plattaform at the oposing extreme just next to the edge;
-    // both may be able to attack each other, even when the plattaform height should prevent that.
-    if ((std::max(x, x2) < (_x - _radius))
-        || (std::min(x, x2) > (_x + _radius))
-        || (std::max(y, y2) < (_y - _radius))
-        || (std::min(y, y2) > (_y + _radius)))
-        return false;
-
-
-    float angleToMe = atan2(_x - x, _y - y);
-    angleToMe = (angleToMe >= 0) ? angleToMe : 2 * M_PI + angleToMe;
-
-    float angleToDest = atan2(x2 - x, y2 - y);
-    angleToDest = (angleToDest >= 0) ? angleToDest : 2 * M_PI + angleToDest;
-
-    return (fabs(sin(angleToMe - angleToDest)) * GetDistance(x, y) < _radius);
-}
-
-bool DynamicLOSObject::IsInside(float x, float y)
-{
-    return (((x-_x)*(x-_x)+(y-_y)*(y-_y))<(_radius*_radius));
+    return m_dynamicLOS.IsInLOS(x, y, z, x2, y2, z2);
 }
 
-bool DynamicLOSObject::IsOverOrUnder(float z)
+bool Map::IsInLineOfSight(float x1, float y1, float z1, float x2, float y2, float z2)
 {
-    return ((z < _z+_height) && (z > _z));
-}
+    bool result;
+    if (m_queryCache.GetLineOfSight(x1, y1, z1, x2, y2, z2, result))
+        return result;
 
-float DynamicLOSObject::GetDistance(float x, float y)
-{
-    return sqrtf((x-_x)*(x-_x)+(y-_y)*(y-_y));
-}
+    VMAP::IVMapManager* vMapManager = VMAP::VMapFactory::createOrGetVMapManager();
+    result = vMapManager->isInLineOfSight(GetId(), x1, y1, z1+2.0f, x2, y2, z2+2.0f) && IsInDynLOS(x1, y1, z1, x2, y2, z2);
 
-bool DynamicLOSObject::IsActive()
-{
-    return _active;
+    m_queryCache.StoreLineOfSight(x1, y1, z1, x2, y2, z2, result);
+    return result;
 }
 
-void DynamicLOSObject::SetActiveState(bool state)
+void Map::IsInLineOfSight(float const* segments, uint32 count, bool* results)
 {
-    _active = state;
-}
+    std::vector<uint32> misses;
+    std::vector<float> rays;
+    for (uint32 i = 0; i < count; ++i)
+    {
+        float const* s = segments + i * 6;
+        if (m_queryCache.GetLineOfSight(s[0], s[1], s[2], s[3], s[4], s[5], results[i]))
+            continue;
 
-void DynamicLOSObject::SetCoordinates(float x, float y)
-{
-    _x = x;
-    _y = y;
-}
+        // same eye height offset as the single segment check
+        misses.push_back(i);
+        float const ray[6] = { s[0], s[1], s[2] + 2.0f, s[3], s[4], s[5] + 2.0f };
+        rays.insert(rays.end(), ray, ray + 6);
+    }
 
-void DynamicLOSObject::SetRadius(float r)
-{
-    _radius = r;
-}
+    if (misses.empty())
+        return;
 
-void DynamicLOSObject::SetZ(float z)
-{
-    _z = z;
-}
+    bool* vmapResults = new bool[misses.size()];
+    VMAP::IVMapManager* vMapManager = VMAP::VMapFactory::createOrGetVMapManager();
+    vMapManager->isInLineOfSight(GetId(), &rays[0], misses.size(), vmapResults);
 
-void DynamicLOSObject::SetHeight(float h)
-{
-    _height = h;
-}
+    for (uint32 i = 0; i < misses.size(); ++i)
+    {
+        float const* s = segments + misses[i] * 6;
+        bool result = vmapResults[i] && IsInDynLOS(s[0], s[1], s[2], s[3], s[4], s[5]);
+        m_queryCache.StoreLineOfSight(s[0], s[1], s[2], s[3], s[4], s[5], result);
+        results[misses[i]] = result;
+    }
 
-bool DynamicLOSObject::HasHeightInfo()
-{
-    return (_z != 0 || _height != 0);
+    delete[] vmapResults;
 }
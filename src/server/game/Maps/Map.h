@@ -30,6 +30,9 @@
 #include "SharedDefines.h"
 #include "GridRefManager.h"
 #include "MapRefManager.h"
+#include "MapQueryCache.h"
+#include "DynamicLOSIndex.h"
+#include "PlayerSaveScheduler.h"
 
 #include <bitset>
 #include <list>
@@ -50,6 +53,7 @@ struct Position;
 class Battleground;
 class MapInstanced;
 class InstanceMap;
+class Transport;
 namespace Trinity { struct ObjectUpdater; }
 
 struct ScriptAction
@@ -63,6 +67,18 @@ struct ScriptAction
 // ******************************************
 // Map file format defines
 // ******************************************
+union u_map_magic
+{
+    char asChar[4];
+    uint32 asUInt;
+};
+
+extern u_map_magic MapMagic;
+extern u_map_magic MapVersionMagic;
+extern u_map_magic MapAreaMagic;
+extern u_map_magic MapHeightMagic;
+extern u_map_magic MapLiquidMagic;
+
 struct map_fileheader
 {
     uint32 mapMagic;
@@ -139,24 +155,27 @@ struct LiquidData
     float  depth_level;
 };
 
+class TerrainFile;
+
+// All data arrays point into a TerrainFile owned by sTerrainStore, GridMap itself owns no terrain memory
 class GridMap
 {
     uint32  m_flags;
     // Area data
     uint16  m_gridArea;
-    uint16 *m_area_map;
+    uint16 const *m_area_map;
     // Height level data
     float   m_gridHeight;
     float   m_gridIntHeightMultiplier;
     union{
-        float  *m_V9;
-        uint16 *m_uint16_V9;
-        uint8  *m_uint8_V9;
+        float  const *m_V9;
+        uint16 const *m_uint16_V9;
+        uint8  const *m_uint8_V9;
     };
     union{
-        float  *m_V8;
-        uint16 *m_uint16_V8;
-        uint8  *m_uint8_V8;
+        float  const *m_V8;
+        uint16 const *m_uint16_V8;
+        uint8  const *m_uint8_V8;
     };
     // Liquid data
     uint16  m_liquidType;
@@ -165,12 +184,12 @@ class GridMap
     uint8   m_liquid_width;
     uint8   m_liquid_height;
     float   m_liquidLevel;
-    uint8  *m_liquid_type;
-    float  *m_liquid_map;
+    uint8  const *m_liquid_type;
+    float  const *m_liquid_map;
 
-    bool  loadAreaData(FILE* in, uint32 offset, uint32 size);
-    bool  loadHeihgtData(FILE* in, uint32 offset, uint32 size);
-    bool  loadLiquidData(FILE* in, uint32 offset, uint32 size);
+    void  loadAreaData(TerrainFile const* file);
+    void  loadHeightData(TerrainFile const* file);
+    void  loadLiquidData(TerrainFile const* file);
 
     // Get height functions and pointers
     typedef float (GridMap::*pGetHeightPtr) (float x, float y) const;
@@ -183,7 +202,7 @@ class GridMap
 public:
     GridMap();
     ~GridMap();
-    bool  loadData(char *filaname);
+    bool  loadData(char const* filename);
     void  unloadData();
 
     uint16 getArea(float x, float y);
@@ -200,30 +219,6 @@ public:
 #pragma pack(push, 1)
 #endif
 
-class DynamicLOSObject
-{
-    public:
-        DynamicLOSObject();
-        bool IsBetween(float x, float y, float z, float x2, float y2, float z2);
-        bool IsInside(float x, float y);
-        bool IsOverOrUnder(float z);
-        float GetDistance(float x, float y);
-        bool IsActive();
-        void SetActiveState(bool state);
-        void SetCoordinates(float x, float y);
-        void SetZ(float z);
-        void SetRadius(float r);
-        void SetHeight(float h);
-        bool HasHeightInfo();
-    private:
-        float _x;
-        float _y;
-        float _z;
-        float _height;
-        float _radius;
-        bool _active;
-};
-
 struct InstanceTemplate
 {
     uint32 Parent;
@@ -460,10 +455,28 @@ class Map : public GridRefManager<NGridType>
         void SetDynLOSObjectState(uint32 id, bool state);
         bool GetDynLOSObjectState(uint32 id);
         bool IsInDynLOS(float x, float y, float z, float x2, float y2, float z2);
+
+        // static (vmap) and dynamic line of sight, answered from the query cache when possible
+        bool IsInLineOfSight(float x1, float y1, float z1, float x2, float y2, float z2);
+        // the same for count segments (x1, y1, z1, x2, y2, z2 each), cache misses are traced together
+        void IsInLineOfSight(float const* segments, uint32 count, bool* results);
+        void InvalidateQueryCache() { m_queryCache.Invalidate(); }
+        MapQueryCache const& GetQueryCache() const { return m_queryCache; }
     private:
-        std::map<uint32, DynamicLOSObject*> m_dynamicLOSObjects;
-        uint32 m_dynamicLOSCounter;
+        DynamicLOSIndex m_dynamicLOS;
+        mutable MapQueryCache m_queryCache;
     /* END */
+    public:
+        // transports moving on this map, they are updated together with the map
+        void AddTransport(Transport* transport) { m_transports.insert(transport); }
+        void RemoveTransport(Transport* transport) { m_transports.erase(transport); }
+    private:
+        typedef std::set<Transport*> TransportSet;
+        TransportSet m_transports;
+    public:
+        PlayerSaveScheduler& GetPlayerSaveScheduler() { return m_saveScheduler; }
+    private:
+        PlayerSaveScheduler m_saveScheduler;
     private:
         void LoadMapAndVMap(int gx, int gy);
         void LoadVMap(int gx, int gy);
@@ -34,6 +34,8 @@
 #include "Language.h"
 #include "WorldPacket.h"
 #include "Group.h"
+#include "TerrainStore.h"
+#include "TickProfiler.h"
 
 extern GridState* si_GridStates[];                          // debugging code, should be deleted some day
 
@@ -265,6 +267,8 @@ void MapManager::Update(uint32 diff)
     if (!i_timer.Passed())
         return;
 
+    TickProfileScope profile("MapManager::Update");
+
     MapMapType::iterator iter = i_maps.begin();
     for (; iter != i_maps.end(); ++iter)
     {
@@ -274,14 +278,26 @@ void MapManager::Update(uint32 diff)
             iter->second->Update(uint32(i_timer.GetCurrent()));
     }
     if (m_updater.activated())
+    {
+        TickProfileScope profileWait("MapUpdater::wait");
         m_updater.wait();
+    }
 
-    for (iter = i_maps.begin(); iter != i_maps.end(); ++iter)
-        iter->second->DelayedUpdate(uint32(i_timer.GetCurrent()));
+    {
+        TickProfileScope profileDelayed("Map::DelayedUpdate");
+        for (iter = i_maps.begin(); iter != i_maps.end(); ++iter)
+            iter->second->DelayedUpdate(uint32(i_timer.GetCurrent()));
+    }
 
-    sObjectAccessor->Update(uint32(i_timer.GetCurrent()));
+    {
+        TickProfileScope profileAccessor("ObjectAccessor::Update");
+        sObjectAccessor->Update(uint32(i_timer.GetCurrent()));
+    }
+
+    // transports are moved by their maps, only the map changes are done here
+    TickProfileScope profileTransports("Transport::DoPendingTeleport");
     for (TransportSet::iterator iter = m_Transports.begin(); iter != m_Transports.end(); ++iter)
-        (*iter)->Update(uint32(i_timer.GetCurrent()));
+        (*iter)->DoPendingTeleport();
 
     i_timer.SetCurrent(0);
 }
@@ -316,6 +332,7 @@ void MapManager::UnloadAll()
 {
     for (TransportSet::iterator i = m_Transports.begin(); i != m_Transports.end(); ++i)
     {
+        (*i)->GetMap()->RemoveTransport(*i);
         (*i)->RemoveFromWorld();
         delete *i;
     }
@@ -327,6 +344,9 @@ void MapManager::UnloadAll()
         i_maps.erase(iter++);
     }
 
+    // all GridMaps are gone, terrain files can be unmapped now
+    sTerrainStore->UnloadAll();
+
     if (m_updater.activated())
         m_updater.deactivate();
 
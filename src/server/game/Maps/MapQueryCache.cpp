@@ -0,0 +1,132 @@
+/*
+ * Copyright (C) 2008-2011 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "MapQueryCache.h"
+#include "Common.h"
+
+#define LOS_ENTRY_VALID     0x2
+#define LOS_ENTRY_RESULT    0x1
+
+namespace
+{
+    inline uint64 MixKey(uint64 h, float v)
+    {
+        h ^= uint32(int32(floor(v * MAP_QUERY_CACHE_PRECISION)));
+        h *= UI64LIT(0xff51afd7ed558ccd);
+        return h ^ (h >> 33);
+    }
+
+    inline uint32 SlotOf(uint64 key)
+    {
+        return uint32(key >> 32) & (MAP_QUERY_CACHE_SLOTS - 1);
+    }
+
+    // differs from the stored check word unless tag and height come from the same store
+    inline uint32 HeightCheck(uint32 tag, uint32 bits)
+    {
+        return (tag ^ bits) * 0x9e3779b1;
+    }
+}
+
+MapQueryCache::MapQueryCache() : _generation(0), _losHits(0), _losMisses(0), _heightHits(0), _heightMisses(0), _invalidations(0)
+{
+    for (uint32 i = 0; i < MAP_QUERY_CACHE_SLOTS; ++i)
+    {
+        _los[i] = 0;
+        _height[i].Tag = 0;
+        _height[i].Height = 0;
+        _height[i].Check = 0;
+    }
+}
+
+uint64 MapQueryCache::_LineOfSightKey(float x1, float y1, float z1, float x2, float y2, float z2) const
+{
+    uint64 h = UI64LIT(0x9e3779b97f4a7c15) ^ _generation;
+    h = MixKey(h, x1);
+    h = MixKey(h, y1);
+    h = MixKey(h, z1);
+    h = MixKey(h, x2);
+    h = MixKey(h, y2);
+    return MixKey(h, z2);
+}
+
+uint64 MapQueryCache::_HeightKey(float x, float y, float z, float maxSearchDist) const
+{
+    uint64 h = UI64LIT(0xc2b2ae3d27d4eb4f) ^ _generation;
+    h = MixKey(h, x);
+    h = MixKey(h, y);
+    h = MixKey(h, z);
+    return MixKey(h, maxSearchDist);
+}
+
+bool MapQueryCache::GetLineOfSight(float x1, float y1, float z1, float x2, float y2, float z2, bool& result)
+{
+    uint64 key = _LineOfSightKey(x1, y1, z1, x2, y2, z2);
+    uint32 entry = _los[SlotOf(key)];
+
+    if ((entry & ~LOS_ENTRY_RESULT) != ((uint32(key) & ~(LOS_ENTRY_VALID | LOS_ENTRY_RESULT)) | LOS_ENTRY_VALID))
+    {
+        ++_losMisses;
+        return false;
+    }
+
+    result = (entry & LOS_ENTRY_RESULT) != 0;
+    ++_losHits;
+    return true;
+}
+
+void MapQueryCache::StoreLineOfSight(float x1, float y1, float z1, float x2, float y2, float z2, bool result)
+{
+    uint64 key = _LineOfSightKey(x1, y1, z1, x2, y2, z2);
+    _los[SlotOf(key)] = (uint32(key) & ~(LOS_ENTRY_VALID | LOS_ENTRY_RESULT)) | LOS_ENTRY_VALID | (result ? LOS_ENTRY_RESULT : 0);
+}
+
+bool MapQueryCache::GetHeight(float x, float y, float z, float maxSearchDist, float& height)
+{
+    uint64 key = _HeightKey(x, y, z, maxSearchDist);
+    HeightEntry const& entry = _height[SlotOf(key)];
+
+    // read every word once, a concurrent store may replace them in between
+    uint32 tag = entry.Tag;
+    uint32 bits = entry.Height;
+    uint32 check = entry.Check;
+
+    // the tag is never 0 so empty slots do not match
+    if (tag != (uint32(key) | 1) || check != HeightCheck(tag, bits))
+    {
+        ++_heightMisses;
+        return false;
+    }
+
+    memcpy(&height, &bits, sizeof(height));
+    ++_heightHits;
+    return true;
+}
+
+void MapQueryCache::StoreHeight(float x, float y, float z, float maxSearchDist, float height)
+{
+    uint64 key = _HeightKey(x, y, z, maxSearchDist);
+    HeightEntry& entry = _height[SlotOf(key)];
+
+    uint32 tag = uint32(key) | 1;
+    uint32 bits;
+    memcpy(&bits, &height, sizeof(bits));
+
+    entry.Tag = tag;
+    entry.Height = bits;
+    entry.Check = HeightCheck(tag, bits);
+}
@@ -0,0 +1,76 @@
+/*
+ * Copyright (C) 2008-2011 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRINITY_MAPQUERYCACHE_H
+#define TRINITY_MAPQUERYCACHE_H
+
+#include "Define.h"
+
+#define MAP_QUERY_CACHE_SLOTS       2048                    // per table, must be a power of two
+#define MAP_QUERY_CACHE_PRECISION   4.0f                    // coordinates are quantized to 1/4 yard
+
+// Small direct mapped cache for line of sight and vmap height results of one map.
+// Lookups and stores need no lock although several map update threads share the cache,
+// so no entry relies on a 64 bit access being atomic (it is not on 32 bit builds):
+// a line of sight entry is one 32 bit word holding tag and result, a height entry holds
+// tag, height and a check word computed from both, and a reader that sees the words of
+// two different stores fails the check and treats the slot as a miss.
+// Invalidate() only bumps the generation which is mixed into every key, old entries
+// then simply stop matching and get overwritten over time.
+class MapQueryCache
+{
+    public:
+        MapQueryCache();
+
+        bool GetLineOfSight(float x1, float y1, float z1, float x2, float y2, float z2, bool& result);
+        void StoreLineOfSight(float x1, float y1, float z1, float x2, float y2, float z2, bool result);
+
+        bool GetHeight(float x, float y, float z, float maxSearchDist, float& height);
+        void StoreHeight(float x, float y, float z, float maxSearchDist, float height);
+
+        void Invalidate() { ++_generation; ++_invalidations; }
+
+        // statistics only, updated without synchronization
+        uint32 GetLineOfSightHits() const { return _losHits; }
+        uint32 GetLineOfSightMisses() const { return _losMisses; }
+        uint32 GetHeightHits() const { return _heightHits; }
+        uint32 GetHeightMisses() const { return _heightMisses; }
+        uint32 GetInvalidations() const { return _invalidations; }
+
+    private:
+        uint64 _LineOfSightKey(float x1, float y1, float z1, float x2, float y2, float z2) const;
+        uint64 _HeightKey(float x, float y, float z, float maxSearchDist) const;
+
+        struct HeightEntry
+        {
+            volatile uint32 Tag;
+            volatile uint32 Height;
+            volatile uint32 Check;
+        };
+
+        volatile uint32 _los[MAP_QUERY_CACHE_SLOTS];
+        HeightEntry _height[MAP_QUERY_CACHE_SLOTS];
+        volatile uint32 _generation;
+
+        uint32 _losHits;
+        uint32 _losMisses;
+        uint32 _heightHits;
+        uint32 _heightMisses;
+        uint32 _invalidations;
+};
+
+#endif
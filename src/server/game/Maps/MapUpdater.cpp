@@ -2,6 +2,7 @@
 #include "DelayExecutor.h"
 #include "Map.h"
 #include "DatabaseEnv.h"
+#include "TickProfiler.h"
 
 #include <ace/Guard_T.h>
 #include <ace/Method_Request.h>
@@ -41,16 +42,21 @@ class MapUpdateRequest : public ACE_Method_Request
         Map& m_map;
         MapUpdater& m_updater;
         ACE_UINT32 m_diff;
+        uint64 m_scheduled;
 
     public:
 
         MapUpdateRequest(Map& m, MapUpdater& u, ACE_UINT32 d)
-            : m_map(m), m_updater(u), m_diff(d)
+            : m_map(m), m_updater(u), m_diff(d), m_scheduled(sTickProfiler->IsEnabled() ? TickProfiler::Now() : 0)
         {
         }
 
         virtual int call()
         {
+            // time spent in the queue until a map thread picked the request up
+            if (m_scheduled)
+                sTickProfiler->Record("MapUpdater::Queue", m_map.GetId(), m_scheduled, uint32(TickProfiler::Now() - m_scheduled));
+
             m_map.Update (m_diff);
             m_updater.update_finished ();
             return 0;
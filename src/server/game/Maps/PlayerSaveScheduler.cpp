@@ -0,0 +1,90 @@
+/*
+ * Copyright (C) 2008-2011 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "PlayerSaveScheduler.h"
+#include "Player.h"
+#include "Timer.h"
+#include "Log.h"
+#include <algorithm>
+
+void PlayerSaveScheduler::Enqueue(Player* player, uint32 now)
+{
+    // the save timer is 0 while queued, Player::Update does not queue twice
+    player->SetSaveTimer(0);
+    _queue.push_back(QueuedSave(player, now));
+}
+
+void PlayerSaveScheduler::Remove(Player* player)
+{
+    for (std::vector<QueuedSave>::iterator itr = _queue.begin(); itr != _queue.end(); ++itr)
+    {
+        if (itr->player != player)
+            continue;
+
+        // not saved yet, let the next map queue it again right away
+        if (!player->GetSaveTimer())
+            player->SetSaveTimer(1);
+        _queue.erase(itr);
+        return;
+    }
+}
+
+void PlayerSaveScheduler::Update(uint32 now, uint32 maxSaves)
+{
+    if (_queue.empty())
+        return;
+
+    if (!maxSaves || _queue.size() <= maxSaves)
+    {
+        for (std::vector<QueuedSave>::const_iterator itr = _queue.begin(); itr != _queue.end(); ++itr)
+            _Save(*itr, now);
+        _queue.clear();
+        return;
+    }
+
+    for (std::vector<QueuedSave>::iterator itr = _queue.begin(); itr != _queue.end(); ++itr)
+        itr->priority = itr->player->GetPendingSaveChangeCount() + getMSTimeDiff(itr->queueTime, now) / IN_MILLISECONDS;
+
+    std::nth_element(_queue.begin(), _queue.begin() + maxSaves, _queue.end());
+    for (uint32 i = 0; i < maxSaves; ++i)
+        _Save(_queue[i], now);
+    _queue.erase(_queue.begin(), _queue.begin() + maxSaves);
+
+    _deferred += _queue.size();
+    sLog->outDebug(LOG_FILTER_MAPS, "PlayerSaveScheduler: %u player saves postponed to the next map update", uint32(_queue.size()));
+}
+
+void PlayerSaveScheduler::_Save(QueuedSave const& entry, uint32 now)
+{
+    Player* player = entry.player;
+
+    // saved in between (logout, .save), SaveToDB restarted the timer already
+    if (player->GetSaveTimer())
+        return;
+
+    _maxWait = std::max(_maxWait, getMSTimeDiff(entry.queueTime, now));
+
+    uint32 startTime = getMSTime();
+    player->SaveToDB();
+    uint32 saveTime = getMSTimeDiff(startTime, getMSTime());
+
+    ++_saved;
+    _totalSaveTime += saveTime;
+    _maxSaveTime = std::max(_maxSaveTime, saveTime);
+
+    sLog->outDetail("Player '%s' (GUID: %u) saved", player->GetName(), player->GetGUIDLow());
+}
@@ -0,0 +1,72 @@
+/*
+ * Copyright (C) 2008-2011 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRINITY_PLAYERSAVESCHEDULER_H
+#define TRINITY_PLAYERSAVESCHEDULER_H
+
+#include "Define.h"
+#include <vector>
+
+class Player;
+
+// Autosaves of the players of one map. Player::Update only queues the player once its save
+// timer expires, Map::Update then saves at most PlayerSave.MaxPerMapUpdate of the queued
+// players per tick so that mass logins or restarts do not run thousands of saves in the
+// same tick. The players with most unsaved changes go first, every second spent waiting
+// counts as one change so nobody is starved.
+// Only used from the thread updating the map.
+class PlayerSaveScheduler
+{
+    public:
+        PlayerSaveScheduler() : _saved(0), _deferred(0), _maxWait(0), _totalSaveTime(0), _maxSaveTime(0) {}
+
+        void Enqueue(Player* player, uint32 now);
+        void Remove(Player* player);
+        void Update(uint32 now, uint32 maxSaves);
+
+        // statistics
+        uint32 GetQueueSize() const { return uint32(_queue.size()); }
+        uint32 GetSavedCount() const { return _saved; }
+        uint32 GetDeferredCount() const { return _deferred; }     // saves postponed by the per tick cap
+        uint32 GetMaxWaitTime() const { return _maxWait; }        // ms between the timer expiring and the save
+        uint32 GetAverageSaveTime() const { return _saved ? uint32(_totalSaveTime / _saved) : 0; }
+        uint32 GetMaxSaveTime() const { return _maxSaveTime; }
+
+    private:
+        struct QueuedSave
+        {
+            QueuedSave(Player* player, uint32 queueTime) : player(player), queueTime(queueTime), priority(0) {}
+
+            bool operator<(QueuedSave const& right) const { return priority > right.priority; }
+
+            Player* player;
+            uint32 queueTime;
+            uint32 priority;
+        };
+
+        void _Save(QueuedSave const& entry, uint32 now);
+
+        std::vector<QueuedSave> _queue;
+
+        uint32 _saved;
+        uint32 _deferred;
+        uint32 _maxWait;
+        uint64 _totalSaveTime;
+        uint32 _maxSaveTime;
+};
+
+#endif
@@ -0,0 +1,194 @@
+/*
+ * Copyright (C) 2008-2011 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "TerrainStore.h"
+#include "Log.h"
+
+TerrainFile::TerrainFile(std::string const& filename) : _filename(filename), _state(TERRAIN_FILE_INVALID),
+    _areaMap(NULL), _V9(NULL), _V8(NULL), _hasLiquid(false), _liquidType(NULL), _liquidMap(NULL)
+{
+    memset(&_areaHeader, 0, sizeof(_areaHeader));
+    memset(&_heightHeader, 0, sizeof(_heightHeader));
+    memset(&_liquidHeader, 0, sizeof(_liquidHeader));
+    _heightHeader.flags = MAP_HEIGHT_NO_HEIGHT;
+    _heightHeader.gridHeight = INVALID_HEIGHT;
+    _liquidHeader.liquidLevel = INVALID_HEIGHT;
+
+    if (_map.map(filename.c_str(), static_cast<size_t>(-1), O_RDONLY, ACE_DEFAULT_FILE_PERMS, PROT_READ, ACE_MAP_PRIVATE) == -1)
+    {
+        // Not an error if file not found
+        if (ACE_OS::last_error() == ENOENT)
+            _state = TERRAIN_FILE_MISSING;
+        return;
+    }
+
+    map_fileheader header;
+    if (!_ReadHeader(0, &header, sizeof(header)))
+        return;
+
+    if (header.mapMagic != MapMagic.asUInt || header.versionMagic != MapVersionMagic.asUInt)
+    {
+        sLog->outError("Map file '%s' is from an incompatible clientversion. Please recreate using the mapextractor.", filename.c_str());
+        return;
+    }
+
+    // loadup area data
+    if (header.areaMapOffset && !_LoadAreaData(header.areaMapOffset))
+    {
+        sLog->outError("Error loading map area data\n");
+        return;
+    }
+    // loadup height data
+    if (header.heightMapOffset && !_LoadHeightData(header.heightMapOffset))
+    {
+        sLog->outError("Error loading map height data\n");
+        return;
+    }
+    // loadup liquid data
+    if (header.liquidMapOffset && !_LoadLiquidData(header.liquidMapOffset))
+    {
+        sLog->outError("Error loading map liquids data\n");
+        return;
+    }
+
+    _state = TERRAIN_FILE_LOADED;
+}
+
+TerrainFile::~TerrainFile()
+{
+    for (std::list<uint8*>::iterator itr = _alignedCopies.begin(); itr != _alignedCopies.end(); ++itr)
+        delete[] *itr;
+
+    _map.close();
+}
+
+bool TerrainFile::_ReadHeader(uint32 offset, void* header, size_t size) const
+{
+    if (size_t(offset) + size > _map.size())
+        return false;
+
+    // headers are not necessarily aligned inside the file
+    memcpy(header, static_cast<uint8 const*>(_map.addr()) + offset, size);
+    return true;
+}
+
+template<class T>
+T const* TerrainFile::_GetArray(uint32 offset, uint32 count)
+{
+    size_t size = size_t(count) * sizeof(T);
+    if (size_t(offset) + size > _map.size())
+        return NULL;
+
+    uint8 const* data = static_cast<uint8 const*>(_map.addr()) + offset;
+    if ((reinterpret_cast<size_t>(data) % sizeof(T)) == 0)
+        return reinterpret_cast<T const*>(data);
+
+    // sections following uint8 height data are misaligned, keep a private copy of those
+    uint8* copy = new uint8[size];
+    memcpy(copy, data, size);
+    _alignedCopies.push_back(copy);
+    return reinterpret_cast<T const*>(copy);
+}
+
+bool TerrainFile::_LoadAreaData(uint32 offset)
+{
+    if (!_ReadHeader(offset, &_areaHeader, sizeof(_areaHeader)) || _areaHeader.fourcc != MapAreaMagic.asUInt)
+        return false;
+
+    if (!(_areaHeader.flags & MAP_AREA_NO_AREA))
+    {
+        _areaMap = _GetArray<uint16>(offset + sizeof(_areaHeader), 16*16);
+        if (!_areaMap)
+            return false;
+    }
+    return true;
+}
+
+bool TerrainFile::_LoadHeightData(uint32 offset)
+{
+    if (!_ReadHeader(offset, &_heightHeader, sizeof(_heightHeader)) || _heightHeader.fourcc != MapHeightMagic.asUInt)
+        return false;
+
+    if (_heightHeader.flags & MAP_HEIGHT_NO_HEIGHT)
+        return true;
+
+    offset += sizeof(_heightHeader);
+    if (_heightHeader.flags & MAP_HEIGHT_AS_INT16)
+    {
+        _V9 = _GetArray<uint16>(offset, 129*129);
+        _V8 = _GetArray<uint16>(offset + 129*129*sizeof(uint16), 128*128);
+    }
+    else if (_heightHeader.flags & MAP_HEIGHT_AS_INT8)
+    {
+        _V9 = _GetArray<uint8>(offset, 129*129);
+        _V8 = _GetArray<uint8>(offset + 129*129*sizeof(uint8), 128*128);
+    }
+    else
+    {
+        _V9 = _GetArray<float>(offset, 129*129);
+        _V8 = _GetArray<float>(offset + 129*129*sizeof(float), 128*128);
+    }
+
+    return _V9 && _V8;
+}
+
+bool TerrainFile::_LoadLiquidData(uint32 offset)
+{
+    if (!_ReadHeader(offset, &_liquidHeader, sizeof(_liquidHeader)) || _liquidHeader.fourcc != MapLiquidMagic.asUInt)
+        return false;
+
+    _hasLiquid = true;
+    offset += sizeof(_liquidHeader);
+
+    if (!(_liquidHeader.flags & MAP_LIQUID_NO_TYPE))
+    {
+        _liquidType = _GetArray<uint8>(offset, 16*16);
+        if (!_liquidType)
+            return false;
+        offset += 16*16*sizeof(uint8);
+    }
+    if (!(_liquidHeader.flags & MAP_LIQUID_NO_HEIGHT))
+    {
+        _liquidMap = _GetArray<float>(offset, _liquidHeader.width*_liquidHeader.height);
+        if (!_liquidMap)
+            return false;
+    }
+    return true;
+}
+
+TerrainFile const* TerrainStore::GetTerrainFile(std::string const& filename)
+{
+    ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, _lock, NULL);
+
+    TerrainFileMap::const_iterator itr = _files.find(filename);
+    if (itr != _files.end())
+        return itr->second;
+
+    TerrainFile* file = new TerrainFile(filename);
+    _files[filename] = file;
+    return file;
+}
+
+void TerrainStore::UnloadAll()
+{
+    ACE_GUARD(ACE_Thread_Mutex, guard, _lock);
+
+    for (TerrainFileMap::iterator itr = _files.begin(); itr != _files.end(); ++itr)
+        delete itr->second;
+
+    _files.clear();
+}
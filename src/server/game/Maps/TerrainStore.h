@@ -0,0 +1,109 @@
+/*
+ * Copyright (C) 2008-2011 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRINITY_TERRAINSTORE_H
+#define TRINITY_TERRAINSTORE_H
+
+#include "Define.h"
+#include "Common.h"
+#include "Map.h"
+#include <ace/Singleton.h>
+#include <ace/Thread_Mutex.h>
+#include <ace/Mem_Map.h>
+
+enum TerrainFileState
+{
+    TERRAIN_FILE_MISSING,                                   // no .map file for this tile, not an error
+    TERRAIN_FILE_INVALID,                                   // file exists but is broken or from another client version
+    TERRAIN_FILE_LOADED
+};
+
+// One maps/XXXYYZZ.map file, mapped read-only. All section pointers point into the mapping
+// (or into a private aligned copy if the extractor left a section misaligned) and stay valid
+// until the file is released from the TerrainStore.
+class TerrainFile
+{
+    public:
+        explicit TerrainFile(std::string const& filename);
+        ~TerrainFile();
+
+        TerrainFileState GetState() const { return _state; }
+        std::string const& GetFileName() const { return _filename; }
+        size_t GetMappedSize() const { return _map.size(); }
+
+        // Area data
+        map_areaHeader const& GetAreaHeader() const { return _areaHeader; }
+        uint16 const* GetAreaMap() const { return _areaMap; }
+        // Height data, V9/V8 element type depends on GetHeightHeader().flags
+        map_heightHeader const& GetHeightHeader() const { return _heightHeader; }
+        void const* GetV9() const { return _V9; }
+        void const* GetV8() const { return _V8; }
+        // Liquid data
+        bool HasLiquidData() const { return _hasLiquid; }
+        map_liquidHeader const& GetLiquidHeader() const { return _liquidHeader; }
+        uint8 const* GetLiquidType() const { return _liquidType; }
+        float const* GetLiquidMap() const { return _liquidMap; }
+
+    private:
+        bool _LoadAreaData(uint32 offset);
+        bool _LoadHeightData(uint32 offset);
+        bool _LoadLiquidData(uint32 offset);
+
+        bool _ReadHeader(uint32 offset, void* header, size_t size) const;
+        template<class T> T const* _GetArray(uint32 offset, uint32 count);
+
+        std::string _filename;
+        TerrainFileState _state;
+        ACE_Mem_Map _map;
+        std::list<uint8*> _alignedCopies;
+
+        map_areaHeader _areaHeader;
+        uint16 const* _areaMap;
+        map_heightHeader _heightHeader;
+        void const* _V9;
+        void const* _V8;
+        bool _hasLiquid;
+        map_liquidHeader _liquidHeader;
+        uint8 const* _liquidType;
+        float const* _liquidMap;
+};
+
+// Process wide cache of mapped terrain files. A file is opened and parsed once, after that
+// grid loads of any map instance only copy pointers from it; the pages themselves are backed
+// by the page cache and shared between every user of the tile.
+class TerrainStore
+{
+    friend class ACE_Singleton<TerrainStore, ACE_Thread_Mutex>;
+
+    public:
+        // Returns NULL only if the store lock cannot be taken, otherwise check GetState() of the result.
+        TerrainFile const* GetTerrainFile(std::string const& filename);
+
+        void UnloadAll();
+
+    private:
+        TerrainStore() {}
+        ~TerrainStore() { UnloadAll(); }
+
+        typedef UNORDERED_MAP<std::string, TerrainFile*> TerrainFileMap;
+        TerrainFileMap _files;
+        ACE_Thread_Mutex _lock;
+};
+
+#define sTerrainStore ACE_Singleton<TerrainStore, ACE_Thread_Mutex>::instance()
+
+#endif
@@ -0,0 +1,60 @@
+/*
+ * Copyright (C) 2008-2011 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "MovementRelayFilter.h"
+#include "Opcodes.h"
+#include "Timer.h"
+#include "World.h"
+
+#define MOVEMENT_RELAY_PURGE_INTERVAL   10000               // ms, entries of movers not relayed for that long are dropped
+
+bool MovementRelayFilter::ShouldRelay(uint64 moverGuid, uint16 opcode, float distSq, uint32 now)
+{
+    float nearDist = sWorld->getFloatConfig(CONFIG_MOVEMENT_RELAY_NEAR_DISTANCE);
+    if (distSq <= nearDist * nearDist)
+        return true;
+
+    float farDist = sWorld->getFloatConfig(CONFIG_MOVEMENT_RELAY_FAR_DISTANCE);
+    uint32 interval = sWorld->getIntConfig(distSq <= farDist * farDist ? CONFIG_MOVEMENT_RELAY_MID_INTERVAL : CONFIG_MOVEMENT_RELAY_FAR_INTERVAL);
+
+    if (int32(now - _nextPurge) >= 0)
+        _Purge(now);
+
+    if (opcode == MSG_MOVE_HEARTBEAT && interval)
+    {
+        RelayTimeMap::iterator itr = _lastRelay.find(moverGuid);
+        if (itr != _lastRelay.end() && getMSTimeDiff(itr->second, now) < interval)
+            return false;
+    }
+
+    // state changes restart the interval too, the next heartbeat adds nothing the client cannot extrapolate
+    _lastRelay[moverGuid] = now;
+    return true;
+}
+
+void MovementRelayFilter::_Purge(uint32 now)
+{
+    for (RelayTimeMap::iterator itr = _lastRelay.begin(); itr != _lastRelay.end();)
+    {
+        if (getMSTimeDiff(itr->second, now) >= MOVEMENT_RELAY_PURGE_INTERVAL)
+            _lastRelay.erase(itr++);
+        else
+            ++itr;
+    }
+
+    _nextPurge = now + MOVEMENT_RELAY_PURGE_INTERVAL;
+}
@@ -0,0 +1,44 @@
+/*
+ * Copyright (C) 2008-2011 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRINITY_MOVEMENTRELAYFILTER_H
+#define TRINITY_MOVEMENTRELAYFILTER_H
+
+#include "Define.h"
+#include "UnorderedMap.h"
+
+// Per observer rate limit of relayed movement heartbeats. Movers close to the observer are
+// relayed at full rate, farther ones only every Movement.Relay.*Interval milliseconds, the
+// client keeps extrapolating them from the last start/stop packet in between. Only
+// MSG_MOVE_HEARTBEAT is ever thinned, every other movement opcode changes the movement
+// state and is always relayed.
+class MovementRelayFilter
+{
+    public:
+        MovementRelayFilter() : _nextPurge(0) {}
+
+        bool ShouldRelay(uint64 moverGuid, uint16 opcode, float distSq, uint32 now);
+
+    private:
+        void _Purge(uint32 now);
+
+        typedef UNORDERED_MAP<uint64, uint32> RelayTimeMap;
+        RelayTimeMap _lastRelay;                            // mover guid -> time of last relayed packet, throttled movers only
+        uint32 _nextPurge;
+};
+
+#endif
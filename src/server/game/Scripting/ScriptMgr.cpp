@@ -145,6 +145,147 @@ class ScriptRegistry
     FOR_SCRIPTS(T, itr, end) \
     itr->second
 
+// Subscriber lists per hook for the script types that declare their hooks (see SCRIPT_HOOK_MASK).
+// Like the registry itself these are filled at startup and only read afterwards.
+template<class TScript>
+class ScriptHookRegistry
+{
+    public:
+
+        typedef std::vector<TScript*> SubscriberList;
+        typedef typename SubscriberList::const_iterator SubscriberIterator;
+
+        static SubscriberList Subscribers[TScript::HOOK_COUNT];
+
+        // Profiling counters, only updated while hook profiling is enabled.
+        static ACE_Atomic_Op<ACE_Thread_Mutex, long> Calls[TScript::HOOK_COUNT];
+        static ACE_Atomic_Op<ACE_Thread_Mutex, long> Time[TScript::HOOK_COUNT];
+
+        static void AddScript(TScript* const script)
+        {
+            for (uint32 hook = 0; hook < TScript::HOOK_COUNT; ++hook)
+                if (script->GetHookMask() & SCRIPT_HOOK_MASK(hook))
+                    Subscribers[hook].push_back(script);
+        }
+
+        static void Clear()
+        {
+            for (uint32 hook = 0; hook < TScript::HOOK_COUNT; ++hook)
+                Subscribers[hook].clear();
+        }
+
+        static void GetStats(std::vector<ScriptHookInfo>& stats, char const* const* names)
+        {
+            for (uint32 hook = 0; hook < TScript::HOOK_COUNT; ++hook)
+            {
+                ScriptHookInfo info;
+                info.Name = names[hook];
+                info.Subscribers = Subscribers[hook].size();
+                info.Calls = uint32(Calls[hook].value());
+                info.Time = uint64(Time[hook].value());
+                stats.push_back(info);
+            }
+        }
+
+        static void ResetStats()
+        {
+            for (uint32 hook = 0; hook < TScript::HOOK_COUNT; ++hook)
+            {
+                Calls[hook] = 0;
+                Time[hook] = 0;
+            }
+        }
+};
+
+// Accounts one dispatch of a hook to its profiling counters.
+template<class TScript>
+class ScriptHookTimer
+{
+    public:
+
+        explicit ScriptHookTimer(uint32 hook) : _hook(hook), _profiling(sScriptMgr->IsHookProfilingEnabled())
+        {
+            if (_profiling)
+                _start = ACE_OS::gettimeofday();
+        }
+
+        ~ScriptHookTimer()
+        {
+            if (!_profiling)
+                return;
+
+            ACE_Time_Value elapsed = ACE_OS::gettimeofday() - _start;
+            ++ScriptHookRegistry<TScript>::Calls[_hook];
+            ScriptHookRegistry<TScript>::Time[_hook] += long(elapsed.sec() * 1000000 + elapsed.usec());
+        }
+
+    private:
+
+        uint32 _hook;
+        bool _profiling;
+        ACE_Time_Value _start;
+};
+
+#define SCR_HOOK_LST(T, H) ScriptHookRegistry<T>::Subscribers[H]
+#define SCR_HOOK_ITR(T) ScriptHookRegistry<T>::SubscriberIterator
+
+// Loops over the subscribers of a single hook.
+#define FOREACH_HOOK(T, H) \
+    if (SCR_HOOK_LST(T, H).empty()) \
+        return; \
+    ScriptHookTimer<T> hookTimer(H); \
+    for (SCR_HOOK_ITR(T) itr = SCR_HOOK_LST(T, H).begin(); \
+        itr != SCR_HOOK_LST(T, H).end(); ++itr) \
+        (*itr)
+
+static char const* const ServerHookNames[SERVERHOOK_END] =
+{
+    "ServerScript::OnNetworkStart",
+    "ServerScript::OnNetworkStop",
+    "ServerScript::OnSocketOpen",
+    "ServerScript::OnSocketClose",
+    "ServerScript::OnPacketSend",
+    "ServerScript::OnPacketReceive",
+    "ServerScript::OnUnknownPacketReceive"
+};
+
+static char const* const WorldHookNames[WORLDHOOK_END] =
+{
+    "WorldScript::OnOpenStateChange",
+    "WorldScript::OnConfigLoad",
+    "WorldScript::OnMotdChange",
+    "WorldScript::OnShutdownInitiate",
+    "WorldScript::OnShutdownCancel",
+    "WorldScript::OnUpdate",
+    "WorldScript::OnStartup",
+    "WorldScript::OnShutdown"
+};
+
+static char const* const PlayerHookNames[PLAYERHOOK_END] =
+{
+    "PlayerScript::OnPVPKill",
+    "PlayerScript::OnCreatureKill",
+    "PlayerScript::OnPlayerKilledByCreature",
+    "PlayerScript::OnLevelChanged",
+    "PlayerScript::OnFreeTalentPointsChanged",
+    "PlayerScript::OnTalentsReset",
+    "PlayerScript::OnMoneyChanged",
+    "PlayerScript::OnGiveXP",
+    "PlayerScript::OnReputationChange",
+    "PlayerScript::OnDuelRequest",
+    "PlayerScript::OnDuelStart",
+    "PlayerScript::OnDuelEnd",
+    "PlayerScript::OnChat",
+    "PlayerScript::OnEmote",
+    "PlayerScript::OnTextEmote",
+    "PlayerScript::OnSpellCast",
+    "PlayerScript::OnLogin",
+    "PlayerScript::OnLogout",
+    "PlayerScript::OnCreate",
+    "PlayerScript::OnDelete",
+    "PlayerScript::OnBindToInstance"
+};
+
 // Utility macros for finding specific scripts.
 #define GET_SCRIPT(T, I, V) \
     T* V = ScriptRegistry<T>::GetScriptById(I); \
@@ -234,7 +375,7 @@ void DoScriptText(int32 iTextEntry, WorldObject* pSource, Unit* target)
 }
 
 ScriptMgr::ScriptMgr()
-    : _scriptCount(0), _scheduledScripts(0)
+    : _scriptCount(0), _hookProfiling(false), _scheduledScripts(0)
 {
 }
 
@@ -264,6 +405,11 @@ void ScriptMgr::Unload()
             delete itr->second; \
         SCR_REG_LST(T).clear();
 
+    // Drop the hook subscribers first, SCR_CLEAR returns at the first empty script list
+    ScriptHookRegistry<ServerScript>::Clear();
+    ScriptHookRegistry<WorldScript>::Clear();
+    ScriptHookRegistry<PlayerScript>::Clear();
+
     // Clear scripts for every script type.
     SCR_CLEAR(SpellScriptLoader);
     SCR_CLEAR(ServerScript);
@@ -293,6 +439,20 @@ void ScriptMgr::Unload()
     #undef SCR_CLEAR
 }
 
+void ScriptMgr::GetHookStats(std::vector<ScriptHookInfo>& stats) const
+{
+    ScriptHookRegistry<ServerScript>::GetStats(stats, ServerHookNames);
+    ScriptHookRegistry<WorldScript>::GetStats(stats, WorldHookNames);
+    ScriptHookRegistry<PlayerScript>::GetStats(stats, PlayerHookNames);
+}
+
+void ScriptMgr::ResetHookStats()
+{
+    ScriptHookRegistry<ServerScript>::ResetStats();
+    ScriptHookRegistry<WorldScript>::ResetStats();
+    ScriptHookRegistry<PlayerScript>::ResetStats();
+}
+
 void ScriptMgr::LoadDatabase()
 {
     sScriptSystemMgr->LoadVersion();
@@ -451,77 +611,77 @@ void ScriptMgr::CreateSpellScriptLoaders(uint32 spellId, std::vector<std::pair<S
 
 void ScriptMgr::OnNetworkStart()
 {
-    FOREACH_SCRIPT(ServerScript)->OnNetworkStart();
+    FOREACH_HOOK(ServerScript, SERVERHOOK_NETWORK_START)->OnNetworkStart();
 }
 
 void ScriptMgr::OnNetworkStop()
 {
-    FOREACH_SCRIPT(ServerScript)->OnNetworkStop();
+    FOREACH_HOOK(ServerScript, SERVERHOOK_NETWORK_STOP)->OnNetworkStop();
 }
 
 void ScriptMgr::OnSocketOpen(WorldSocket* socket)
 {
     ASSERT(socket);
 
-    FOREACH_SCRIPT(ServerScript)->OnSocketOpen(socket);
+    FOREACH_HOOK(ServerScript, SERVERHOOK_SOCKET_OPEN)->OnSocketOpen(socket);
 }
 
 void ScriptMgr::OnSocketClose(WorldSocket* socket, bool wasNew)
 {
     ASSERT(socket);
 
-    FOREACH_SCRIPT(ServerScript)->OnSocketClose(socket, wasNew);
+    FOREACH_HOOK(ServerScript, SERVERHOOK_SOCKET_CLOSE)->OnSocketClose(socket, wasNew);
 }
 
-void ScriptMgr::OnPacketReceive(WorldSocket* socket, WorldPacket packet)
+void ScriptMgr::OnPacketReceive(WorldSocket* socket, WorldPacket const& packet)
 {
     ASSERT(socket);
 
-    FOREACH_SCRIPT(ServerScript)->OnPacketReceive(socket, packet);
+    FOREACH_HOOK(ServerScript, SERVERHOOK_PACKET_RECEIVE)->OnPacketReceive(socket, packet);
 }
 
-void ScriptMgr::OnPacketSend(WorldSocket* socket, WorldPacket packet)
+void ScriptMgr::OnPacketSend(WorldSocket* socket, WorldPacket const& packet)
 {
     ASSERT(socket);
 
-    FOREACH_SCRIPT(ServerScript)->OnPacketSend(socket, packet);
+    FOREACH_HOOK(ServerScript, SERVERHOOK_PACKET_SEND)->OnPacketSend(socket, packet);
 }
 
-void ScriptMgr::OnUnknownPacketReceive(WorldSocket* socket, WorldPacket packet)
+void ScriptMgr::OnUnknownPacketReceive(WorldSocket* socket, WorldPacket const& packet)
 {
     ASSERT(socket);
 
-    FOREACH_SCRIPT(ServerScript)->OnUnknownPacketReceive(socket, packet);
+    FOREACH_HOOK(ServerScript, SERVERHOOK_UNKNOWN_PACKET_RECEIVE)->OnUnknownPacketReceive(socket, packet);
 }
 
 void ScriptMgr::OnOpenStateChange(bool open)
 {
-    FOREACH_SCRIPT(WorldScript)->OnOpenStateChange(open);
+    FOREACH_HOOK(WorldScript, WORLDHOOK_OPEN_STATE_CHANGE)->OnOpenStateChange(open);
 }
 
 void ScriptMgr::OnConfigLoad(bool reload)
 {
-    FOREACH_SCRIPT(WorldScript)->OnConfigLoad(reload);
+    FOREACH_HOOK(WorldScript, WORLDHOOK_CONFIG_LOAD)->OnConfigLoad(reload);
 }
 
 void ScriptMgr::OnMotdChange(std::string& newMotd)
 {
-    FOREACH_SCRIPT(WorldScript)->OnMotdChange(newMotd);
+    FOREACH_HOOK(WorldScript, WORLDHOOK_MOTD_CHANGE)->OnMotdChange(newMotd);
 }
 
 void ScriptMgr::OnShutdownInitiate(ShutdownExitCode code, ShutdownMask mask)
 {
-    FOREACH_SCRIPT(WorldScript)->OnShutdownInitiate(code, mask);
+    FOREACH_HOOK(WorldScript, WORLDHOOK_SHUTDOWN_INITIATE)->OnShutdownInitiate(code, mask);
 }
 
 void ScriptMgr::OnShutdownCancel()
 {
-    FOREACH_SCRIPT(WorldScript)->OnShutdownCancel();
+    FOREACH_HOOK(WorldScript, WORLDHOOK_SHUTDOWN_CANCEL)->OnShutdownCancel();
 }
 
 void ScriptMgr::OnWorldUpdate(uint32 diff)
 {
-    FOREACH_SCRIPT(WorldScript)->OnUpdate(diff);
+    FOREACH_HOOK(WorldScript, WORLDHOOK_UPDATE)->OnUpdate(diff);
 }
 
 void ScriptMgr::OnHonorCalculation(float& honor, uint8 level, float multiplier)
@@ -1155,12 +1315,12 @@ void ScriptMgr::OnRelocate(Transport* transport, uint32 waypointId, uint32 mapId
 
 void ScriptMgr::OnStartup()
 {
-    FOREACH_SCRIPT(WorldScript)->OnStartup();
+    FOREACH_HOOK(WorldScript, WORLDHOOK_STARTUP)->OnStartup();
 }
 
 void ScriptMgr::OnShutdown()
 {
-    FOREACH_SCRIPT(WorldScript)->OnShutdown();
+    FOREACH_HOOK(WorldScript, WORLDHOOK_SHUTDOWN)->OnShutdown();
 }
 
 bool ScriptMgr::OnCriteriaCheck(AchievementCriteriaData const* data, Player* source, Unit* target)
@@ -1175,127 +1335,127 @@ bool ScriptMgr::OnCriteriaCheck(AchievementCriteriaData const* data, Player* sou
 // Player
 void ScriptMgr::OnPVPKill(Player* killer, Player* killed)
 {
-    FOREACH_SCRIPT(PlayerScript)->OnPVPKill(killer, killed);
+    FOREACH_HOOK(PlayerScript, PLAYERHOOK_PVP_KILL)->OnPVPKill(killer, killed);
 }
 
 void ScriptMgr::OnCreatureKill(Player* killer, Creature* killed)
 {
-    FOREACH_SCRIPT(PlayerScript)->OnCreatureKill(killer, killed);
+    FOREACH_HOOK(PlayerScript, PLAYERHOOK_CREATURE_KILL)->OnCreatureKill(killer, killed);
 }
 
 void ScriptMgr::OnPlayerKilledByCreature(Creature* killer, Player* killed)
 {
-    FOREACH_SCRIPT(PlayerScript)->OnPlayerKilledByCreature(killer, killed);
+    FOREACH_HOOK(PlayerScript, PLAYERHOOK_KILLED_BY_CREATURE)->OnPlayerKilledByCreature(killer, killed);
 }
 
 void ScriptMgr::OnPlayerLevelChanged(Player* player, uint8 oldLevel)
 {
-    FOREACH_SCRIPT(PlayerScript)->OnLevelChanged(player, oldLevel);
+    FOREACH_HOOK(PlayerScript, PLAYERHOOK_LEVEL_CHANGED)->OnLevelChanged(player, oldLevel);
 }
 
 void ScriptMgr::OnPlayerFreeTalentPointsChanged(Player* player, uint32 points)
 {
-    FOREACH_SCRIPT(PlayerScript)->OnFreeTalentPointsChanged(player, points);
+    FOREACH_HOOK(PlayerScript, PLAYERHOOK_FREE_TALENT_POINTS_CHANGED)->OnFreeTalentPointsChanged(player, points);
 }
 
 void ScriptMgr::OnPlayerTalentsReset(Player* player, bool noCost)
 {
-    FOREACH_SCRIPT(PlayerScript)->OnTalentsReset(player, noCost);
+    FOREACH_HOOK(PlayerScript, PLAYERHOOK_TALENTS_RESET)->OnTalentsReset(player, noCost);
 }
 
 void ScriptMgr::OnPlayerMoneyChanged(Player* player, int32& amount)
 {
-    FOREACH_SCRIPT(PlayerScript)->OnMoneyChanged(player, amount);
+    FOREACH_HOOK(PlayerScript, PLAYERHOOK_MONEY_CHANGED)->OnMoneyChanged(player, amount);
 }
 
 void ScriptMgr::OnGivePlayerXP(Player* player, uint32& amount, Unit* victim)
 {
-    FOREACH_SCRIPT(PlayerScript)->OnGiveXP(player, amount, victim);
+    FOREACH_HOOK(PlayerScript, PLAYERHOOK_GIVE_XP)->OnGiveXP(player, amount, victim);
 }
 
 void ScriptMgr::OnPlayerReputationChange(Player* player, uint32 factionID, int32& standing, bool incremental)
 {
-    FOREACH_SCRIPT(PlayerScript)->OnReputationChange(player, factionID, standing, incremental);
+    FOREACH_HOOK(PlayerScript, PLAYERHOOK_REPUTATION_CHANGE)->OnReputationChange(player, factionID, standing, incremental);
 }
 
 void ScriptMgr::OnPlayerDuelRequest(Player* target, Player* challenger)
 {
-    FOREACH_SCRIPT(PlayerScript)->OnDuelRequest(target, challenger);
+    FOREACH_HOOK(PlayerScript, PLAYERHOOK_DUEL_REQUEST)->OnDuelRequest(target, challenger);
 }
 
 void ScriptMgr::OnPlayerDuelStart(Player* player1, Player* player2)
 {
-    FOREACH_SCRIPT(PlayerScript)->OnDuelStart(player1, player2);
+    FOREACH_HOOK(PlayerScript, PLAYERHOOK_DUEL_START)->OnDuelStart(player1, player2);
 }
 
 void ScriptMgr::OnPlayerDuelEnd(Player* winner, Player* loser, DuelCompleteType type)
 {
-    FOREACH_SCRIPT(PlayerScript)->OnDuelEnd(winner, loser, type);
+    FOREACH_HOOK(PlayerScript, PLAYERHOOK_DUEL_END)->OnDuelEnd(winner, loser, type);
 }
 
 void ScriptMgr::OnPlayerChat(Player* player, uint32 type, uint32 lang, std::string& msg)
 {
-    FOREACH_SCRIPT(PlayerScript)->OnChat(player, type, lang, msg);
+    FOREACH_HOOK(PlayerScript, PLAYERHOOK_CHAT)->OnChat(player, type, lang, msg);
 }
 
 void ScriptMgr::OnPlayerChat(Player* player, uint32 type, uint32 lang, std::string& msg, Player* receiver)
 {
-    FOREACH_SCRIPT(PlayerScript)->OnChat(player, type, lang, msg, receiver);
+    FOREACH_HOOK(PlayerScript, PLAYERHOOK_CHAT)->OnChat(player, type, lang, msg, receiver);
 }
 
 void ScriptMgr::OnPlayerChat(Player* player, uint32 type, uint32 lang, std::string& msg, Group* group)
 {
-    FOREACH_SCRIPT(PlayerScript)->OnChat(player, type, lang, msg, group);
+    FOREACH_HOOK(PlayerScript, PLAYERHOOK_CHAT)->OnChat(player, type, lang, msg, group);
 }
 
 void ScriptMgr::OnPlayerChat(Player* player, uint32 type, uint32 lang, std::string& msg, Guild* guild)
 {
-    FOREACH_SCRIPT(PlayerScript)->OnChat(player, type, lang, msg, guild);
+    FOREACH_HOOK(PlayerScript, PLAYERHOOK_CHAT)->OnChat(player, type, lang, msg, guild);
 }
 
 void ScriptMgr::OnPlayerChat(Player* player, uint32 type, uint32 lang, std::string& msg, Channel* channel)
 {
-    FOREACH_SCRIPT(PlayerScript)->OnChat(player, type, lang, msg, channel);
+    FOREACH_HOOK(PlayerScript, PLAYERHOOK_CHAT)->OnChat(player, type, lang, msg, channel);
 }
 
 void ScriptMgr::OnPlayerEmote(Player* player, uint32 emote)
 {
-    FOREACH_SCRIPT(PlayerScript)->OnEmote(player, emote);
+    FOREACH_HOOK(PlayerScript, PLAYERHOOK_EMOTE)->OnEmote(player, emote);
 }
 
 void ScriptMgr::OnPlayerTextEmote(Player* player, uint32 textEmote, uint32 emoteNum, uint64 guid)
 {
-    FOREACH_SCRIPT(PlayerScript)->OnTextEmote(player, textEmote, emoteNum, guid);
+    FOREACH_HOOK(PlayerScript, PLAYERHOOK_TEXT_EMOTE)->OnTextEmote(player, textEmote, emoteNum, guid);
 }
 
 void ScriptMgr::OnPlayerSpellCast(Player* player, Spell* spell, bool skipCheck)
 {
-    FOREACH_SCRIPT(PlayerScript)->OnSpellCast(player, spell, skipCheck);
+    FOREACH_HOOK(PlayerScript, PLAYERHOOK_SPELL_CAST)->OnSpellCast(player, spell, skipCheck);
 }
 
 void ScriptMgr::OnPlayerLogin(Player* player)
 {
-    FOREACH_SCRIPT(PlayerScript)->OnLogin(player);
+    FOREACH_HOOK(PlayerScript, PLAYERHOOK_LOGIN)->OnLogin(player);
 }
 
 void ScriptMgr::OnPlayerLogout(Player* player)
 {
-    FOREACH_SCRIPT(PlayerScript)->OnLogout(player);
+    FOREACH_HOOK(PlayerScript, PLAYERHOOK_LOGOUT)->OnLogout(player);
 }
 
 void ScriptMgr::OnPlayerCreate(Player* player)
 {
-    FOREACH_SCRIPT(PlayerScript)->OnCreate(player);
+    FOREACH_HOOK(PlayerScript, PLAYERHOOK_CREATE)->OnCreate(player);
 }
 
 void ScriptMgr::OnPlayerDelete(uint64 guid)
 {
-    FOREACH_SCRIPT(PlayerScript)->OnDelete(guid);
+    FOREACH_HOOK(PlayerScript, PLAYERHOOK_DELETE)->OnDelete(guid);
 }
 
 void ScriptMgr::OnPlayerBindToInstance(Player* player, Difficulty difficulty, uint32 mapid, bool permanent)
 {
-    FOREACH_SCRIPT(PlayerScript)->OnBindToInstance(player, difficulty, mapid, permanent);
+    FOREACH_HOOK(PlayerScript, PLAYERHOOK_BIND_TO_INSTANCE)->OnBindToInstance(player, difficulty, mapid, permanent);
 }
 
 // Guild
@@ -1392,16 +1552,18 @@ SpellScriptLoader::SpellScriptLoader(const char* name)
     ScriptRegistry<SpellScriptLoader>::AddScript(this);
 }
 
-ServerScript::ServerScript(const char* name)
-    : ScriptObject(name)
+ServerScript::ServerScript(const char* name, uint32 hooks)
+    : ScriptObject(name), _hooks(hooks)
 {
     ScriptRegistry<ServerScript>::AddScript(this);
+    ScriptHookRegistry<ServerScript>::AddScript(this);
 }
 
-WorldScript::WorldScript(const char* name)
-    : ScriptObject(name)
+WorldScript::WorldScript(const char* name, uint32 hooks)
+    : ScriptObject(name), _hooks(hooks)
 {
     ScriptRegistry<WorldScript>::AddScript(this);
+    ScriptHookRegistry<WorldScript>::AddScript(this);
 }
 
 FormulaScript::FormulaScript(const char* name)
@@ -1521,10 +1683,11 @@ AchievementCriteriaScript::AchievementCriteriaScript(const char* name)
     ScriptRegistry<AchievementCriteriaScript>::AddScript(this);
 }
 
-PlayerScript::PlayerScript(const char* name)
-    : ScriptObject(name)
+PlayerScript::PlayerScript(const char* name, uint32 hooks)
+    : ScriptObject(name), _hooks(hooks)
 {
     ScriptRegistry<PlayerScript>::AddScript(this);
+    ScriptHookRegistry<PlayerScript>::AddScript(this);
 }
 
 GuildScript::GuildScript(const char* name)
@@ -1569,9 +1732,21 @@ template class ScriptRegistry<PlayerScript>;
 template class ScriptRegistry<GuildScript>;
 template class ScriptRegistry<GroupScript>;
 
+// Instantiate static members of ScriptHookRegistry.
+template<class TScript> std::vector<TScript*> ScriptHookRegistry<TScript>::Subscribers[TScript::HOOK_COUNT];
+template<class TScript> ACE_Atomic_Op<ACE_Thread_Mutex, long> ScriptHookRegistry<TScript>::Calls[TScript::HOOK_COUNT];
+template<class TScript> ACE_Atomic_Op<ACE_Thread_Mutex, long> ScriptHookRegistry<TScript>::Time[TScript::HOOK_COUNT];
+
+template class ScriptHookRegistry<ServerScript>;
+template class ScriptHookRegistry<WorldScript>;
+template class ScriptHookRegistry<PlayerScript>;
+
 // Undefine utility macros.
 #undef GET_SCRIPT_RET
 #undef GET_SCRIPT
+#undef FOREACH_HOOK
+#undef SCR_HOOK_ITR
+#undef SCR_HOOK_LST
 #undef FOREACH_SCRIPT
 #undef FOR_SCRIPTS_RET
 #undef FOR_SCRIPTS
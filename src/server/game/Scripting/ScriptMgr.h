@@ -205,14 +205,36 @@ class SpellScriptLoader : public ScriptObject
         virtual AuraScript* GetAuraScript() const { return NULL; }
 };
 
+// Script types with hooks on hot paths (every packet, every tick, every player action) keep one
+// subscriber list per hook. Scripts of these types pass the mask of hooks they override to the base
+// constructor, so hooks nobody listens to cost a single check. Omitting the mask subscribes to all hooks.
+#define SCRIPT_HOOK_MASK(hook)      (uint32(1) << (hook))
+#define SCRIPT_HOOK_ALL             uint32(0xFFFFFFFF)
+
+enum ServerHook
+{
+    SERVERHOOK_NETWORK_START,
+    SERVERHOOK_NETWORK_STOP,
+    SERVERHOOK_SOCKET_OPEN,
+    SERVERHOOK_SOCKET_CLOSE,
+    SERVERHOOK_PACKET_SEND,
+    SERVERHOOK_PACKET_RECEIVE,
+    SERVERHOOK_UNKNOWN_PACKET_RECEIVE,
+    SERVERHOOK_END
+};
+
 class ServerScript : public ScriptObject
 {
     protected:
 
-        ServerScript(const char* name);
+        ServerScript(const char* name, uint32 hooks = SCRIPT_HOOK_ALL);
 
     public:
 
+        enum { HOOK_COUNT = SERVERHOOK_END };
+
+        uint32 GetHookMask() const { return _hooks; }
+
         // Called when reactive socket I/O is started (WorldSocketMgr).
         virtual void OnNetworkStart() { }
 
@@ -226,27 +248,48 @@ class ServerScript : public ScriptObject
         // being open; it is not.
         virtual void OnSocketClose(WorldSocket* /*socket*/, bool /*wasNew*/) { }
 
-        // Called when a packet is sent to a client. The packet object is a copy of the original packet, so reading
-        // and modifying it is safe.
-        virtual void OnPacketSend(WorldSocket* /*socket*/, WorldPacket& /*packet*/) { }
+        // Called when a packet is sent to a client. The packet is the original one, not a copy; it can only be read.
+        // Use a local copy if the read position matters.
+        virtual void OnPacketSend(WorldSocket* /*socket*/, WorldPacket const& /*packet*/) { }
 
-        // Called when a (valid) packet is received by a client. The packet object is a copy of the original packet, so
-        // reading and modifying it is safe.
-        virtual void OnPacketReceive(WorldSocket* /*socket*/, WorldPacket& /*packet*/) { }
+        // Called when a (valid) packet is received by a client, before it is handled. The packet is the original one,
+        // not a copy; it can only be read.
+        virtual void OnPacketReceive(WorldSocket* /*socket*/, WorldPacket const& /*packet*/) { }
 
         // Called when an invalid (unknown opcode) packet is received by a client. The packet is a reference to the orignal
-        // packet; not a copy. This allows you to actually handle unknown packets (for whatever purpose).
-        virtual void OnUnknownPacketReceive(WorldSocket* /*socket*/, WorldPacket& /*packet*/) { }
+        // packet; not a copy.
+        virtual void OnUnknownPacketReceive(WorldSocket* /*socket*/, WorldPacket const& /*packet*/) { }
+
+    private:
+
+        uint32 _hooks;
+};
+
+enum WorldHook
+{
+    WORLDHOOK_OPEN_STATE_CHANGE,
+    WORLDHOOK_CONFIG_LOAD,
+    WORLDHOOK_MOTD_CHANGE,
+    WORLDHOOK_SHUTDOWN_INITIATE,
+    WORLDHOOK_SHUTDOWN_CANCEL,
+    WORLDHOOK_UPDATE,
+    WORLDHOOK_STARTUP,
+    WORLDHOOK_SHUTDOWN,
+    WORLDHOOK_END
 };
 
 class WorldScript : public ScriptObject
 {
     protected:
 
-        WorldScript(const char* name);
+        WorldScript(const char* name, uint32 hooks = SCRIPT_HOOK_ALL);
 
     public:
 
+        enum { HOOK_COUNT = WORLDHOOK_END };
+
+        uint32 GetHookMask() const { return _hooks; }
+
         // Called when the open/closed state of the world changes.
         virtual void OnOpenStateChange(bool /*open*/) { }
 
@@ -270,6 +313,10 @@ class WorldScript : public ScriptObject
 
         // Called when the world is actually shut down.
         virtual void OnShutdown() { }
+
+    private:
+
+        uint32 _hooks;
 };
 
 class FormulaScript : public ScriptObject
@@ -646,14 +693,44 @@ class AchievementCriteriaScript : public ScriptObject
         virtual bool OnCheck(Player* source, Unit* target) = 0;
 };
 
+enum PlayerHook
+{
+    PLAYERHOOK_PVP_KILL,
+    PLAYERHOOK_CREATURE_KILL,
+    PLAYERHOOK_KILLED_BY_CREATURE,
+    PLAYERHOOK_LEVEL_CHANGED,
+    PLAYERHOOK_FREE_TALENT_POINTS_CHANGED,
+    PLAYERHOOK_TALENTS_RESET,
+    PLAYERHOOK_MONEY_CHANGED,
+    PLAYERHOOK_GIVE_XP,
+    PLAYERHOOK_REPUTATION_CHANGE,
+    PLAYERHOOK_DUEL_REQUEST,
+    PLAYERHOOK_DUEL_START,
+    PLAYERHOOK_DUEL_END,
+    PLAYERHOOK_CHAT,                                        // all OnChat overloads
+    PLAYERHOOK_EMOTE,
+    PLAYERHOOK_TEXT_EMOTE,
+    PLAYERHOOK_SPELL_CAST,
+    PLAYERHOOK_LOGIN,
+    PLAYERHOOK_LOGOUT,
+    PLAYERHOOK_CREATE,
+    PLAYERHOOK_DELETE,
+    PLAYERHOOK_BIND_TO_INSTANCE,
+    PLAYERHOOK_END
+};
+
 class PlayerScript : public ScriptObject
 {
     protected:
 
-        PlayerScript(const char* name);
+        PlayerScript(const char* name, uint32 hooks = SCRIPT_HOOK_ALL);
 
     public:
 
+        enum { HOOK_COUNT = PLAYERHOOK_END };
+
+        uint32 GetHookMask() const { return _hooks; }
+
         // Called when a player kills another player
         virtual void OnPVPKill(Player* /*killer*/, Player* /*killed*/) { }
 
@@ -723,6 +800,10 @@ class PlayerScript : public ScriptObject
 
         // Called when a player is bound to an instance
         virtual void OnBindToInstance(Player* /*player*/, Difficulty /*difficulty*/, uint32 /*mapId*/, bool /*permanent*/) { }
+
+    private:
+
+        uint32 _hooks;
 };
 
 class GuildScript : public ScriptObject
@@ -794,6 +875,15 @@ class GroupScript : public ScriptObject
         virtual void OnDisband(Group* /*group*/) { }
 };
 
+// Profiling data of one hook, see ScriptMgr::GetHookStats.
+struct ScriptHookInfo
+{
+    char const* Name;
+    uint32 Subscribers;
+    uint32 Calls;
+    uint64 Time;                                            // microseconds spent in subscribers
+};
+
 // Placed here due to ScriptRegistry::AddScript dependency.
 #define sScriptMgr ACE_Singleton<ScriptMgr, ACE_Null_Mutex>::instance()
 
@@ -835,9 +925,9 @@ class ScriptMgr
         void OnNetworkStop();
         void OnSocketOpen(WorldSocket* socket);
         void OnSocketClose(WorldSocket* socket, bool wasNew);
-        void OnPacketReceive(WorldSocket* socket, WorldPacket packet);
-        void OnPacketSend(WorldSocket* socket, WorldPacket packet);
-        void OnUnknownPacketReceive(WorldSocket* socket, WorldPacket packet);
+        void OnPacketReceive(WorldSocket* socket, WorldPacket const& packet);
+        void OnPacketSend(WorldSocket* socket, WorldPacket const& packet);
+        void OnUnknownPacketReceive(WorldSocket* socket, WorldPacket const& packet);
 
     public: /* WorldScript */
 
@@ -1016,6 +1106,14 @@ class ScriptMgr
         void OnGroupChangeLeader(Group* group, uint64 newLeaderGuid, uint64 oldLeaderGuid);
         void OnGroupDisband(Group* group);
 
+    public: /* Hook profiling */
+
+        // Dispatches of subscribed hooks are counted and timed only while profiling is enabled.
+        void SetHookProfiling(bool enable) { _hookProfiling = enable; }
+        bool IsHookProfilingEnabled() const { return _hookProfiling; }
+        void GetHookStats(std::vector<ScriptHookInfo>& stats) const;
+        void ResetHookStats();
+
     public: /* Scheduled scripts */
 
         uint32 IncreaseScheduledScriptsCount() { return ++_scheduledScripts; }
@@ -1026,6 +1124,7 @@ class ScriptMgr
     private:
 
         uint32 _scriptCount;
+        bool _hookProfiling;
 
         //atomic op counter for active scripts amount
         ACE_Atomic_Op<ACE_Thread_Mutex, long> _scheduledScripts;
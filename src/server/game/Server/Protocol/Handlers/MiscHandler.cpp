@@ -51,6 +51,7 @@
 #include "GameObjectAI.h"
 #include "Group.h"
 #include "AccountMgr.h"
+#include "OpcodeStats.h"
 
 void WorldSession::HandleRepopRequestOpcode(WorldPacket & recv_data)
 {
@@ -1008,6 +1009,7 @@ void WorldSession::HandleRequestAccountData(WorldPacket& recv_data)
     }
 
     dest.resize(destSize);
+    sOpcodeStats->RecordCompression(SMSG_UPDATE_ACCOUNT_DATA, size, destSize);
 
     WorldPacket data(SMSG_UPDATE_ACCOUNT_DATA, 8+4+4+4+destSize);
     data << uint64(_player ? _player->GetGUID() : 0);       // player guid
@@ -650,7 +650,7 @@ uint32 WorldSession::getDialogStatus(Player* player, Object* questgiver, uint32
         Quest const* pQuest = sObjectMgr->GetQuestTemplate(quest_id);
         if (!pQuest) continue;
 
-        ConditionList conditions = sConditionMgr->GetConditionsForNotGroupedEntry(CONDITION_SOURCE_TYPE_QUEST_SHOW_MARK, pQuest->GetQuestId());
+        ConditionList const& conditions = sConditionMgr->GetConditionsForNotGroupedEntry(CONDITION_SOURCE_TYPE_QUEST_SHOW_MARK, pQuest->GetQuestId());
         if (!sConditionMgr->IsPlayerMeetToConditions(player, conditions))
             continue;
 
@@ -678,7 +678,7 @@ uint32 WorldSession::getDialogStatus(Player* player, Object* questgiver, uint32
         if (!pQuest)
             continue;
 
-        ConditionList conditions = sConditionMgr->GetConditionsForNotGroupedEntry(CONDITION_SOURCE_TYPE_QUEST_SHOW_MARK, pQuest->GetQuestId());
+        ConditionList const& conditions = sConditionMgr->GetConditionsForNotGroupedEntry(CONDITION_SOURCE_TYPE_QUEST_SHOW_MARK, pQuest->GetQuestId());
         if (!sConditionMgr->IsPlayerMeetToConditions(player, conditions))
             continue;
 
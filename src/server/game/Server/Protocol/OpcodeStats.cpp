@@ -0,0 +1,254 @@
+/*
+ * Copyright (C) 2008-2011 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "OpcodeStats.h"
+#include "Config.h"
+#include "Log.h"
+#include <ace/TSS_T.h>
+
+#define OPCODE_STATS_FIELDS (sizeof(OpcodeCounters) / sizeof(uint64))
+
+namespace
+{
+    typedef std::vector<OpcodeCounters*> SlotList;
+
+    // Counter blocks are never freed, the block of an exited thread keeps its counts and is
+    // handed to the next new thread. Kept outside of the singleton so thread exit during
+    // shutdown never touches a destroyed object.
+    ACE_Thread_Mutex slotLock;
+    SlotList slots;
+    SlotList freeSlots;
+
+    struct ThreadSlot
+    {
+        ThreadSlot() : Counters(NULL) {}
+
+        ~ThreadSlot()
+        {
+            if (!Counters)
+                return;
+
+            ACE_GUARD(ACE_Thread_Mutex, guard, slotLock);
+            freeSlots.push_back(Counters);
+        }
+
+        OpcodeCounters* Counters;
+    };
+
+    ACE_TSS<ThreadSlot> threadSlot;
+
+    inline uint64* Fields(OpcodeCounters& counters) { return reinterpret_cast<uint64*>(&counters); }
+    inline uint64 const* Fields(OpcodeCounters const& counters) { return reinterpret_cast<uint64 const*>(&counters); }
+
+    bool HasTraffic(OpcodeCounters const& counters)
+    {
+        return counters.PacketsIn || counters.PacketsOut || counters.HandlerCalls;
+    }
+}
+
+OpcodeStats::OpcodeStats() : _aggregateTimer(0), _dumpTimer(0), _dumpInterval(0)
+{
+    memset(_total, 0, sizeof(_total));
+    memset(_perSecond, 0, sizeof(_perSecond));
+}
+
+OpcodeStats::~OpcodeStats()
+{
+}
+
+void OpcodeStats::LoadConfig()
+{
+    std::string logsDir = ConfigMgr::GetStringDefault("LogsDir", "");
+    if (!logsDir.empty() && logsDir.at(logsDir.length()-1) != '/' && logsDir.at(logsDir.length()-1) != '\\')
+        logsDir.push_back('/');
+
+    std::string dumpFile = ConfigMgr::GetStringDefault("OpcodeStats.DumpFile", "");
+
+    ACE_GUARD(ACE_Thread_Mutex, guard, _lock);
+    _dumpFile = dumpFile.empty() ? "" : logsDir + dumpFile;
+    _dumpInterval = ConfigMgr::GetIntDefault("OpcodeStats.DumpInterval", 60) * IN_MILLISECONDS;
+    _dumpTimer = 0;
+}
+
+OpcodeCounters* OpcodeStats::_Counters(uint16 opcode)
+{
+    if (opcode >= NUM_MSG_TYPES)
+        return NULL;
+
+    ThreadSlot* slot = threadSlot;
+    if (!slot->Counters)
+    {
+        ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, slotLock, NULL);
+        if (freeSlots.empty())
+        {
+            slot->Counters = new OpcodeCounters[NUM_MSG_TYPES]();
+            slots.push_back(slot->Counters);
+        }
+        else
+        {
+            slot->Counters = freeSlots.back();
+            freeSlots.pop_back();
+        }
+    }
+
+    return &slot->Counters[opcode];
+}
+
+void OpcodeStats::RecordIncoming(uint16 opcode, uint32 size)
+{
+    if (OpcodeCounters* counters = _Counters(opcode))
+    {
+        ++counters->PacketsIn;
+        counters->BytesIn += size;
+    }
+}
+
+void OpcodeStats::RecordOutgoing(uint16 opcode, uint32 size)
+{
+    if (OpcodeCounters* counters = _Counters(opcode))
+    {
+        ++counters->PacketsOut;
+        counters->BytesOut += size;
+    }
+}
+
+void OpcodeStats::RecordCompression(uint16 opcode, uint32 rawSize, uint32 compressedSize)
+{
+    if (OpcodeCounters* counters = _Counters(opcode))
+    {
+        counters->RawBytes += rawSize;
+        counters->CompressedBytes += compressedSize;
+    }
+}
+
+void OpcodeStats::RecordHandler(uint16 opcode, uint32 time)
+{
+    OpcodeCounters* counters = _Counters(opcode);
+    if (!counters)
+        return;
+
+    uint32 bucket = 0;
+    for (uint32 t = time >> 4; t && bucket < OPCODE_STATS_HISTOGRAM_BUCKETS - 1; t >>= 2)
+        ++bucket;
+
+    ++counters->HandlerCalls;
+    counters->HandlerTime += time;
+    ++counters->HandlerHistogram[bucket];
+}
+
+void OpcodeStats::Update(uint32 diff)
+{
+    _aggregateTimer += diff;
+    if (_aggregateTimer < IN_MILLISECONDS)
+        return;
+
+    _Aggregate(_aggregateTimer);
+
+    _dumpTimer += _aggregateTimer;
+    _aggregateTimer = 0;
+
+    if (!_dumpFile.empty() && _dumpTimer >= _dumpInterval)
+    {
+        _dumpTimer = 0;
+        _WriteDump();
+    }
+}
+
+void OpcodeStats::_Aggregate(uint32 elapsed)
+{
+    // the owning threads keep writing while we read, the sums are statistics only
+    std::vector<OpcodeCounters> sum(NUM_MSG_TYPES);
+    memset(&sum[0], 0, sizeof(OpcodeCounters) * NUM_MSG_TYPES);
+    {
+        ACE_GUARD(ACE_Thread_Mutex, guard, slotLock);
+        for (SlotList::const_iterator itr = slots.begin(); itr != slots.end(); ++itr)
+            for (uint32 opcode = 0; opcode < NUM_MSG_TYPES; ++opcode)
+                for (uint32 i = 0; i < OPCODE_STATS_FIELDS; ++i)
+                    Fields(sum[opcode])[i] += Fields((*itr)[opcode])[i];
+    }
+
+    ACE_GUARD(ACE_Thread_Mutex, guard, _lock);
+    for (uint32 opcode = 0; opcode < NUM_MSG_TYPES; ++opcode)
+    {
+        uint64* total = Fields(_total[opcode]);
+        uint64* perSecond = Fields(_perSecond[opcode]);
+        uint64 const* current = Fields(sum[opcode]);
+        for (uint32 i = 0; i < OPCODE_STATS_FIELDS; ++i)
+        {
+            perSecond[i] = current[i] > total[i] ? (current[i] - total[i]) * IN_MILLISECONDS / elapsed : 0;
+            total[i] = current[i];
+        }
+    }
+}
+
+void OpcodeStats::GetSnapshot(std::vector<OpcodeStatsEntry>& entries) const
+{
+    ACE_GUARD(ACE_Thread_Mutex, guard, _lock);
+    for (uint32 opcode = 0; opcode < NUM_MSG_TYPES; ++opcode)
+    {
+        if (!HasTraffic(_total[opcode]))
+            continue;
+
+        OpcodeStatsEntry entry;
+        entry.Opcode = uint16(opcode);
+        entry.Total = _total[opcode];
+        entry.PerSecond = _perSecond[opcode];
+        entries.push_back(entry);
+    }
+}
+
+/// Write the snapshot as CSV, through a temporary file so readers never see a partial dump
+void OpcodeStats::_WriteDump() const
+{
+    std::vector<OpcodeStatsEntry> entries;
+    GetSnapshot(entries);
+
+    std::string tmpName = _dumpFile + ".tmp";
+    FILE* file = fopen(tmpName.c_str(), "w");
+    if (!file)
+    {
+        sLog->outError("OpcodeStats: can't open %s for writing", tmpName.c_str());
+        return;
+    }
+
+    fprintf(file, "time,opcode,name,packets_in,bytes_in,packets_out,bytes_out,raw_bytes,compressed_bytes,handler_calls,handler_us");
+    for (uint32 i = 0; i < OPCODE_STATS_HISTOGRAM_BUCKETS; ++i)
+        fprintf(file, ",handler_hist%u", i);
+    fprintf(file, ",packets_in_s,bytes_in_s,packets_out_s,bytes_out_s\n");
+
+    uint64 now = uint64(time(NULL));
+    for (std::vector<OpcodeStatsEntry>::const_iterator itr = entries.begin(); itr != entries.end(); ++itr)
+    {
+        OpcodeCounters const& c = itr->Total;
+        fprintf(file, UI64FMTD ",%u,%s," UI64FMTD "," UI64FMTD "," UI64FMTD "," UI64FMTD "," UI64FMTD "," UI64FMTD "," UI64FMTD "," UI64FMTD,
+            now, uint32(itr->Opcode), LookupOpcodeName(itr->Opcode), c.PacketsIn, c.BytesIn, c.PacketsOut, c.BytesOut,
+            c.RawBytes, c.CompressedBytes, c.HandlerCalls, c.HandlerTime);
+        for (uint32 i = 0; i < OPCODE_STATS_HISTOGRAM_BUCKETS; ++i)
+            fprintf(file, "," UI64FMTD, c.HandlerHistogram[i]);
+        fprintf(file, "," UI64FMTD "," UI64FMTD "," UI64FMTD "," UI64FMTD "\n",
+            itr->PerSecond.PacketsIn, itr->PerSecond.BytesIn, itr->PerSecond.PacketsOut, itr->PerSecond.BytesOut);
+    }
+
+    fclose(file);
+
+#if PLATFORM == PLATFORM_WINDOWS
+    // rename does not replace an existing file here
+    ACE_OS::unlink(_dumpFile.c_str());
+#endif
+    if (ACE_OS::rename(tmpName.c_str(), _dumpFile.c_str()) != 0)
+        sLog->outError("OpcodeStats: can't rename %s to %s", tmpName.c_str(), _dumpFile.c_str());
+}
@@ -0,0 +1,107 @@
+/*
+ * Copyright (C) 2008-2011 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRINITY_OPCODESTATS_H
+#define TRINITY_OPCODESTATS_H
+
+#include "Common.h"
+#include "Opcodes.h"
+#include <ace/Singleton.h>
+
+#define OPCODE_STATS_HISTOGRAM_BUCKETS  8                   // handler time: <16us, <64us, ... <64ms, rest
+
+struct OpcodeCounters
+{
+    uint64 PacketsIn;
+    uint64 BytesIn;
+    uint64 PacketsOut;
+    uint64 BytesOut;
+    uint64 RawBytes;                                        // payload size before compression
+    uint64 CompressedBytes;                                 // and after
+    uint64 HandlerCalls;
+    uint64 HandlerTime;                                     // microseconds
+    uint64 HandlerHistogram[OPCODE_STATS_HISTOGRAM_BUCKETS];
+};
+
+struct OpcodeStatsEntry
+{
+    uint16 Opcode;
+    OpcodeCounters Total;
+    OpcodeCounters PerSecond;                               // difference to the previous aggregation
+};
+
+// Always-on per opcode network and handler counters.
+// Every thread that records something owns a private counter block, so recording is a
+// plain increment without any locking. Update() sums all blocks once per second into the
+// snapshot read by .server netstats and written to the optional dump file.
+class OpcodeStats
+{
+    friend class ACE_Singleton<OpcodeStats, ACE_Thread_Mutex>;
+
+    private:
+        OpcodeStats();
+        ~OpcodeStats();
+
+    public:
+        void LoadConfig();
+
+        // sizes include the packet header
+        void RecordIncoming(uint16 opcode, uint32 size);
+        void RecordOutgoing(uint16 opcode, uint32 size);
+        void RecordCompression(uint16 opcode, uint32 rawSize, uint32 compressedSize);
+        void RecordHandler(uint16 opcode, uint32 time);
+
+        void Update(uint32 diff);
+
+        // opcodes with any traffic, unsorted
+        void GetSnapshot(std::vector<OpcodeStatsEntry>& entries) const;
+
+    private:
+        static OpcodeCounters* _Counters(uint16 opcode);
+
+        void _Aggregate(uint32 elapsed);
+        void _WriteDump() const;
+
+        mutable ACE_Thread_Mutex _lock;                     // guards the snapshot below
+        OpcodeCounters _total[NUM_MSG_TYPES];
+        OpcodeCounters _perSecond[NUM_MSG_TYPES];
+
+        uint32 _aggregateTimer;
+        uint32 _dumpTimer;
+        uint32 _dumpInterval;
+        std::string _dumpFile;
+};
+
+#define sOpcodeStats ACE_Singleton<OpcodeStats, ACE_Thread_Mutex>::instance()
+
+// Times an opcode handler and records it on destruction.
+class OpcodeHandlerTimer
+{
+    public:
+        explicit OpcodeHandlerTimer(uint16 opcode) : _opcode(opcode), _start(ACE_OS::gettimeofday()) {}
+        ~OpcodeHandlerTimer()
+        {
+            ACE_Time_Value elapsed = ACE_OS::gettimeofday() - _start;
+            sOpcodeStats->RecordHandler(_opcode, uint32(elapsed.sec() * 1000000 + elapsed.usec()));
+        }
+
+    private:
+        uint16 _opcode;
+        ACE_Time_Value _start;
+};
+
+#endif
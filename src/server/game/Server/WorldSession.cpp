@@ -44,6 +44,8 @@
 #include "Transport.h"
 #include "WardenWin.h"
 #include "WardenMac.h"
+#include "OpcodeStats.h"
+#include "TickProfiler.h"
 
 bool MapSessionFilter::Process(WorldPacket* packet)
 {
@@ -159,40 +161,6 @@ void WorldSession::SendPacket(WorldPacket const* packet)
     if (!m_Socket)
         return;
 
-#ifdef TRINITY_DEBUG
-    // Code for network use statistic
-    static uint64 sendPacketCount = 0;
-    static uint64 sendPacketBytes = 0;
-
-    static time_t firstTime = time(NULL);
-    static time_t lastTime = firstTime;                     // next 60 secs start time
-
-    static uint64 sendLastPacketCount = 0;
-    static uint64 sendLastPacketBytes = 0;
-
-    time_t cur_time = time(NULL);
-
-    if ((cur_time - lastTime) < 60)
-    {
-        sendPacketCount+=1;
-        sendPacketBytes+=packet->size();
-
-        sendLastPacketCount+=1;
-        sendLastPacketBytes+=packet->size();
-    }
-    else
-    {
-        uint64 minTime = uint64(cur_time - lastTime);
-        uint64 fullTime = uint64(lastTime - firstTime);
-        sLog->outDetail("Send all time packets count: " UI64FMTD " bytes: " UI64FMTD " avr.count/sec: %f avr.bytes/sec: %f time: %u", sendPacketCount, sendPacketBytes, float(sendPacketCount)/fullTime, float(sendPacketBytes)/fullTime, uint32(fullTime));
-        sLog->outDetail("Send last min packets count: " UI64FMTD " bytes: " UI64FMTD " avr.count/sec: %f avr.bytes/sec: %f", sendLastPacketCount, sendLastPacketBytes, float(sendLastPacketCount)/minTime, float(sendLastPacketBytes)/minTime);
-
-        lastTime = cur_time;
-        sendLastPacketCount = 1;
-        sendLastPacketBytes = packet->wpos();               // wpos is real written size
-    }
-#endif                                                      // !TRINITY_DEBUG
-
     if (m_Socket->SendPacket (*packet) == -1)
         m_Socket->CloseSocket ();
 }
@@ -219,6 +187,20 @@ void WorldSession::LogUnprocessedTail(WorldPacket* packet)
     packet->print_storage();
 }
 
+/// Call the handler of an accepted opcode, its run time goes into the opcode statistics
+void WorldSession::ExecuteOpcode(OpcodeHandler const& opHandle, WorldPacket* packet)
+{
+    sScriptMgr->OnPacketReceive(m_Socket, *packet);
+    {
+        OpcodeHandlerTimer timer(packet->GetOpcode());
+        TickProfileScope profile(opHandle.name, GetAccountId());
+        (this->*opHandle.handler)(*packet);
+    }
+
+    if (sLog->IsOutDebug() && packet->rpos() < packet->wpos())
+        LogUnprocessedTail(packet);
+}
+
 /// Update the WorldSession (triggered by World update)
 bool WorldSession::Update(uint32 diff, PacketFilter& updater)
 {
@@ -238,7 +220,7 @@ bool WorldSession::Update(uint32 diff, PacketFilter& updater)
         if (packet->GetOpcode() >= NUM_MSG_TYPES)
         {
             sLog->outError("SESSION: received non-existed opcode %s (0x%.4X)", LookupOpcodeName(packet->GetOpcode()), packet->GetOpcode());
-            sScriptMgr->OnUnknownPacketReceive(m_Socket, WorldPacket(*packet));
+            sScriptMgr->OnUnknownPacketReceive(m_Socket, *packet);
         }
         else
         {
@@ -256,10 +238,7 @@ bool WorldSession::Update(uint32 diff, PacketFilter& updater)
                         }
                         else if (_player->IsInWorld())
                         {
-                            sScriptMgr->OnPacketReceive(m_Socket, WorldPacket(*packet));
-                            (this->*opHandle.handler)(*packet);
-                            if (sLog->IsOutDebug() && packet->rpos() < packet->wpos())
-                                LogUnprocessedTail(packet);
+                            ExecuteOpcode(opHandle, packet);
                         }
                         // lag can cause STATUS_LOGGEDIN opcodes to arrive after the player started a transfer
                         break;
@@ -270,10 +249,7 @@ bool WorldSession::Update(uint32 diff, PacketFilter& updater)
                         else
                         {
                             // not expected _player or must checked in packet hanlder
-                            sScriptMgr->OnPacketReceive(m_Socket, WorldPacket(*packet));
-                            (this->*opHandle.handler)(*packet);
-                            if (sLog->IsOutDebug() && packet->rpos() < packet->wpos())
-                                LogUnprocessedTail(packet);
+                            ExecuteOpcode(opHandle, packet);
                         }
                         break;
                     case STATUS_TRANSFER:
@@ -283,10 +259,7 @@ bool WorldSession::Update(uint32 diff, PacketFilter& updater)
                             LogUnexpectedOpcode(packet, "STATUS_TRANSFER", "the player is still in world");
                         else
                         {
-                            sScriptMgr->OnPacketReceive(m_Socket, WorldPacket(*packet));
-                            (this->*opHandle.handler)(*packet);
-                            if (sLog->IsOutDebug() && packet->rpos() < packet->wpos())
-                                LogUnprocessedTail(packet);
+                            ExecuteOpcode(opHandle, packet);
                         }
                         break;
                     case STATUS_AUTHED:
@@ -302,10 +275,7 @@ bool WorldSession::Update(uint32 diff, PacketFilter& updater)
                         if (packet->GetOpcode() != CMSG_SET_ACTIVE_VOICE_CHANNEL)
                             m_playerRecentlyLogout = false;
 
-                        sScriptMgr->OnPacketReceive(m_Socket, WorldPacket(*packet));
-                        (this->*opHandle.handler)(*packet);
-                        if (sLog->IsOutDebug() && packet->rpos() < packet->wpos())
-                            LogUnprocessedTail(packet);
+                        ExecuteOpcode(opHandle, packet);
                         break;
                     case STATUS_NEVER:
                         sLog->outError("SESSION (account: %u, guidlow: %u, char: %s): received not allowed opcode %s (0x%.4X)",
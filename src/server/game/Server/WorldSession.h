@@ -35,6 +35,7 @@ struct ItemTemplate;
 struct AuctionEntry;
 struct DeclinedName;
 struct MovementInfo;
+struct OpcodeHandler;
 
 class Creature;
 class Item;
@@ -926,6 +927,8 @@ class WorldSession
         void LogUnexpectedOpcode(WorldPacket* packet, const char* status, const char *reason);
         void LogUnprocessedTail(WorldPacket* packet);
 
+        void ExecuteOpcode(OpcodeHandler const& opHandle, WorldPacket* packet);
+
         // EnumData helpers
         bool CharCanLogin(uint32 lowGUID)
         {
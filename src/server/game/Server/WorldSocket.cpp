@@ -43,6 +43,7 @@
 #include "WorldSocketMgr.h"
 #include "Log.h"
 #include "WorldLog.h"
+#include "OpcodeStats.h"
 #include "ScriptMgr.h"
 #include "AccountMgr.h"
 
@@ -179,12 +180,13 @@ int WorldSocket::SendPacket (const WorldPacket& pct)
         sWorldLog->outLog("\n");
     }
 
-    // Create a copy of the original packet; this is to avoid issues if a hook modifies it.
-    sScriptMgr->OnPacketSend(this, WorldPacket(pct));
+    sScriptMgr->OnPacketSend(this, pct);
 
     ServerPktHeader header(pct.size()+2, pct.GetOpcode());
     m_Crypt.EncryptSend ((uint8*)header.header, header.getHeaderLength());
 
+    sOpcodeStats->RecordOutgoing(pct.GetOpcode(), pct.size() + header.getHeaderLength());
+
     if (m_OutBuffer->space() >= pct.size() + header.getHeaderLength() && msg_queue()->is_empty())
     {
         // Put the packet on the buffer.
@@ -686,6 +688,8 @@ int WorldSocket::ProcessIncoming (WorldPacket* new_pct)
     if (closing_)
         return -1;
 
+    sOpcodeStats->RecordIncoming(opcode, new_pct->size() + sizeof(ClientPktHeader));
+
     // Dump received packet.
     if (sWorldLog->LogWorld())
     {
@@ -719,11 +723,11 @@ int WorldSocket::ProcessIncoming (WorldPacket* new_pct)
                     return -1;
                 }
 
-                sScriptMgr->OnPacketReceive(this, WorldPacket(*new_pct));
+                sScriptMgr->OnPacketReceive(this, *new_pct);
                 return HandleAuthSession (*new_pct);
             case CMSG_KEEP_ALIVE:
                 sLog->outStaticDebug ("CMSG_KEEP_ALIVE, size: " UI64FMTD, uint64(new_pct->size()));
-                sScriptMgr->OnPacketReceive(this, WorldPacket(*new_pct));
+                sScriptMgr->OnPacketReceive(this, *new_pct);
                 return 0;
             default:
             {
@@ -557,6 +557,7 @@ m_caster((info->AttributesEx6 & SPELL_ATTR6_CAST_BY_CHARMER && caster->GetCharme
     m_timer = 0;                                            // will set to castime in prepare
 
     m_channelTargetEffectMask = 0;
+    m_preparedLOSCaster = NULL;
 
     // Determine if spell can be reflected back to the caster
     // Patch 1.2 notes: Spell Reflection no longer reflects abilities
@@ -728,7 +729,7 @@ void Spell::SelectSpellTargets()
         if (m_spellInfo->IsChanneled())
         {
             uint8 mask = (1 << i);
-            for (std::list<TargetInfo>::iterator ihit = m_UniqueTargetInfo.begin(); ihit != m_UniqueTargetInfo.end(); ++ihit)
+            for (TargetInfoList::iterator ihit = m_UniqueTargetInfo.begin(); ihit != m_UniqueTargetInfo.end(); ++ihit)
             {
                 if (ihit->effectMask & mask)
                 {
@@ -740,7 +741,7 @@ void Spell::SelectSpellTargets()
         else if (m_auraScaleMask)
         {
             bool checkLvl = !m_UniqueTargetInfo.empty();
-            for (std::list<TargetInfo>::iterator ihit = m_UniqueTargetInfo.begin(); ihit != m_UniqueTargetInfo.end();)
+            for (TargetInfoList::iterator ihit = m_UniqueTargetInfo.begin(); ihit != m_UniqueTargetInfo.end();)
             {
                 // remove targets which did not pass min level check
                 if (m_auraScaleMask && ihit->effectMask == m_auraScaleMask)
@@ -748,7 +749,7 @@ void Spell::SelectSpellTargets()
                     // Do not check for selfcast
                     if (!ihit->scaleAura && ihit->targetGUID != m_caster->GetGUID())
                     {
-                         m_UniqueTargetInfo.erase(ihit++);
+                         ihit = m_UniqueTargetInfo.erase(ihit);
                          continue;
                     }
                 }
@@ -959,7 +960,7 @@ void Spell::AddUnitTarget(Unit* target, uint32 effectMask, bool checkIfValid /*=
     uint64 targetGUID = target->GetGUID();
 
     // Lookup target in already in list
-    for (std::list<TargetInfo>::iterator ihit = m_UniqueTargetInfo.begin(); ihit != m_UniqueTargetInfo.end(); ++ihit)
+    for (TargetInfoList::iterator ihit = m_UniqueTargetInfo.begin(); ihit != m_UniqueTargetInfo.end(); ++ihit)
     {
         if (targetGUID == ihit->targetGUID)             // Found in list
         {
@@ -1416,6 +1417,9 @@ SpellMissInfo Spell::DoSpellHitOnUnit(Unit* unit, const uint32 effectMask, bool
     PrepareScriptHitHandlers();
     CallScriptBeforeHitHandlers();
 
+    if (Creature* creature = unit->ToCreature())
+        creature->WakeUp();
+
     if (unit->GetTypeId() == TYPEID_PLAYER)
     {
         unit->ToPlayer()->GetAchievementMgr().StartTimedAchievement(ACHIEVEMENT_TIMED_TYPE_SPELL_TARGET, m_spellInfo->Id);
@@ -1710,7 +1714,7 @@ bool Spell::UpdateChanneledTargetList()
             modOwner->ApplySpellMod(m_spellInfo->Id, SPELLMOD_RANGE, range, this);
     }
 
-    for (std::list<TargetInfo>::iterator ihit= m_UniqueTargetInfo.begin(); ihit != m_UniqueTargetInfo.end(); ++ihit)
+    for (TargetInfoList::iterator ihit= m_UniqueTargetInfo.begin(); ihit != m_UniqueTargetInfo.end(); ++ihit)
     {
         if (ihit->missCondition == SPELL_MISS_NONE && (channelTargetEffectMask & ihit->effectMask))
         {
@@ -1749,30 +1753,48 @@ bool Spell::UpdateChanneledTargetList()
 // Spell target first
 // Raidmates then descending by injury suffered (MaxHealth - Health)
 // Other players/mobs then descending by injury suffered (MaxHealth - Health)
-struct ChainHealingOrder : public std::binary_function<const Unit*, const Unit*, bool>
+static int32 ChainHealingHash(Unit const* mainTarget, Unit const* target)
 {
-    const Unit* MainTarget;
-    ChainHealingOrder(Unit const* Target) : MainTarget(Target) {};
-    // functor for operator ">"
-    bool operator()(Unit const* _Left, Unit const* _Right) const
+    if (target->GetTypeId() == TYPEID_PLAYER && mainTarget->GetTypeId() == TYPEID_PLAYER && target->ToPlayer()->IsInSameRaidWith(mainTarget->ToPlayer()))
     {
-        return (ChainHealingHash(_Left) < ChainHealingHash(_Right));
-    }
-
-    int32 ChainHealingHash(Unit const* Target) const
-    {
-        if (Target->GetTypeId() == TYPEID_PLAYER && MainTarget->GetTypeId() == TYPEID_PLAYER && Target->ToPlayer()->IsInSameRaidWith(MainTarget->ToPlayer()))
-        {
-            if (Target->IsFullHealth())
-                return 40000;
-            else
-                return 20000 - Target->GetMaxHealth() + Target->GetHealth();
-        }
+        if (target->IsFullHealth())
+            return 40000;
         else
-            return 40000 - Target->GetMaxHealth() + Target->GetHealth();
+            return 20000 - target->GetMaxHealth() + target->GetHealth();
     }
+    else
+        return 40000 - target->GetMaxHealth() + target->GetHealth();
+}
+
+// chain candidates are kept as (sort key, unit) pairs, keys are computed once per jump or cast
+typedef std::pair<double, Unit*> ChainCandidate;
+
+struct ChainCandidateFurther
+{
+    bool operator()(ChainCandidate const& left, ChainCandidate const& right) const { return left.first > right.first; }
+};
+
+struct ChainCandidateLess
+{
+    bool operator()(ChainCandidate const& left, ChainCandidate const& right) const { return left.first < right.first; }
 };
 
+bool Spell::_IsValidChainTarget(Unit* cur, Unit* next, float max_range) const
+{
+    // If you want to add any conditions to exclude a target from the chain, add them here.
+    // Line of sight is the most expensive check and comes last.
+    if (next->GetCreatureType() == CREATURE_TYPE_CRITTER)
+        return false;
+
+    if ((GetSpellInfo()->AttributesEx6 & SPELL_ATTR6_CANT_TARGET_CROWD_CONTROLLED) && !next->CanFreeMove())
+        return false;
+
+    if (m_spellInfo->DmgClass == SPELL_DAMAGE_CLASS_MELEE && !m_caster->isInFrontInMap(next, max_range))
+        return false;
+
+    return m_caster->canSeeOrDetect(next) && cur->IsWithinLOSInMap(next);
+}
+
 void Spell::SearchChainTarget(std::list<Unit*> &TagUnitMap, float max_range, uint32 num, SpellTargets TargetType)
 {
     Unit* cur = m_targets.GetUnitTarget();
@@ -1784,60 +1806,68 @@ void Spell::SearchChainTarget(std::list<Unit*> &TagUnitMap, float max_range, uin
         max_range += num * CHAIN_SPELL_JUMP_RADIUS;
 
     std::list<Unit*> tempUnitMap;
+    SearchAreaTarget(tempUnitMap, max_range, PUSH_CHAIN, TargetType == SPELL_TARGETS_CHAINHEAL ? SPELL_TARGETS_ALLY : TargetType);
+
+    std::vector<ChainCandidate> candidates;
+    candidates.reserve(tempUnitMap.size());
+    for (std::list<Unit*>::const_iterator itr = tempUnitMap.begin(); itr != tempUnitMap.end(); ++itr)
+        if (*itr != cur)
+            candidates.push_back(ChainCandidate(TargetType == SPELL_TARGETS_CHAINHEAL ? ChainHealingHash(m_caster, *itr) : 0, *itr));
+
+    // the heal order does not depend on the current target, sort once
     if (TargetType == SPELL_TARGETS_CHAINHEAL)
-    {
-        SearchAreaTarget(tempUnitMap, max_range, PUSH_CHAIN, SPELL_TARGETS_ALLY);
-        tempUnitMap.sort(ChainHealingOrder(m_caster));
-    }
-    else
-        SearchAreaTarget(tempUnitMap, max_range, PUSH_CHAIN, TargetType);
-    tempUnitMap.remove(cur);
+        std::stable_sort(candidates.begin(), candidates.end(), ChainCandidateLess());
 
     while (num)
     {
         TagUnitMap.push_back(cur);
         --num;
 
-        if (tempUnitMap.empty())
+        if (candidates.empty())
             break;
 
-        std::list<Unit*>::iterator next;
+        std::vector<ChainCandidate>::iterator next = candidates.end();
 
         if (TargetType == SPELL_TARGETS_CHAINHEAL)
         {
-            next = tempUnitMap.begin();
-            while (cur->GetDistance(*next) > CHAIN_SPELL_JUMP_RADIUS || !cur->IsWithinLOSInMap(*next))
+            for (std::vector<ChainCandidate>::iterator itr = candidates.begin(); itr != candidates.end(); ++itr)
             {
-                ++next;
-                if (next == tempUnitMap.end())
-                    return;
+                if (cur->GetDistance(itr->second) <= CHAIN_SPELL_JUMP_RADIUS && cur->IsWithinLOSInMap(itr->second))
+                {
+                    next = itr;
+                    break;
+                }
             }
         }
         else
         {
-            tempUnitMap.sort(Trinity::ObjectDistanceOrderPred(cur));
-            next = tempUnitMap.begin();
-
-            if (cur->GetDistance(*next) > CHAIN_SPELL_JUMP_RADIUS)      // Don't search beyond the max jump radius
-                break;
+            // nearest neighbours of cur: a heap ordered by distance, only the examined ones are popped
+            for (std::vector<ChainCandidate>::iterator itr = candidates.begin(); itr != candidates.end(); ++itr)
+                itr->first = cur->GetExactDistSq(itr->second);
+            std::make_heap(candidates.begin(), candidates.end(), ChainCandidateFurther());
 
-            // Check if (*next) is a valid chain target. If not, don't add to TagUnitMap, and repeat loop.
-            // If you want to add any conditions to exclude a target from TagUnitMap, add condition in this while () loop.
-            while ((m_spellInfo->DmgClass == SPELL_DAMAGE_CLASS_MELEE
-                && !m_caster->isInFrontInMap(*next, max_range))
-                || !m_caster->canSeeOrDetect(*next)
-                || !cur->IsWithinLOSInMap(*next)
-                || (*next)->GetCreatureType() == CREATURE_TYPE_CRITTER
-                || ((GetSpellInfo()->AttributesEx6 & SPELL_ATTR6_CANT_TARGET_CROWD_CONTROLLED) && !(*next)->CanFreeMove()))
+            for (std::vector<ChainCandidate>::iterator end = candidates.end(); end != candidates.begin(); --end)
             {
-                ++next;
-                if (next == tempUnitMap.end() || cur->GetDistance(*next) > CHAIN_SPELL_JUMP_RADIUS) // Don't search beyond the max jump radius
-                    return;
+                std::pop_heap(candidates.begin(), end, ChainCandidateFurther());
+                Unit* unit = (end - 1)->second;
+
+                // Don't search beyond the max jump radius
+                if (cur->GetDistance(unit) > CHAIN_SPELL_JUMP_RADIUS)
+                    break;
+
+                if (_IsValidChainTarget(cur, unit, max_range))
+                {
+                    next = end - 1;
+                    break;
+                }
             }
         }
 
-        cur = *next;
-        tempUnitMap.erase(next);
+        if (next == candidates.end())
+            return;
+
+        cur = next->second;
+        candidates.erase(next);
     }
 }
 
@@ -1912,7 +1942,7 @@ WorldObject* Spell::SearchNearbyTarget(float range, SpellTargets TargetType, Spe
     {
         case SPELL_TARGETS_ENTRY:
         {
-            ConditionList conditions = sConditionMgr->GetConditionsForNotGroupedEntry(CONDITION_SOURCE_TYPE_SPELL_SCRIPT_TARGET, m_spellInfo->Id);
+            ConditionList const& conditions = sConditionMgr->GetConditionsForNotGroupedEntry(CONDITION_SOURCE_TYPE_SPELL_SCRIPT_TARGET, m_spellInfo->Id);
             if (conditions.empty())
             {
                 sLog->outDebug(LOG_FILTER_SPELLS_AURAS, "Spell (ID: %u) (caster Entry: %u) does not have record in `conditions` for spell script target (ConditionSourceType 13)", m_spellInfo->Id, m_caster->GetEntry());
@@ -2471,8 +2501,10 @@ uint32 Spell::SelectEffectTargets(uint32 i, SpellImplicitTargetInfo const& cur)
 
             CallScriptAfterUnitTargetSelectHandlers(unitList, SpellEffIndex(i));
 
+            _PrepareTargetsLOS(unitList);
             for (std::list<Unit*>::iterator itr = unitList.begin(); itr != unitList.end(); ++itr)
                 AddUnitTarget(*itr, effectMask, false);
+            m_preparedLOS.clear();
         }
         else
             AddUnitTarget(target, effectMask, false);
@@ -2525,7 +2557,7 @@ uint32 Spell::SelectEffectTargets(uint32 i, SpellImplicitTargetInfo const& cur)
         {
             case SPELL_TARGETS_ENTRY:
             {
-                ConditionList conditions = sConditionMgr->GetConditionsForNotGroupedEntry(CONDITION_SOURCE_TYPE_SPELL_SCRIPT_TARGET, m_spellInfo->Id);
+                ConditionList const& conditions = sConditionMgr->GetConditionsForNotGroupedEntry(CONDITION_SOURCE_TYPE_SPELL_SCRIPT_TARGET, m_spellInfo->Id);
                 if (!conditions.empty())
                 {
                     for (ConditionList::const_iterator i_spellST = conditions.begin(); i_spellST != conditions.end(); ++i_spellST)
@@ -2620,7 +2652,7 @@ uint32 Spell::SelectEffectTargets(uint32 i, SpellImplicitTargetInfo const& cur)
             }
             case SPELL_TARGETS_GO:
             {
-                ConditionList conditions = sConditionMgr->GetConditionsForNotGroupedEntry(CONDITION_SOURCE_TYPE_SPELL_SCRIPT_TARGET, m_spellInfo->Id);
+                ConditionList const& conditions = sConditionMgr->GetConditionsForNotGroupedEntry(CONDITION_SOURCE_TYPE_SPELL_SCRIPT_TARGET, m_spellInfo->Id);
                 if (!conditions.empty())
                 {
                     for (ConditionList::const_iterator i_spellST = conditions.begin(); i_spellST != conditions.end(); ++i_spellST)
@@ -2826,8 +2858,10 @@ uint32 Spell::SelectEffectTargets(uint32 i, SpellImplicitTargetInfo const& cur)
 
             CallScriptAfterUnitTargetSelectHandlers(unitList, SpellEffIndex(i));
 
+            _PrepareTargetsLOS(unitList);
             for (std::list<Unit*>::iterator itr = unitList.begin(); itr != unitList.end(); ++itr)
                 AddUnitTarget(*itr, effectMask, false);
+            m_preparedLOS.clear();
         }
 
         if (!gobjectList.empty())
@@ -2861,7 +2895,7 @@ void Spell::prepare(SpellCastTargets const* targets, AuraEffect const* triggered
     if (Player* plrCaster = m_caster->GetCharmerOrOwnerPlayerOrPlayerItself())
     {
         //check for special spell conditions
-        ConditionList conditions = sConditionMgr->GetConditionsForNotGroupedEntry(CONDITION_SOURCE_TYPE_SPELL, m_spellInfo->Id);
+        ConditionList const& conditions = sConditionMgr->GetConditionsForNotGroupedEntry(CONDITION_SOURCE_TYPE_SPELL, m_spellInfo->Id);
         if (!conditions.empty())
             if (!sConditionMgr->IsPlayerMeetToConditions(plrCaster, conditions))
             {
@@ -3031,7 +3065,7 @@ void Spell::cancel()
             break;
 
         case SPELL_STATE_CASTING:
-            for (std::list<TargetInfo>::const_iterator ihit = m_UniqueTargetInfo.begin(); ihit != m_UniqueTargetInfo.end(); ++ihit)
+            for (TargetInfoList::const_iterator ihit = m_UniqueTargetInfo.begin(); ihit != m_UniqueTargetInfo.end(); ++ihit)
                 if ((*ihit).missCondition == SPELL_MISS_NONE)
                     if (Unit* unit = m_caster->GetGUID() == ihit->targetGUID ? m_caster : ObjectAccessor::GetUnit(*m_caster, ihit->targetGUID))
                         unit->RemoveOwnedAura(m_spellInfo->Id, m_originalCasterGUID, 0, AURA_REMOVE_BY_CANCEL);
@@ -3264,7 +3298,7 @@ void Spell::handle_immediate()
     // process immediate effects (items, ground, etc.) also initialize some variables
     _handle_immediate_phase();
 
-    for (std::list<TargetInfo>::iterator ihit= m_UniqueTargetInfo.begin(); ihit != m_UniqueTargetInfo.end(); ++ihit)
+    for (TargetInfoList::iterator ihit= m_UniqueTargetInfo.begin(); ihit != m_UniqueTargetInfo.end(); ++ihit)
         DoAllEffectOnTarget(&(*ihit));
 
     for (std::list<GOTargetInfo>::iterator ihit= m_UniqueGOTargetInfo.begin(); ihit != m_UniqueGOTargetInfo.end(); ++ihit)
@@ -3307,7 +3341,7 @@ uint64 Spell::handle_delayed(uint64 t_offset)
     bool single_missile = (m_targets.HasDst());
 
     // now recheck units targeting correctness (need before any effects apply to prevent adding immunity at first effect not allow apply second spell effect and similar cases)
-    for (std::list<TargetInfo>::iterator ihit= m_UniqueTargetInfo.begin(); ihit != m_UniqueTargetInfo.end(); ++ihit)
+    for (TargetInfoList::iterator ihit= m_UniqueTargetInfo.begin(); ihit != m_UniqueTargetInfo.end(); ++ihit)
     {
         if (ihit->processed == false)
         {
@@ -3522,7 +3556,7 @@ void Spell::update(uint32 difftime)
                 {
                     if (Player* p = m_caster->GetCharmerOrOwnerPlayerOrPlayerItself())
                     {
-                        for (std::list<TargetInfo>::iterator ihit = m_UniqueTargetInfo.begin(); ihit != m_UniqueTargetInfo.end(); ++ihit)
+                        for (TargetInfoList::iterator ihit = m_UniqueTargetInfo.begin(); ihit != m_UniqueTargetInfo.end(); ++ihit)
                         {
                             TargetInfo* target = &*ihit;
                             if (!IS_CRE_OR_VEH_GUID(target->targetGUID))
@@ -3956,7 +3990,7 @@ void Spell::WriteSpellGoTargets(WorldPacket* data)
     // m_needAliveTargetMask req for stop channelig if one target die
     uint32 hit  = m_UniqueGOTargetInfo.size(); // Always hits on GO
     uint32 miss = 0;
-    for (std::list<TargetInfo>::iterator ihit = m_UniqueTargetInfo.begin(); ihit != m_UniqueTargetInfo.end(); ++ihit)
+    for (TargetInfoList::iterator ihit = m_UniqueTargetInfo.begin(); ihit != m_UniqueTargetInfo.end(); ++ihit)
     {
         if ((*ihit).effectMask == 0)                  // No effect apply - all immuned add state
         {
@@ -3971,7 +4005,7 @@ void Spell::WriteSpellGoTargets(WorldPacket* data)
     }
 
     *data << (uint8)hit;
-    for (std::list<TargetInfo>::const_iterator ihit = m_UniqueTargetInfo.begin(); ihit != m_UniqueTargetInfo.end(); ++ihit)
+    for (TargetInfoList::const_iterator ihit = m_UniqueTargetInfo.begin(); ihit != m_UniqueTargetInfo.end(); ++ihit)
     {
         if ((*ihit).missCondition == SPELL_MISS_NONE)       // Add only hits
         {
@@ -3984,7 +4018,7 @@ void Spell::WriteSpellGoTargets(WorldPacket* data)
         *data << uint64(ighit->targetGUID);                 // Always hits
 
     *data << (uint8)miss;
-    for (std::list<TargetInfo>::const_iterator ihit = m_UniqueTargetInfo.begin(); ihit != m_UniqueTargetInfo.end(); ++ihit)
+    for (TargetInfoList::const_iterator ihit = m_UniqueTargetInfo.begin(); ihit != m_UniqueTargetInfo.end(); ++ihit)
     {
         if (ihit->missCondition != SPELL_MISS_NONE)        // Add only miss
         {
@@ -4246,7 +4280,7 @@ void Spell::TakePower()
     {
         if (powerType == POWER_RAGE || powerType == POWER_ENERGY || powerType == POWER_RUNE)
             if (uint64 targetGUID = m_targets.GetUnitTargetGUID())
-                for (std::list<TargetInfo>::iterator ihit= m_UniqueTargetInfo.begin(); ihit != m_UniqueTargetInfo.end(); ++ihit)
+                for (TargetInfoList::iterator ihit= m_UniqueTargetInfo.begin(); ihit != m_UniqueTargetInfo.end(); ++ihit)
                     if (ihit->targetGUID == targetGUID)
                     {
                         if (ihit->missCondition != SPELL_MISS_NONE && ihit->missCondition != SPELL_MISS_MISS/* && ihit->targetGUID != m_caster->GetGUID()*/)
@@ -4511,7 +4545,7 @@ void Spell::HandleThreatSpells()
     // since 2.0.1 threat from positive effects also is distributed among all targets, so the overall caused threat is at most the defined bonus
     threat /= m_UniqueTargetInfo.size();
 
-    for (std::list<TargetInfo>::iterator ihit = m_UniqueTargetInfo.begin(); ihit != m_UniqueTargetInfo.end(); ++ihit)
+    for (TargetInfoList::iterator ihit = m_UniqueTargetInfo.begin(); ihit != m_UniqueTargetInfo.end(); ++ihit)
     {
         if (ihit->missCondition != SPELL_MISS_NONE)
             continue;
@@ -4997,6 +5031,7 @@ SpellCastResult Spell::CheckCast(bool strict)
                     return SPELL_FAILED_TARGET_UNSKINNABLE;
 
                 Creature* creature = m_targets.GetUnitTarget()->ToCreature();
+                creature->GenerateLoot(m_caster->ToPlayer());
                 if (creature->GetCreatureType() != CREATURE_TYPE_CRITTER && !creature->loot.isLooted())
                     return SPELL_FAILED_TARGET_NOT_LOOTED;
 
@@ -5637,7 +5672,7 @@ bool Spell::CanAutoCast(Unit* target)
     {
         SelectSpellTargets();
         //check if among target units, our WANTED target is as well (->only self cast spells return false)
-        for (std::list<TargetInfo>::iterator ihit= m_UniqueTargetInfo.begin(); ihit != m_UniqueTargetInfo.end(); ++ihit)
+        for (TargetInfoList::iterator ihit= m_UniqueTargetInfo.begin(); ihit != m_UniqueTargetInfo.end(); ++ihit)
             if (ihit->targetGUID == targetguid)
                 return true;
     }
@@ -6308,7 +6343,7 @@ void Spell::DelayedChannel()
 
     sLog->outDebug(LOG_FILTER_SPELLS_AURAS, "Spell %u partially interrupted for %i ms, new duration: %u ms", m_spellInfo->Id, delaytime, m_timer);
 
-    for (std::list<TargetInfo>::const_iterator ihit = m_UniqueTargetInfo.begin(); ihit != m_UniqueTargetInfo.end(); ++ihit)
+    for (TargetInfoList::const_iterator ihit = m_UniqueTargetInfo.begin(); ihit != m_UniqueTargetInfo.end(); ++ihit)
         if ((*ihit).missCondition == SPELL_MISS_NONE)
             if (Unit* unit = (m_caster->GetGUID() == ihit->targetGUID) ? m_caster : ObjectAccessor::GetUnit(*m_caster, ihit->targetGUID))
                 unit->DelayOwnedAuras(m_spellInfo->Id, m_originalCasterGUID, delaytime);
@@ -6399,13 +6434,7 @@ bool Spell::CheckEffectTarget(Unit const* target, uint32 eff) const
             // all ok by some way or another, skip normal check
             break;
         default:                                            // normal case
-            // Get GO cast coordinates if original caster -> GO
-            WorldObject* caster = NULL;
-            if (IS_GAMEOBJECT_GUID(m_originalCasterGUID))
-                caster = m_caster->GetMap()->GetGameObject(m_originalCasterGUID);
-            if (!caster)
-                caster = m_caster;
-            if (target != m_caster && !target->IsWithinLOSInMap(caster))
+            if (target != m_caster && !_IsTargetWithinLOS(target, _GetLOSCaster()))
                 return false;
             break;
     }
@@ -6413,6 +6442,69 @@ bool Spell::CheckEffectTarget(Unit const* target, uint32 eff) const
     return true;
 }
 
+// Get GO cast coordinates if original caster -> GO
+WorldObject* Spell::_GetLOSCaster() const
+{
+    WorldObject* caster = NULL;
+    if (IS_GAMEOBJECT_GUID(m_originalCasterGUID))
+        caster = m_caster->GetMap()->GetGameObject(m_originalCasterGUID);
+    if (!caster)
+        caster = m_caster;
+    return caster;
+}
+
+// Traces the LOS checks CheckEffectTarget() will make for these targets in one batch,
+// so the rays of an area or chain spell go through the vmap tree together
+void Spell::_PrepareTargetsLOS(std::list<Unit*> const& unitList)
+{
+    m_preparedLOS.clear();
+    if (IsTriggered() || m_spellInfo->AttributesEx2 & SPELL_ATTR2_CAN_TARGET_NOT_IN_LOS)
+        return;
+
+    WorldObject* caster = _GetLOSCaster();
+    float cx, cy, cz;
+    caster->GetPosition(cx, cy, cz);
+
+    std::vector<uint64> guids;
+    std::vector<float> segments;
+    for (std::list<Unit*>::const_iterator itr = unitList.begin(); itr != unitList.end(); ++itr)
+    {
+        // same direction as target->IsWithinLOSInMap(caster), from the target to the caster
+        Unit* target = *itr;
+        if (target == m_caster || !target->IsInMap(caster))
+            continue;
+
+        float x, y, z;
+        target->GetPosition(x, y, z);
+        float const segment[6] = { x, y, z, cx, cy, cz };
+        segments.insert(segments.end(), segment, segment + 6);
+        guids.push_back(target->GetGUID());
+    }
+
+    if (guids.size() < 2)
+        return;
+
+    bool* results = new bool[guids.size()];
+    caster->GetMap()->IsInLineOfSight(&segments[0], guids.size(), results);
+    for (uint32 i = 0; i < guids.size(); ++i)
+        m_preparedLOS[guids[i]] = results[i];
+    delete[] results;
+
+    m_preparedLOSCaster = caster;
+}
+
+bool Spell::_IsTargetWithinLOS(Unit const* target, WorldObject const* caster) const
+{
+    if (caster == m_preparedLOSCaster)
+    {
+        PreparedLOSMap::const_iterator itr = m_preparedLOS.find(target->GetGUID());
+        if (itr != m_preparedLOS.end())
+            return itr->second;
+    }
+
+    return target->IsWithinLOSInMap(caster);
+}
+
 bool Spell::IsNextMeleeSwingSpell() const
 {
     return m_spellInfo->Attributes & SPELL_ATTR0_ON_NEXT_SWING;
@@ -6431,7 +6523,7 @@ bool Spell::IsNeedSendToClient() const
 
 bool Spell::HaveTargetsForEffect(uint8 effect) const
 {
-    for (std::list<TargetInfo>::const_iterator itr = m_UniqueTargetInfo.begin(); itr != m_UniqueTargetInfo.end(); ++itr)
+    for (TargetInfoList::const_iterator itr = m_UniqueTargetInfo.begin(); itr != m_UniqueTargetInfo.end(); ++itr)
         if (itr->effectMask & (1 << effect))
             return true;
 
@@ -6601,7 +6693,7 @@ void Spell::HandleLaunchPhase()
             usesAmmo=false;
     }
 
-    for (std::list<TargetInfo>::iterator ihit= m_UniqueTargetInfo.begin(); ihit != m_UniqueTargetInfo.end(); ++ihit)
+    for (TargetInfoList::iterator ihit= m_UniqueTargetInfo.begin(); ihit != m_UniqueTargetInfo.end(); ++ihit)
     {
         TargetInfo& target = *ihit;
 
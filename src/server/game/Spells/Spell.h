@@ -224,6 +224,7 @@ enum SpellTargets
 namespace Trinity
 {
     struct SpellNotifierCreatureAndPlayer;
+    template<class T> class CellUnitIterator;
 }
 
 class Spell
@@ -577,9 +578,17 @@ class Spell
             bool   scaleAura:1;
             int32  damage;
         };
-        std::list<TargetInfo> m_UniqueTargetInfo;
+        // effect handlers (Righteous Defense) add targets while handle_immediate/handle_delayed walk
+        // this list and hold pointers to its elements, so it must not be a vector
+        typedef std::list<TargetInfo> TargetInfoList;
+        TargetInfoList m_UniqueTargetInfo;
         uint8 m_channelTargetEffectMask;                        // Mask req. alive targets
 
+        // LOS of area targets to m_preparedLOSCaster, traced together before they are added
+        typedef std::map<uint64, bool> PreparedLOSMap;
+        PreparedLOSMap m_preparedLOS;
+        WorldObject const* m_preparedLOSCaster;
+
         struct GOTargetInfo
         {
             uint64 targetGUID;
@@ -609,6 +618,10 @@ class Spell
         void SearchAreaTarget(std::list<Unit*> &unitList, float radius, SpellNotifyPushType type, SpellTargets TargetType, uint32 entry = 0);
         void SearchGOAreaTarget(std::list<GameObject*> &gobjectList, float radius, SpellNotifyPushType type, SpellTargets TargetType, uint32 entry = 0);
         void SearchChainTarget(std::list<Unit*> &unitList, float radius, uint32 unMaxTargets, SpellTargets TargetType);
+        bool _IsValidChainTarget(Unit* cur, Unit* next, float max_range) const;
+        WorldObject* _GetLOSCaster() const;
+        void _PrepareTargetsLOS(std::list<Unit*> const& unitList);
+        bool _IsTargetWithinLOS(Unit const* target, WorldObject const* caster) const;
         WorldObject* SearchNearbyTarget(float range, SpellTargets TargetType, SpellEffIndex effIndex);
         bool IsValidDeadOrAliveTarget(Unit const* target) const;
         void HandleLaunchPhase();
@@ -682,20 +695,40 @@ namespace Trinity
         uint32 i_entry;
         const Position* const i_pos;
         SpellInfo const* i_spellProto;
+        Position const* i_rangeCenter;                      // every push type accepts only units within i_range of it
+        float i_range;
 
         SpellNotifierCreatureAndPlayer(Unit* source, std::list<Unit*> &data, float radius, SpellNotifyPushType type,
             SpellTargets TargetType = SPELL_TARGETS_ENEMY, const Position* pos = NULL, uint32 entry = 0, SpellInfo const* spellProto = NULL)
             : i_data(&data), i_push_type(type), i_radius(radius), i_TargetType(TargetType),
-            i_source(source), i_entry(entry), i_pos(pos), i_spellProto(spellProto)
+            i_source(source), i_entry(entry), i_pos(pos), i_spellProto(spellProto), i_rangeCenter(pos), i_range(radius)
         {
             ASSERT(i_source);
+
+            switch (i_push_type)
+            {
+                case PUSH_IN_FRONT:
+                case PUSH_IN_BACK:
+                    i_rangeCenter = i_source;
+                    i_range += i_source->GetObjectSize();
+                    break;
+                case PUSH_IN_LINE:
+                    i_rangeCenter = i_source;
+                    break;
+                default:
+                    break;
+            }
         }
 
         template<class T> inline void Visit(GridRefManager<T>& m)
         {
-            for (typename GridRefManager<T>::iterator itr = m.begin(); itr != m.end(); ++itr)
+            // spell targeting does not filter by phase here
+            CellUnitIterator<T> itr = i_rangeCenter
+                ? CellUnitIterator<T>(m, i_rangeCenter->GetPositionX(), i_rangeCenter->GetPositionY(), i_range, PHASEMASK_ANYWHERE)
+                : CellUnitIterator<T>(m, PHASEMASK_ANYWHERE);
+            while (T* source = itr.Next())
             {
-                Unit* target = (Unit*)itr->getSource();
+                Unit* target = (Unit*)source;
 
                 if (i_spellProto->CheckTarget(i_source, target, true) != SPELL_CAST_OK)
                     continue;
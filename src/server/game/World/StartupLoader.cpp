@@ -0,0 +1,157 @@
+/*
+ * Copyright (C) 2008-2011 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "StartupLoader.h"
+#include "DatabaseEnv.h"
+#include "Timer.h"
+#include "Log.h"
+#include "Errors.h"
+#include <algorithm>
+
+namespace
+{
+    struct StepTimeCompare
+    {
+        StepTimeCompare(std::vector<uint32> const& times) : _times(times) {}
+        bool operator()(uint32 left, uint32 right) const { return _times[left] > _times[right]; }
+
+        std::vector<uint32> const& _times;
+    };
+}
+
+StartupLoader::StartupLoader(char const* name) : _name(name), _condition(_lock), _finished(0)
+{
+}
+
+StartupLoader::~StartupLoader()
+{
+    for (std::vector<Step*>::iterator itr = _steps.begin(); itr != _steps.end(); ++itr)
+        delete *itr;
+}
+
+uint32 StartupLoader::_AddStep(Step* step)
+{
+    _steps.push_back(step);
+    return uint32(_steps.size() - 1);
+}
+
+void StartupLoader::AddDependency(uint32 step, uint32 dependency)
+{
+    ASSERT(dependency < step && step < _steps.size());
+
+    _steps[dependency]->dependents.push_back(step);
+    ++_steps[step]->pendingDependencies;
+}
+
+void StartupLoader::Run(uint32 threads)
+{
+    uint32 startTime = getMSTime();
+
+    // dependencies always point backwards, insertion order is a valid serial order
+    if (threads <= 1 || _steps.size() <= 1)
+    {
+        for (uint32 i = 0; i < _steps.size(); ++i)
+            _RunStep(i);
+
+        _Report(1, GetMSTimeDiffToNow(startTime));
+        return;
+    }
+
+    for (uint32 i = 0; i < _steps.size(); ++i)
+        if (!_steps[i]->pendingDependencies)
+            _ready.push_back(i);
+
+    threads = std::min<uint32>(threads, _steps.size());
+    if (activate(THR_NEW_LWP | THR_JOINABLE, int(threads)) == -1)
+    {
+        sLog->outError("StartupLoader: could not start loader threads, loading %s serially.", _name);
+        _ready.clear();
+        for (uint32 i = 0; i < _steps.size(); ++i)
+            _RunStep(i);
+        threads = 1;
+    }
+    else
+        wait();
+
+    _Report(threads, GetMSTimeDiffToNow(startTime));
+}
+
+void StartupLoader::_RunStep(uint32 index)
+{
+    Step* step = _steps[index];
+    sLog->outString("%s...", step->name);
+
+    uint32 startTime = getMSTime();
+    step->Load();
+    step->time = GetMSTimeDiffToNow(startTime);
+}
+
+int StartupLoader::svc()
+{
+    MySQL::Thread_Init();
+
+    _lock.acquire();
+    while (_finished < _steps.size())
+    {
+        if (_ready.empty())
+        {
+            _condition.wait();
+            continue;
+        }
+
+        uint32 index = _ready.front();
+        _ready.pop_front();
+
+        _lock.release();
+        _RunStep(index);
+        _lock.acquire();
+
+        ++_finished;
+        std::vector<uint32> const& dependents = _steps[index]->dependents;
+        for (std::vector<uint32>::const_iterator itr = dependents.begin(); itr != dependents.end(); ++itr)
+            if (!--_steps[*itr]->pendingDependencies)
+                _ready.push_back(*itr);
+
+        _condition.broadcast();
+    }
+    _lock.release();
+
+    MySQL::Thread_End();
+    return 0;
+}
+
+void StartupLoader::_Report(uint32 threads, uint32 wallTime) const
+{
+    std::vector<uint32> times(_steps.size());
+    std::vector<uint32> order(_steps.size());
+    uint32 totalTime = 0;
+    for (uint32 i = 0; i < _steps.size(); ++i)
+    {
+        times[i] = _steps[i]->time;
+        order[i] = i;
+        totalTime += times[i];
+    }
+
+    std::stable_sort(order.begin(), order.end(), StepTimeCompare(times));
+
+    sLog->outString();
+    sLog->outString(">> %s: %u steps loaded in %u ms on %u thread(s), %u ms when run one after another",
+        _name, uint32(_steps.size()), wallTime, threads, totalTime);
+    for (std::vector<uint32>::const_iterator itr = order.begin(); itr != order.end(); ++itr)
+        sLog->outString(">>   %6u ms  %s", times[*itr], _steps[*itr]->name);
+    sLog->outString();
+}
@@ -0,0 +1,99 @@
+/*
+ * Copyright (C) 2008-2011 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRINITY_STARTUPLOADER_H
+#define TRINITY_STARTUPLOADER_H
+
+#include "Define.h"
+#include <ace/Task.h>
+#include <ace/Thread_Mutex.h>
+#include <ace/Condition_Thread_Mutex.h>
+#include <deque>
+#include <vector>
+
+// Runs a set of startup loaders on a small thread pool. Every step names the steps it
+// needs, a step is started as soon as all of those are done, independent steps run at
+// the same time and so do their database queries (each query takes its own synch
+// connection of the pool). Steps without dependencies between them must not touch the
+// same containers.
+// Once everything is done the time spent in every step is reported, slowest first.
+class StartupLoader : protected ACE_Task_Base
+{
+    public:
+        typedef void (*LoadFunction)();
+
+        explicit StartupLoader(char const* name);
+        ~StartupLoader();
+
+        uint32 Add(char const* name, LoadFunction function) { return _AddStep(new FunctionStep(name, function)); }
+
+        template<class T>
+        uint32 Add(char const* name, T* object, void (T::*method)()) { return _AddStep(new MethodStep<T>(name, object, method)); }
+
+        // steps may only depend on steps added before them
+        void AddDependency(uint32 step, uint32 dependency);
+
+        // blocks until all steps are done, threads <= 1 runs them in order on the calling thread
+        void Run(uint32 threads);
+
+    private:
+        struct Step
+        {
+            Step(char const* name) : name(name), pendingDependencies(0), time(0) {}
+            virtual ~Step() {}
+            virtual void Load() = 0;
+
+            char const* name;
+            std::vector<uint32> dependents;
+            uint32 pendingDependencies;
+            uint32 time;
+        };
+
+        struct FunctionStep : public Step
+        {
+            FunctionStep(char const* name, LoadFunction function) : Step(name), _function(function) {}
+            void Load() { _function(); }
+
+            LoadFunction _function;
+        };
+
+        template<class T>
+        struct MethodStep : public Step
+        {
+            MethodStep(char const* name, T* object, void (T::*method)()) : Step(name), _object(object), _method(method) {}
+            void Load() { (_object->*_method)(); }
+
+            T* _object;
+            void (T::*_method)();
+        };
+
+        uint32 _AddStep(Step* step);
+        void _RunStep(uint32 index);
+        void _Report(uint32 threads, uint32 wallTime) const;
+
+        int svc();
+
+        char const* _name;
+        std::vector<Step*> _steps;
+
+        ACE_Thread_Mutex _lock;
+        ACE_Condition_Thread_Mutex _condition;
+        std::deque<uint32> _ready;
+        uint32 _finished;
+};
+
+#endif
@@ -0,0 +1,191 @@
+/*
+ * Copyright (C) 2008-2011 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "TickProfiler.h"
+#include "Config.h"
+#include "Log.h"
+#include <ace/TSS_T.h>
+
+namespace
+{
+    struct ThreadRing
+    {
+        explicit ThreadRing(uint32 id) : Head(0), Id(id) {}
+
+        TickProfileEvent Events[TICK_PROFILER_RING_SIZE];
+        volatile uint32 Head;                               // written by the owning thread only
+        uint32 Id;                                          // trace thread id
+    };
+
+    typedef std::vector<ThreadRing*> RingList;
+
+    // Rings are never freed, the ring of an exited thread is handed to the next new thread.
+    // Kept outside of the singleton so thread exit during shutdown never touches a destroyed object.
+    ACE_Thread_Mutex ringLock;
+    RingList rings;
+    RingList freeRings;
+
+    struct ThreadSlot
+    {
+        ThreadSlot() : Ring(NULL) {}
+
+        ~ThreadSlot()
+        {
+            if (!Ring)
+                return;
+
+            ACE_GUARD(ACE_Thread_Mutex, guard, ringLock);
+            freeRings.push_back(Ring);
+        }
+
+        ThreadRing* Ring;
+    };
+
+    ACE_TSS<ThreadSlot> threadSlot;
+
+    ThreadRing* GetThreadRing()
+    {
+        ThreadSlot* slot = threadSlot;
+        if (slot->Ring)
+            return slot->Ring;
+
+        ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, ringLock, NULL);
+        if (freeRings.empty())
+        {
+            slot->Ring = new ThreadRing(uint32(rings.size()) + 1);
+            rings.push_back(slot->Ring);
+        }
+        else
+        {
+            slot->Ring = freeRings.back();
+            freeRings.pop_back();
+        }
+
+        return slot->Ring;
+    }
+}
+
+TickProfiler::TickProfiler() : _threshold(0), _minEventTime(0), _tickStart(0), _file(NULL)
+{
+}
+
+TickProfiler::~TickProfiler()
+{
+    if (_file)
+        fclose(_file);
+}
+
+void TickProfiler::LoadConfig()
+{
+    _threshold = ConfigMgr::GetIntDefault("TickProfiler.SlowTickThreshold", 0);
+    _minEventTime = ConfigMgr::GetIntDefault("TickProfiler.MinEventTime", 50);
+
+    std::string logsDir = ConfigMgr::GetStringDefault("LogsDir", "");
+    if (!logsDir.empty() && logsDir.at(logsDir.length()-1) != '/' && logsDir.at(logsDir.length()-1) != '\\')
+        logsDir.push_back('/');
+
+    std::string logFile = logsDir + ConfigMgr::GetStringDefault("TickProfiler.LogFile", "SlowTicks.json");
+    if (logFile != _logFile && _file)
+    {
+        fclose(_file);
+        _file = NULL;
+    }
+    _logFile = logFile;
+}
+
+uint64 TickProfiler::Now()
+{
+    ACE_Time_Value now = ACE_OS::gettimeofday();
+    return uint64(now.sec()) * 1000000 + now.usec();
+}
+
+void TickProfiler::BeginTick()
+{
+    _tickStart = IsEnabled() ? Now() : 0;
+}
+
+void TickProfiler::EndTick()
+{
+    if (!_tickStart)
+        return;
+
+    uint32 tickTime = uint32(Now() - _tickStart);
+    Record("World::Update", 0, _tickStart, tickTime);
+
+    if (IsEnabled() && tickTime >= _threshold * IN_MILLISECONDS)
+        _Dump(_tickStart, tickTime);
+}
+
+void TickProfiler::Record(char const* name, uint32 arg, uint64 start, uint32 duration)
+{
+    if (duration < _minEventTime)
+        return;
+
+    ThreadRing* ring = GetThreadRing();
+    if (!ring)
+        return;
+
+    TickProfileEvent& event = ring->Events[ring->Head & (TICK_PROFILER_RING_SIZE - 1)];
+    event.Name = name;
+    event.Arg = arg;
+    event.Duration = duration;
+    event.Start = start;
+    ++ring->Head;
+}
+
+/// Append every event that ended during the tick, the file is a JSON array left open so it can keep growing
+void TickProfiler::_Dump(uint64 tickStart, uint32 tickTime)
+{
+    if (!_file)
+    {
+        _file = fopen(_logFile.c_str(), "w");
+        if (!_file)
+        {
+            sLog->outError("TickProfiler: can't open %s for writing, slow tick capture disabled", _logFile.c_str());
+            _threshold = 0;
+            return;
+        }
+
+        fprintf(_file, "[\n");
+    }
+
+    uint32 events = 0;
+    {
+        ACE_GUARD(ACE_Thread_Mutex, guard, ringLock);
+        for (RingList::const_iterator itr = rings.begin(); itr != rings.end(); ++itr)
+        {
+            ThreadRing const* ring = *itr;
+            uint32 head = ring->Head;
+            uint32 count = std::min<uint32>(head, TICK_PROFILER_RING_SIZE);
+
+            // newest first, events are stored when their scope ends
+            for (uint32 i = 1; i <= count; ++i)
+            {
+                TickProfileEvent const& event = ring->Events[(head - i) & (TICK_PROFILER_RING_SIZE - 1)];
+                if (event.Start + event.Duration < tickStart)
+                    break;
+
+                fprintf(_file, "{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":" UI64FMTD ",\"dur\":%u,\"args\":{\"arg\":%u}},\n",
+                    event.Name, ring->Id, event.Start, event.Duration, event.Arg);
+                ++events;
+            }
+        }
+    }
+
+    fflush(_file);
+    sLog->outBasic("Slow world tick: %u ms, %u profiler events written to %s", tickTime / IN_MILLISECONDS, events, _logFile.c_str());
+}
@@ -0,0 +1,91 @@
+/*
+ * Copyright (C) 2008-2011 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRINITY_TICKPROFILER_H
+#define TRINITY_TICKPROFILER_H
+
+#include "Common.h"
+#include <ace/Singleton.h>
+
+#define TICK_PROFILER_RING_SIZE     4096                    // events kept per thread, must be a power of two
+
+struct TickProfileEvent
+{
+    char const* Name;                                       // must point to static storage
+    uint32 Arg;                                             // map id, guid... 0 if unused
+    uint32 Duration;                                        // microseconds
+    uint64 Start;
+};
+
+// Scoped timers for the world tick.
+// Finished scopes go into a ring buffer owned by the recording thread, written without
+// locks. When a world tick takes longer than TickProfiler.SlowTickThreshold, the events of
+// that tick are collected from every ring and appended to TickProfiler.LogFile in the
+// Chrome trace event format (load it in chrome://tracing or Perfetto).
+// Map threads are done with the tick when it ends, so their rings are stable while read.
+class TickProfiler
+{
+    friend class ACE_Singleton<TickProfiler, ACE_Thread_Mutex>;
+
+    private:
+        TickProfiler();
+        ~TickProfiler();
+
+    public:
+        void LoadConfig();
+
+        bool IsEnabled() const { return _threshold != 0; }
+
+        void BeginTick();
+        void EndTick();
+
+        void Record(char const* name, uint32 arg, uint64 start, uint32 duration);
+
+        static uint64 Now();                                // microseconds
+
+    private:
+        void _Dump(uint64 tickStart, uint32 tickTime);
+
+        uint32 _threshold;                                  // milliseconds, 0 = disabled
+        uint32 _minEventTime;                               // shorter scopes are not recorded, microseconds
+        uint64 _tickStart;
+
+        std::string _logFile;
+        FILE* _file;
+};
+
+#define sTickProfiler ACE_Singleton<TickProfiler, ACE_Thread_Mutex>::instance()
+
+class TickProfileScope
+{
+    public:
+        explicit TickProfileScope(char const* name, uint32 arg = 0) : _name(name), _arg(arg),
+            _start(sTickProfiler->IsEnabled() ? TickProfiler::Now() : 0) {}
+
+        ~TickProfileScope()
+        {
+            if (_start)
+                sTickProfiler->Record(_name, _arg, _start, uint32(TickProfiler::Now() - _start));
+        }
+
+    private:
+        char const* _name;
+        uint32 _arg;
+        uint64 _start;
+};
+
+#endif
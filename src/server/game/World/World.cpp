@@ -27,6 +27,8 @@
 #include "SystemConfig.h"
 #include "Log.h"
 #include "Opcodes.h"
+#include "OpcodeStats.h"
+#include "TickProfiler.h"
 #include "WorldSession.h"
 #include "WorldPacket.h"
 #include "Player.h"
@@ -79,6 +81,8 @@
 #include "WardenCheckMgr.h"
 #include "Warden.h"
 #include "OutdoorPvPWG.h"
+#include "StartupLoader.h"
+#include "WorldSnapshot.h"
 
 volatile bool World::m_stopEvent = false;
 uint8 World::m_ExitCode = SHUTDOWN_EXIT_CODE;
@@ -605,6 +609,8 @@ void World::LoadConfigSettings(bool reload)
         m_int_configs[CONFIG_MIN_LEVEL_STAT_SAVE] = 0;
     }
 
+    m_int_configs[CONFIG_PLAYER_SAVE_MAX_PER_UPDATE] = ConfigMgr::GetIntDefault("PlayerSave.MaxPerMapUpdate", 10);
+
     m_int_configs[CONFIG_INTERVAL_GRIDCLEAN] = ConfigMgr::GetIntDefault("GridCleanUpDelay", 5 * MINUTE * IN_MILLISECONDS);
     if (m_int_configs[CONFIG_INTERVAL_GRIDCLEAN] < MIN_GRID_DELAY)
     {
@@ -1030,6 +1036,7 @@ void World::LoadConfigSettings(bool reload)
     m_bool_configs[CONFIG_BG_XP_FOR_KILL]                            = ConfigMgr::GetBoolDefault("Battleground.GiveXPForKills", false);
     m_int_configs[CONFIG_ARENA_MAX_RATING_DIFFERENCE]                = ConfigMgr::GetIntDefault ("Arena.MaxRatingDifference", 150);
     m_int_configs[CONFIG_ARENA_RATING_DISCARD_TIMER]                 = ConfigMgr::GetIntDefault ("Arena.RatingDiscardTimer", 10 * MINUTE * IN_MILLISECONDS);
+    m_int_configs[CONFIG_ARENA_RATING_WINDOW_WIDENING]               = ConfigMgr::GetIntDefault ("Arena.RatingWindowWidening", 0);
     m_bool_configs[CONFIG_ARENA_AUTO_DISTRIBUTE_POINTS]              = ConfigMgr::GetBoolDefault("Arena.AutoDistributePoints", false);
     m_int_configs[CONFIG_ARENA_AUTO_DISTRIBUTE_INTERVAL_DAYS]        = ConfigMgr::GetIntDefault ("Arena.AutoDistributeInterval", 7);
     m_bool_configs[CONFIG_ARENA_QUEUE_ANNOUNCER_ENABLE]              = ConfigMgr::GetBoolDefault("Arena.QueueAnnouncer.Enable", false);
@@ -1107,6 +1114,17 @@ void World::LoadConfigSettings(bool reload)
     m_visibility_notify_periodInInstances = ConfigMgr::GetIntDefault("Visibility.Notify.Period.InInstances",   DEFAULT_VISIBILITY_NOTIFY_PERIOD);
     m_visibility_notify_periodInBGArenas = ConfigMgr::GetIntDefault("Visibility.Notify.Period.InBGArenas",    DEFAULT_VISIBILITY_NOTIFY_PERIOD);
 
+    m_float_configs[CONFIG_MOVEMENT_RELAY_NEAR_DISTANCE] = ConfigMgr::GetFloatDefault("Movement.Relay.NearDistance", 50.0f);
+    m_float_configs[CONFIG_MOVEMENT_RELAY_FAR_DISTANCE]  = ConfigMgr::GetFloatDefault("Movement.Relay.FarDistance", 80.0f);
+    if (m_float_configs[CONFIG_MOVEMENT_RELAY_FAR_DISTANCE] < m_float_configs[CONFIG_MOVEMENT_RELAY_NEAR_DISTANCE])
+    {
+        sLog->outError("Movement.Relay.FarDistance (%f) must be >= Movement.Relay.NearDistance (%f). Using %f instead.",
+            m_float_configs[CONFIG_MOVEMENT_RELAY_FAR_DISTANCE], m_float_configs[CONFIG_MOVEMENT_RELAY_NEAR_DISTANCE], m_float_configs[CONFIG_MOVEMENT_RELAY_NEAR_DISTANCE]);
+        m_float_configs[CONFIG_MOVEMENT_RELAY_FAR_DISTANCE] = m_float_configs[CONFIG_MOVEMENT_RELAY_NEAR_DISTANCE];
+    }
+    m_int_configs[CONFIG_MOVEMENT_RELAY_MID_INTERVAL] = ConfigMgr::GetIntDefault("Movement.Relay.MidInterval", 1000);
+    m_int_configs[CONFIG_MOVEMENT_RELAY_FAR_INTERVAL] = ConfigMgr::GetIntDefault("Movement.Relay.FarInterval", 2000);
+
     ///- Load the CharDelete related config options
     m_int_configs[CONFIG_CHARDELETE_METHOD] = ConfigMgr::GetIntDefault("CharDelete.Method", 0);
     m_int_configs[CONFIG_CHARDELETE_MIN_LEVEL] = ConfigMgr::GetIntDefault("CharDelete.MinLevel", 0);
@@ -1165,6 +1183,9 @@ void World::LoadConfigSettings(bool reload)
     m_int_configs[CONFIG_INTERVAL_LOG_UPDATE] = ConfigMgr::GetIntDefault("RecordUpdateTimeDiffInterval", 60000);
     m_int_configs[CONFIG_MIN_LOG_UPDATE] = ConfigMgr::GetIntDefault("MinRecordUpdateTimeDiff", 100);
     m_int_configs[CONFIG_NUMTHREADS] = ConfigMgr::GetIntDefault("MapUpdate.Threads", 1);
+    m_int_configs[CONFIG_STARTUP_LOADER_THREADS] = ConfigMgr::GetIntDefault("Startup.LoaderThreads", 4);
+    m_bool_configs[CONFIG_WORLD_SNAPSHOT] = ConfigMgr::GetBoolDefault("WorldSnapshot.Enable", false);
+    m_int_configs[CONFIG_CREATURE_IDLE_SLEEP_TIME] = ConfigMgr::GetIntDefault("Creature.IdleSleepTime", 1000);
     m_int_configs[CONFIG_MAX_RESULTS_LOOKUP_COMMANDS] = ConfigMgr::GetIntDefault("Command.LookupMaxResults", 0);
 
     // chat logging
@@ -1234,9 +1255,90 @@ void World::LoadConfigSettings(bool reload)
     m_bool_configs[CONFIG_GMISLAND_PLAYERS_NOACCESS_ENABLE] = ConfigMgr::GetBoolDefault("GMIsland.PlayersNoAccess.Enable", true);
     m_bool_configs[CONFIG_GMISLAND_BAN_ENABLE] = ConfigMgr::GetBoolDefault("GMIsland.Ban.Enable", false);
 
+    sOpcodeStats->LoadConfig();
+    sTickProfiler->LoadConfig();
+
     sScriptMgr->OnConfigLoad(reload);
 }
 
+static void LoadConditionsAtStartup()
+{
+    sConditionMgr->LoadConditions();
+}
+
+/// Loaders without dependencies between them, run in parallel when Startup.LoaderThreads > 1
+void World::LoadIndependentStartupData()
+{
+    StartupLoader loader("Startup data");
+
+    uint32 loot = loader.Add("Loading Loot Tables", &LoadLootTables);
+    loader.Add("Loading Skill Discovery Table", &LoadSkillDiscoveryTable);
+    loader.Add("Loading Skill Extra Item Table", &LoadSkillExtraItemTable);
+    loader.Add("Loading Skill Fishing base level requirements", sObjectMgr, &ObjectMgr::LoadFishingBaseSkillLevel);
+
+    uint32 step = loader.Add("Cargando logros", sAchievementMgr, &AchievementGlobalMgr::LoadAchievementReferenceList);
+    uint32 next = loader.Add("Loading Achievement Criteria Lists", sAchievementMgr, &AchievementGlobalMgr::LoadAchievementCriteriaList);
+    loader.AddDependency(next, step);
+    step = next;
+    next = loader.Add("Loading Achievement Criteria Data", sAchievementMgr, &AchievementGlobalMgr::LoadAchievementCriteriaData);
+    loader.AddDependency(next, step);
+    step = next;
+    next = loader.Add("Loading Achievement Rewards", sAchievementMgr, &AchievementGlobalMgr::LoadRewards);
+    loader.AddDependency(next, step);
+    step = next;
+    next = loader.Add("Loading Achievement Reward Locales", sAchievementMgr, &AchievementGlobalMgr::LoadRewardLocales);
+    loader.AddDependency(next, step);
+    step = next;
+    next = loader.Add("Cargando logros completados", sAchievementMgr, &AchievementGlobalMgr::LoadCompletedAchievements);
+    loader.AddDependency(next, step);
+
+    // Delete expired auctions before loading
+    step = loader.Add("Eliminando subastas expiriadas", sAuctionMgr, &AuctionHouseMgr::DeleteExpiredAuctionsAtStartup);
+    next = loader.Add("Cargando objetos de subasta", sAuctionMgr, &AuctionHouseMgr::LoadAuctionItems);
+    loader.AddDependency(next, step);
+    step = next;
+    next = loader.Add("Cargando subastas", sAuctionMgr, &AuctionHouseMgr::LoadAuctions);
+    loader.AddDependency(next, step);
+
+    loader.Add("Cargando hermandades", sGuildMgr, &GuildMgr::LoadGuilds);
+    loader.Add("Cargando equipos de arenas", sArenaTeamMgr, &ArenaTeamMgr::LoadArenaTeams);
+    loader.Add("Cargando grupos", sGroupMgr, &GroupMgr::LoadGroups);
+    loader.Add("Cargando nombres reservados", sObjectMgr, &ObjectMgr::LoadReservedPlayersNames);
+    // chests are quest objects when their loot template has quest items
+    step = loader.Add("Cargando objetos de juego para misiones", sObjectMgr, &ObjectMgr::LoadGameObjectForQuests);
+    loader.AddDependency(step, loot);
+    loader.Add("Cargando maestros de batalla", sBattlegroundMgr, &BattlegroundMgr::LoadBattleMastersEntry);
+    loader.Add("Loading GameTeleports", sObjectMgr, &ObjectMgr::LoadGameTele);
+
+    step = loader.Add("Cargando menus Gossip", sObjectMgr, &ObjectMgr::LoadGossipMenu);
+    uint32 gossip = loader.Add("Cargando opciones de menus Gossip", sObjectMgr, &ObjectMgr::LoadGossipMenuItems);
+    loader.AddDependency(gossip, step);
+
+    loader.Add("Cargando vendedores", sObjectMgr, &ObjectMgr::LoadVendors);
+    loader.Add("Cargando entrenadores", sObjectMgr, &ObjectMgr::LoadTrainerSpell);
+    loader.Add("Loading Waypoints", sWaypointMgr, &WaypointMgr::Load);
+    loader.Add("Loading SmartAI Waypoints", sSmartWaypointMgr, &SmartWaypointMgr::LoadFromDB);
+    loader.Add("Loading Creature Formations", &FormationMgr::LoadCreatureFormations);
+
+    // conditions are attached to loot templates and gossip menus
+    step = loader.Add("Cargando condiciones", &LoadConditionsAtStartup);
+    loader.AddDependency(step, loot);
+    loader.AddDependency(step, gossip);
+
+    loader.Add("Loading faction change achievement pairs", sObjectMgr, &ObjectMgr::LoadFactionChangeAchievements);
+    loader.Add("Loading faction change spell pairs", sObjectMgr, &ObjectMgr::LoadFactionChangeSpells);
+    loader.Add("Loading faction change item pairs", sObjectMgr, &ObjectMgr::LoadFactionChangeItems);
+    loader.Add("Loading faction change reputation pairs", sObjectMgr, &ObjectMgr::LoadFactionChangeReputations);
+
+    step = loader.Add("Cargando tickets para GMs", sTicketMgr, &TicketMgr::LoadTickets);
+    next = loader.Add("Loading GM surveys", sTicketMgr, &TicketMgr::LoadSurveys);
+    loader.AddDependency(next, step);
+
+    loader.Add("Loading client addons", &AddonMgr::LoadFromDB);
+
+    loader.Run(getIntConfig(CONFIG_STARTUP_LOADER_THREADS));
+}
+
 /// Initialize the World
 void World::SetInitialWorldSettings()
 {
@@ -1301,7 +1403,7 @@ void World::SetInitialWorldSettings()
 
     ///- Load the DBC files
     sLog->outString("Initialize data stores...");
-    LoadDBCStores(m_dataPath);
+    LoadDBCStores(m_dataPath, getIntConfig(CONFIG_STARTUP_LOADER_THREADS));
     DetectDBCLang();
 
     sLog->outString("Cargando correcciones de spell desde datos dbc...");
@@ -1423,6 +1525,12 @@ void World::SetInitialWorldSettings()
     sLog->outString("Loading Creature Base Stats...");
     sObjectMgr->LoadCreatureClassLevelStats();
 
+    if (getBoolConfig(CONFIG_WORLD_SNAPSHOT))
+    {
+        sLog->outString("Opening world snapshot...");
+        sWorldSnapshot->Open(m_dataPath + ConfigMgr::GetStringDefault("WorldSnapshot.File", "world.snapshot"));
+    }
+
     sLog->outString("Cargando datos de criaturas...");
     sObjectMgr->LoadCreatures();
 
@@ -1539,105 +1647,8 @@ void World::SetInitialWorldSettings()
     sLog->outString("Loading Player level dependent mail rewards...");
     sObjectMgr->LoadMailLevelRewards();
 
-    // Loot tables
-    LoadLootTables();
-
-    sLog->outString("Loading Skill Discovery Table...");
-    LoadSkillDiscoveryTable();
-
-    sLog->outString("Loading Skill Extra Item Table...");
-    LoadSkillExtraItemTable();
-
-    sLog->outString("Loading Skill Fishing base level requirements...");
-    sObjectMgr->LoadFishingBaseSkillLevel();
-
-    sLog->outString("Cargando logros...");
-    sAchievementMgr->LoadAchievementReferenceList();
-    sLog->outString("Loading Achievement Criteria Lists...");
-    sAchievementMgr->LoadAchievementCriteriaList();
-    sLog->outString("Loading Achievement Criteria Data...");
-    sAchievementMgr->LoadAchievementCriteriaData();
-    sLog->outString("Loading Achievement Rewards...");
-    sAchievementMgr->LoadRewards();
-    sLog->outString("Loading Achievement Reward Locales...");
-    sAchievementMgr->LoadRewardLocales();
-    sLog->outString("Cargando logros completados...");
-    sAchievementMgr->LoadCompletedAchievements();
-
-    // Delete expired auctions before loading
-    sLog->outString("Eliminando subastas expiriadas...");
-    sAuctionMgr->DeleteExpiredAuctionsAtStartup();
-
-    ///- Load dynamic data tables from the database
-    sLog->outString("Cargando objetos de subasta...");
-    sAuctionMgr->LoadAuctionItems();
-    sLog->outString("Cargando subastas...");
-    sAuctionMgr->LoadAuctions();
-
-    sGuildMgr->LoadGuilds();
-
-    sLog->outString("Cargando equipos de arenas...");
-    sArenaTeamMgr->LoadArenaTeams();
-
-    sLog->outString("Cargando grupos...");
-    sGroupMgr->LoadGroups();
-
-    sLog->outString("Cargando nombres reservados...");
-    sObjectMgr->LoadReservedPlayersNames();
-
-    sLog->outString("Cargando objetos de juego para misiones...");
-    sObjectMgr->LoadGameObjectForQuests();
-
-    sLog->outString("Cargando maestros de batalla...");
-    sBattlegroundMgr->LoadBattleMastersEntry();
-
-    sLog->outString("Loading GameTeleports...");
-    sObjectMgr->LoadGameTele();
-
-    sLog->outString("Cargando menus Gossip...");
-    sObjectMgr->LoadGossipMenu();
-
-    sLog->outString("Cargando opciones de menus Gossip...");
-    sObjectMgr->LoadGossipMenuItems();
-
-    sLog->outString("Cargando vendedores...");
-    sObjectMgr->LoadVendors();                                   // must be after load CreatureTemplate and ItemTemplate
-
-    sLog->outString("Cargando entrenadores...");
-    sObjectMgr->LoadTrainerSpell();                              // must be after load CreatureTemplate
-
-    sLog->outString("Loading Waypoints...");
-    sWaypointMgr->Load();
-
-    sLog->outString("Loading SmartAI Waypoints...");
-    sSmartWaypointMgr->LoadFromDB();
-
-    sLog->outString("Loading Creature Formations...");
-    FormationMgr::LoadCreatureFormations();
-
-    sLog->outString("Cargando condiciones...");
-    sConditionMgr->LoadConditions();
-
-    sLog->outString("Loading faction change achievement pairs...");
-    sObjectMgr->LoadFactionChangeAchievements();
-
-    sLog->outString("Loading faction change spell pairs...");
-    sObjectMgr->LoadFactionChangeSpells();
-
-    sLog->outString("Loading faction change item pairs...");
-    sObjectMgr->LoadFactionChangeItems();
-
-    sLog->outString("Loading faction change reputation pairs...");
-    sObjectMgr->LoadFactionChangeReputations();
-
-    sLog->outString("Cargando tickets para GMs...");
-    sTicketMgr->LoadTickets();
-
-    sLog->outString("Loading GM surveys...");
-    sTicketMgr->LoadSurveys();
-
-    sLog->outString("Loading client addons...");
-    AddonMgr::LoadFromDB();
+    ///- Load the tables below on the startup loader threads, see StartupLoader
+    LoadIndependentStartupData();
 
     ///- Handle outdated emails (delete/return)
     sLog->outString("Returning old mails...");
@@ -1681,6 +1692,9 @@ void World::SetInitialWorldSettings()
     sLog->outString("Loading SmartAI scripts...");
     sSmartScriptMgr->LoadSmartAIFromDB();
 
+    // rewrites the snapshot file if any of its tables came from the database
+    sWorldSnapshot->Save();
+
     ///- Initialize game time and timers
     sLog->outString("Initialize game time and timers");
     m_gameTime = time(NULL);
@@ -1903,6 +1917,8 @@ void World::LoadAutobroadcasts()
 /// Update the World !
 void World::Update(uint32 diff)
 {
+    sTickProfiler->BeginTick();
+
     m_updateTime = diff;
 
     if (m_int_configs[CONFIG_INTERVAL_LOG_UPDATE] && diff > m_int_configs[CONFIG_MIN_LOG_UPDATE])
@@ -1976,7 +1992,10 @@ void World::Update(uint32 diff)
 
     /// <li> Handle session updates when the timer has passed
     RecordTimeDiff(NULL);
-    UpdateSessions(diff);
+    {
+        TickProfileScope profile("World::UpdateSessions");
+        UpdateSessions(diff);
+    }
     RecordTimeDiff("UpdateSessions");
 
     /// <li> Handle weather updates when the timer has passed
@@ -2020,10 +2039,16 @@ void World::Update(uint32 diff)
         }
     }
 
-    sBattlegroundMgr->Update(diff);
+    {
+        TickProfileScope profile("BattlegroundMgr::Update");
+        sBattlegroundMgr->Update(diff);
+    }
     RecordTimeDiff("UpdateBattlegroundMgr");
 
-    sOutdoorPvPMgr->Update(diff);
+    {
+        TickProfileScope profile("OutdoorPvPMgr::Update");
+        sOutdoorPvPMgr->Update(diff);
+    }
     RecordTimeDiff("UpdateOutdoorPvPMgr");
 
     ///- Delete all characters which have been deleted X days before
@@ -2033,11 +2058,17 @@ void World::Update(uint32 diff)
         Player::DeleteOldCharacters();
     }
 
-    sLFGMgr->Update(diff);
+    {
+        TickProfileScope profile("LFGMgr::Update");
+        sLFGMgr->Update(diff);
+    }
     RecordTimeDiff("UpdateLFGMgr");
 
     // execute callbacks from sql queries that were queued recently
-    ProcessQueryCallbacks();
+    {
+        TickProfileScope profile("World::ProcessQueryCallbacks");
+        ProcessQueryCallbacks();
+    }
     RecordTimeDiff("ProcessQueryCallbacks");
 
     ///- Erase corpses once every 20 minutes
@@ -2069,10 +2100,17 @@ void World::Update(uint32 diff)
     // update the instance reset times
     sInstanceSaveMgr->Update();
 
+    sOpcodeStats->Update(diff);
+
     // And last, but not least handle the issued cli commands
     ProcessCliCommands();
 
-    sScriptMgr->OnWorldUpdate(diff);
+    {
+        TickProfileScope profile("ScriptMgr::OnWorldUpdate");
+        sScriptMgr->OnWorldUpdate(diff);
+    }
+
+    sTickProfiler->EndTick();
 }
 
 void World::ForceGameEventUpdate()
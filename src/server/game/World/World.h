@@ -169,6 +169,7 @@ enum WorldBoolConfigs
     CONFIG_PDUMP_NO_PATHS,
     CONFIG_PDUMP_NO_OVERWRITE,
 	CONFIG_BOOL_WARDEN_ENABLED,
+    CONFIG_WORLD_SNAPSHOT,
     BOOL_CONFIG_VALUE_COUNT
 };
 
@@ -185,6 +186,8 @@ enum WorldFloatConfigs
     CONFIG_CREATURE_FAMILY_ASSISTANCE_RADIUS,
     CONFIG_THREAT_RADIUS,
     CONFIG_CHANCE_OF_GM_SURVEY,
+    CONFIG_MOVEMENT_RELAY_NEAR_DISTANCE,
+    CONFIG_MOVEMENT_RELAY_FAR_DISTANCE,
     FLOAT_CONFIG_VALUE_COUNT
 };
 
@@ -285,6 +288,7 @@ enum WorldIntConfigs
     CONFIG_BATTLEGROUND_PREMADE_GROUP_WAIT_FOR_MATCH,
     CONFIG_ARENA_MAX_RATING_DIFFERENCE,
     CONFIG_ARENA_RATING_DISCARD_TIMER,
+    CONFIG_ARENA_RATING_WINDOW_WIDENING,
     CONFIG_ARENA_AUTO_DISTRIBUTE_INTERVAL_DAYS,
     CONFIG_ARENA_SEASON_ID,
     CONFIG_ARENA_START_RATING,
@@ -300,12 +304,15 @@ enum WorldIntConfigs
     CONFIG_ENABLE_SINFO_LOGIN,
     CONFIG_PLAYER_ALLOW_COMMANDS,
     CONFIG_NUMTHREADS,
+    CONFIG_STARTUP_LOADER_THREADS,
+    CONFIG_CREATURE_IDLE_SLEEP_TIME,
     CONFIG_LOGDB_CLEARINTERVAL,
     CONFIG_LOGDB_CLEARTIME,
     CONFIG_CLIENTCACHE_VERSION,
     CONFIG_GUILD_EVENT_LOG_COUNT,
     CONFIG_GUILD_BANK_EVENT_LOG_COUNT,
     CONFIG_MIN_LEVEL_STAT_SAVE,
+    CONFIG_PLAYER_SAVE_MAX_PER_UPDATE,
     CONFIG_RANDOM_BG_RESET_HOUR,
     CONFIG_CHARDELETE_KEEP_DAYS,
     CONFIG_CHARDELETE_METHOD,
@@ -336,6 +343,8 @@ enum WorldIntConfigs
     CONFIG_OUTDOORPVP_WINTERGRASP_SAVESTATE_PERIOD,
     CONFIG_CONFIG_OUTDOORPVP_WINTERGRASP_ANTIFARM_ATK,
     CONFIG_CONFIG_OUTDOORPVP_WINTERGRASP_ANTIFARM_DEF,
+    CONFIG_MOVEMENT_RELAY_MID_INTERVAL,
+    CONFIG_MOVEMENT_RELAY_FAR_INTERVAL,
     INT_CONFIG_VALUE_COUNT
 };
 
@@ -801,6 +810,8 @@ class World
         void ResetDailyQuests();
         void ResetWeeklyQuests();
         void ResetRandomBG();
+
+        void LoadIndependentStartupData();
     private:
         static volatile bool m_stopEvent;
         static uint8 m_ExitCode;
@@ -88,6 +88,9 @@ public:
             { "update",         SEC_ADMINISTRATOR,  false, &HandleDebugUpdateCommand,          "", NULL },
             { "itemexpire",     SEC_ADMINISTRATOR,  false, &HandleDebugItemExpireCommand,      "", NULL },
             { "areatriggers",   SEC_ADMINISTRATOR,  false, &HandleDebugAreaTriggersCommand,    "", NULL },
+            { "querycache",     SEC_ADMINISTRATOR,  false, &HandleDebugQueryCacheCommand,      "", NULL },
+            { "playersaves",    SEC_ADMINISTRATOR,  false, &HandleDebugPlayerSavesCommand,     "", NULL },
+            { "hooks",          SEC_ADMINISTRATOR,  true,  &HandleDebugHooksCommand,           "", NULL },
             { NULL,             0,                  false, NULL,                               "", NULL }
         };
         static ChatCommand commandTable[] =
@@ -448,6 +451,60 @@ public:
         return true;
     }
 
+    static bool HandleDebugQueryCacheCommand(ChatHandler* handler, char const* /*args*/)
+    {
+        Map* map = handler->GetSession()->GetPlayer()->GetMap();
+        MapQueryCache const& cache = map->GetQueryCache();
+
+        uint32 losQueries = cache.GetLineOfSightHits() + cache.GetLineOfSightMisses();
+        uint32 heightQueries = cache.GetHeightHits() + cache.GetHeightMisses();
+        handler->PSendSysMessage("Map %u instance %u query cache:", map->GetId(), map->GetInstanceId());
+        handler->PSendSysMessage("LOS: %u queries, %u rays saved (%.1f%%)", losQueries, cache.GetLineOfSightHits(),
+            losQueries ? 100.0f * cache.GetLineOfSightHits() / losQueries : 0.0f);
+        handler->PSendSysMessage("Height: %u queries, %u rays saved (%.1f%%)", heightQueries, cache.GetHeightHits(),
+            heightQueries ? 100.0f * cache.GetHeightHits() / heightQueries : 0.0f);
+        handler->PSendSysMessage("Invalidations: %u", cache.GetInvalidations());
+        return true;
+    }
+
+    static bool HandleDebugPlayerSavesCommand(ChatHandler* handler, char const* /*args*/)
+    {
+        Map* map = handler->GetSession()->GetPlayer()->GetMap();
+        PlayerSaveScheduler const& scheduler = map->GetPlayerSaveScheduler();
+
+        handler->PSendSysMessage("Map %u instance %u player saves:", map->GetId(), map->GetInstanceId());
+        handler->PSendSysMessage("Queued: %u, saved: %u, deferred: %u", scheduler.GetQueueSize(), scheduler.GetSavedCount(), scheduler.GetDeferredCount());
+        handler->PSendSysMessage("Save time: avg %u ms, max %u ms, max wait %u ms", scheduler.GetAverageSaveTime(), scheduler.GetMaxSaveTime(), scheduler.GetMaxWaitTime());
+        return true;
+    }
+
+    // USAGE: .debug hooks [on|off|reset] - without argument lists subscribed hooks with their profiling counters
+    static bool HandleDebugHooksCommand(ChatHandler* handler, char const* args)
+    {
+        if (*args)
+        {
+            std::string arg = args;
+            if (arg == "on")
+                sScriptMgr->SetHookProfiling(true);
+            else if (arg == "off")
+                sScriptMgr->SetHookProfiling(false);
+            else if (arg == "reset")
+                sScriptMgr->ResetHookStats();
+            else
+                return false;
+        }
+
+        handler->PSendSysMessage("Script hook profiling is %s", sScriptMgr->IsHookProfilingEnabled() ? "on" : "off");
+
+        std::vector<ScriptHookInfo> stats;
+        sScriptMgr->GetHookStats(stats);
+        for (std::vector<ScriptHookInfo>::const_iterator itr = stats.begin(); itr != stats.end(); ++itr)
+            if (itr->Subscribers)
+                handler->PSendSysMessage("%s: %u subscribers, %u calls, " UI64FMTD " us", itr->Name, itr->Subscribers, itr->Calls, itr->Time);
+
+        return true;
+    }
+
     //Send notification in channel
     static bool HandleDebugSendChannelNotifyCommand(ChatHandler* handler, char const* args)
     {
@@ -23,7 +23,7 @@
 class ChatLogScript : public PlayerScript
 {
 public:
-    ChatLogScript() : PlayerScript("ChatLogScript") { }
+    ChatLogScript() : PlayerScript("ChatLogScript", SCRIPT_HOOK_MASK(PLAYERHOOK_CHAT)) { }
 
     void OnChat(Player* player, uint32 type, uint32 lang, std::string& msg)
     {
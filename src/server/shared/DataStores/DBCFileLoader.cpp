@@ -31,64 +31,40 @@ DBCFileLoader::DBCFileLoader()
 
 bool DBCFileLoader::Load(const char* filename, const char* fmt)
 {
-    uint32 header;
-    if (data)
-    {
-        delete [] data;
-        data = NULL;
-    }
-
-    FILE* f = fopen(filename, "rb");
-    if (!f)
-        return false;
-
-    if (fread(&header, 4, 1, f) != 1)                        // Number of records
-    {
-        fclose(f);
-        return false;
-    }
-
-
-    EndianConvert(header);
+    data = NULL;
+    _map.close();
 
-    if (header != 0x43424457)                                //'WDBC'
-    {
-        fclose(f);
+    // private writable mapping: pages stay shared with the page cache until some legacy
+    // code casts a string back to char* and writes to it
+    if (_map.map(filename, static_cast<size_t>(-1), O_RDONLY, ACE_DEFAULT_FILE_PERMS, PROT_READ | PROT_WRITE, ACE_MAP_PRIVATE) == -1)
         return false;
-    }
 
-    if (fread(&recordCount, 4, 1, f) != 1)                   // Number of records
-    {
-        fclose(f);
-        return false;
-    }
+    // the mapping stays valid without the descriptor, all locales of all stores stay mapped
+    _map.close_handle();
 
-    EndianConvert(recordCount);
+    size_t fileSize = _map.size();
+    unsigned char const* base = static_cast<unsigned char const*>(_map.addr());
 
-    if (fread(&fieldCount, 4, 1, f) != 1)                    // Number of fields
-    {
-        fclose(f);
+    uint32 header[5];                                       // magic, records, fields, record size, string size
+    if (fileSize < sizeof(header))
         return false;
-    }
 
-    EndianConvert(fieldCount);
+    memcpy(header, base, sizeof(header));
+    for (uint32 i = 0; i < 5; ++i)
+        EndianConvert(header[i]);
 
-    if (fread(&recordSize, 4, 1, f) != 1)                    // Size of a record
-    {
-        fclose(f);
+    if (header[0] != 0x43424457)                            //'WDBC'
         return false;
-    }
 
-    EndianConvert(recordSize);
+    recordCount = header[1];
+    fieldCount = header[2];
+    recordSize = header[3];
+    stringSize = header[4];
 
-    if (fread(&stringSize, 4, 1, f) != 1)                    // String size
-    {
-        fclose(f);
+    if (sizeof(header) + uint64(recordSize) * recordCount + stringSize > fileSize)
         return false;
-    }
-
-    EndianConvert(stringSize);
 
+    delete [] fieldsOffset;
     fieldsOffset = new uint32[fieldCount];
     fieldsOffset[0] = 0;
     for (uint32 i = 1; i < fieldCount; ++i)
@@ -100,24 +76,15 @@ bool DBCFileLoader::Load(const char* filename, const char* fmt)
             fieldsOffset[i] += sizeof(uint32);
     }
 
-    data = new unsigned char[recordSize * recordCount + stringSize];
+    data = base + sizeof(header);
     stringTable = data + recordSize*recordCount;
 
-    if (fread(data, recordSize * recordCount + stringSize, 1, f) != 1)
-    {
-        fclose(f);
-        return false;
-    }
-
-    fclose(f);
-
     return true;
 }
 
 DBCFileLoader::~DBCFileLoader()
 {
-    if (data)
-        delete [] data;
+    _map.close();
 
     if (fieldsOffset)
         delete [] fieldsOffset;
@@ -277,8 +244,7 @@ char* DBCFileLoader::AutoProduceStrings(const char* format, char* dataTable)
     if (strlen(format) != fieldCount)
         return NULL;
 
-    char* stringPool = new char[stringSize];
-    memcpy(stringPool, stringTable, stringSize);
+    char* stringPool = reinterpret_cast<char*>(const_cast<unsigned char*>(stringTable));
 
     uint32 offset = 0;
 
@@ -305,7 +271,7 @@ char* DBCFileLoader::AutoProduceStrings(const char* format, char* dataTable)
                     if (!*slot || !**slot)
                     {
                         const char * st = getRecord(y).getString(x);
-                        *slot=stringPool+(st-(const char*)stringTable);
+                        *slot = const_cast<char*>(st);
                     }
                     offset += sizeof(char*);
                     break;
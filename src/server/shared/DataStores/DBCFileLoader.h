@@ -20,6 +20,7 @@
 #define DBC_FILE_LOADER_H
 #include "Define.h"
 #include "Utilities/ByteConverter.h"
+#include <ace/Mem_Map.h>
 #include <cassert>
 
 enum
@@ -37,6 +38,11 @@ enum
     FT_SQL_ABSENT='a'                                       //Used in sql format to mark column absent in sql dbc
 };
 
+// Reads a DBC file through a private copy-on-write mapping, records and the string block are
+// used in place. The mapping is writable because some legacy code casts the handed out strings
+// back to char* and writes to them; such a write only copies the touched page and never
+// reaches the file. Strings handed out by AutoProduceStrings point into that mapping, so the
+// loader must live as long as the data using them.
 class DBCFileLoader
 {
     public:
@@ -51,21 +57,21 @@ class DBCFileLoader
                 float getFloat(size_t field) const
                 {
                     assert(field < file.fieldCount);
-                    float val = *reinterpret_cast<float*>(offset+file.GetOffset(field));
+                    float val = *reinterpret_cast<float const*>(offset+file.GetOffset(field));
                     EndianConvert(val);
                     return val;
                 }
                 uint32 getUInt(size_t field) const
                 {
                     assert(field < file.fieldCount);
-                    uint32 val = *reinterpret_cast<uint32*>(offset+file.GetOffset(field));
+                    uint32 val = *reinterpret_cast<uint32 const*>(offset+file.GetOffset(field));
                     EndianConvert(val);
                     return val;
                 }
                 uint8 getUInt8(size_t field) const
                 {
                     assert(field < file.fieldCount);
-                    return *reinterpret_cast<uint8*>(offset+file.GetOffset(field));
+                    return *reinterpret_cast<uint8 const*>(offset+file.GetOffset(field));
                 }
 
                 const char *getString(size_t field) const
@@ -73,12 +79,12 @@ class DBCFileLoader
                     assert(field < file.fieldCount);
                     size_t stringOffset = getUInt(field);
                     assert(stringOffset < file.stringSize);
-                    return reinterpret_cast<char*>(file.stringTable + stringOffset);
+                    return reinterpret_cast<char const*>(file.stringTable + stringOffset);
                 }
 
             private:
-                Record(DBCFileLoader &file_, unsigned char *offset_): offset(offset_), file(file_) {}
-                unsigned char *offset;
+                Record(DBCFileLoader &file_, unsigned char const* offset_): offset(offset_), file(file_) {}
+                unsigned char const* offset;
                 DBCFileLoader &file;
 
                 friend class DBCFileLoader;
@@ -95,6 +101,8 @@ class DBCFileLoader
         uint32 GetOffset(size_t id) const { return (fieldsOffset != NULL && id < fieldCount) ? fieldsOffset[id] : 0; }
         bool IsLoaded() const { return data != NULL; }
         char* AutoProduceData(const char* fmt, uint32& count, char**& indexTable, uint32 sqlRecordCount, uint32 sqlHighestIndex, char *& sqlDataTable);
+        // points the string fields of dataTable into this file's string block, returns the
+        // block (its first byte is the empty string) or NULL if the format does not match
         char* AutoProduceStrings(const char* fmt, char* dataTable);
         static uint32 GetFormatRecordSize(const char * format, int32 * index_pos = NULL);
     private:
@@ -104,7 +112,8 @@ class DBCFileLoader
         uint32 fieldCount;
         uint32 stringSize;
         uint32 *fieldsOffset;
-        unsigned char *data;
-        unsigned char *stringTable;
+        unsigned char const* data;
+        unsigned char const* stringTable;
+        ACE_Mem_Map _map;
 };
 #endif
@@ -68,7 +68,7 @@ struct SqlDbc
 template<class T>
 class DBCStorage
 {
-    typedef std::list<char*> StringPoolList;
+    typedef std::list<DBCFileLoader*> StringFileList;
     public:
         explicit DBCStorage(const char *f) :
             fmt(f), nCount(0), fieldCount(0), dataTable(NULL)
@@ -87,10 +87,17 @@ class DBCStorage
 
         bool Load(char const* fn, SqlDbc * sql)
         {
-            DBCFileLoader dbc;
+            // string fields point into the mapped file, it is kept until Clear()
+            DBCFileLoader* file = new DBCFileLoader();
             // Check if load was sucessful, only then continue
-            if (!dbc.Load(fn, fmt))
+            if (!file->Load(fn, fmt))
+            {
+                delete file;
                 return false;
+            }
+
+            stringFileList.push_back(file);
+            DBCFileLoader& dbc = *file;
 
             uint32 sqlRecordCount = 0;
             uint32 sqlHighestIndex = 0;
@@ -129,7 +136,7 @@ class DBCStorage
             dataTable = (T*)dbc.AutoProduceData(fmt, nCount, indexTable.asChar,
                 sqlRecordCount, sqlHighestIndex, sqlDataTable);
 
-            stringPoolList.push_back(dbc.AutoProduceStrings(fmt, (char*)dataTable));
+            char* stringPool = dbc.AutoProduceStrings(fmt, (char*)dataTable);
 
             // Insert sql data into arrays
             if (result)
@@ -179,7 +186,7 @@ class DBCStorage
                                         break;
                                     case FT_STRING:
                                         // Beginning of the pool - empty string
-                                        *((char**)(&sqlDataTable[offset]))=stringPoolList.back();
+                                        *((char**)(&sqlDataTable[offset]))=stringPool;
                                         offset+=sizeof(char*);
                                         break;
                                 }
@@ -241,18 +248,31 @@ class DBCStorage
             if (!indexTable.asT)
                 return false;
 
-            DBCFileLoader dbc;
+            DBCFileLoader* file = new DBCFileLoader();
             // Check if load was successful, only then continue
-            if (!dbc.Load(fn, fmt))
+            if (!file->Load(fn, fmt))
+            {
+                delete file;
                 return false;
+            }
 
-            stringPoolList.push_back(dbc.AutoProduceStrings(fmt, (char*)dataTable));
+            // a file of another layout provides no strings but doesn't disable the locale
+            if (file->AutoProduceStrings(fmt, (char*)dataTable))
+                stringFileList.push_back(file);
+            else
+                delete file;
 
             return true;
         }
 
         void Clear()
         {
+            while (!stringFileList.empty())
+            {
+                delete stringFileList.front();
+                stringFileList.pop_front();
+            }
+
             if (!indexTable.asT)
                 return;
 
@@ -261,11 +281,6 @@ class DBCStorage
             delete[] ((char*)dataTable);
             dataTable = NULL;
 
-            while (!stringPoolList.empty())
-            {
-                delete[] stringPoolList.front();
-                stringPoolList.pop_front();
-            }
             nCount = 0;
         }
 
@@ -282,7 +297,7 @@ class DBCStorage
         indexTable;
 
         T* dataTable;
-        StringPoolList stringPoolList;
+        StringFileList stringFileList;
 };
 
 #endif
@@ -21,6 +21,8 @@
 #include "DatabaseWorkerPool.h"
 #include "MySQLConnection.h"
 
+#define CHAR_SAVE_BATCH_ROWS    8                           // rows per *_BATCH multi row insert statement
+
 class CharacterDatabaseConnection : public MySQLConnection
 {
     public:
@@ -110,6 +112,7 @@ enum CharacterDatabaseStatements
     CHAR_ADD_ITEM_BOP_TRADE,
     CHAR_REP_INVENTORY_ITEM,
     CHAR_DEL_INVENTORY_ITEM,
+    CHAR_DEL_INVENTORY_BY_BAG_SLOT,
     CHAR_ADD_ITEM_INSTANCE,
     CHAR_UPDATE_ITEM_INSTANCE,
     CHAR_UPDATE_ITEM_INSTANCE_ON_LOAD,
@@ -277,6 +280,33 @@ enum CharacterDatabaseStatements
 
     CHAR_LOAD_EXPIRED_AUCTIONS,
 
+    CHAR_REP_CHARACTER,
+    CHAR_SET_CHAR_MONEY,
+    CHAR_DEL_CHAR_SPELL,
+    CHAR_ADD_CHAR_SPELL,
+    CHAR_ADD_CHAR_SPELL_BATCH,
+    CHAR_DEL_CHAR_TALENT,
+    CHAR_ADD_CHAR_TALENT,
+    CHAR_ADD_CHAR_TALENT_BATCH,
+    CHAR_DEL_CHAR_SKILL,
+    CHAR_ADD_CHAR_SKILL,
+    CHAR_ADD_CHAR_SKILL_BATCH,
+    CHAR_SET_CHAR_SKILL,
+    CHAR_DEL_CHAR_ACTION,
+    CHAR_ADD_CHAR_ACTION,
+    CHAR_ADD_CHAR_ACTION_BATCH,
+    CHAR_SET_CHAR_ACTION,
+    CHAR_REP_CHAR_QUESTSTATUS,
+    CHAR_DEL_CHAR_QUESTSTATUS,
+    CHAR_ADD_CHAR_QUESTSTATUS_REWARDED,
+    CHAR_DEL_CHAR_QUESTSTATUS_REWARDED,
+    CHAR_DEL_CHAR_QUESTSTATUS_DAILY,
+    CHAR_ADD_CHAR_QUESTSTATUS_DAILY,
+    CHAR_DEL_CHAR_QUESTSTATUS_WEEKLY,
+    CHAR_ADD_CHAR_QUESTSTATUS_WEEKLY,
+    CHAR_DEL_CHAR_GLYPHS,
+    CHAR_ADD_CHAR_GLYPHS,
+
     MAX_CHARACTERDATABASE_STATEMENTS,
 };
 
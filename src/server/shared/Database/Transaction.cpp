@@ -25,6 +25,8 @@ void Transaction::Append(const char* sql)
     data.type = SQL_ELEMENT_RAW;
     data.element.query = strdup(sql);
     m_queries.push_back(data);
+    ++_rawCount;
+    _rawBytes += strlen(sql);
 }
 
 void Transaction::PAppend(const char* sql, ...)
@@ -45,6 +47,7 @@ void Transaction::Append(PreparedStatement* stmt)
     data.type = SQL_ELEMENT_PREPARED;
     data.element.stmt = stmt;
     m_queries.push_back(data);
+    ++_preparedCount;
 }
 
 void Transaction::Cleanup()
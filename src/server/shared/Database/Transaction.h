@@ -30,7 +30,7 @@ class Transaction
     friend class MySQLConnection;
 
     public:
-        Transaction() : _cleanedUp(false) {}
+        Transaction() : _cleanedUp(false), _preparedCount(0), _rawCount(0), _rawBytes(0) {}
         ~Transaction() { Cleanup(); }
 
         void Append(PreparedStatement* statement);
@@ -39,12 +39,20 @@ class Transaction
 
         size_t GetSize() const { return m_queries.size(); }
 
+        // statistics about what has been appended so far
+        uint32 GetPreparedCount() const { return _preparedCount; }
+        uint32 GetRawCount() const { return _rawCount; }
+        uint32 GetRawBytes() const { return _rawBytes; }
+
     protected:
         void Cleanup();
         std::list<SQLElementData> m_queries;
 
     private:
         bool _cleanedUp;
+        uint32 _preparedCount;
+        uint32 _rawCount;
+        uint32 _rawBytes;
 
 };
 typedef ACE_Refcounted_Auto_Ptr<Transaction, ACE_Null_Mutex> SQLTransaction;
@@ -28,64 +28,144 @@
 #include <ace/TSS_T.h>
 #include <ace/INET_Addr.h>
 
+#if COMPILER == COMPILER_MICROSOFT
+#  define RNG_THREAD_LOCAL __declspec(thread)
+#else
+#  define RNG_THREAD_LOCAL __thread
+#endif
+
 #ifdef USE_SFMT_FOR_RNG
-typedef ACE_TSS<SFMTRand> SFMTRandTSS;
-static SFMTRandTSS sfmtRand;
+typedef SFMTRand RandomGenerator;
+#else
+typedef MTRand RandomGenerator;
+#endif
+
+// Owns the generator of every thread and deletes it at thread exit. It is only asked once per
+// thread, the rolls go through a plain thread local pointer instead of a TSS key lookup each.
+static ACE_TSS<RandomGenerator> threadGenerator;
+static RNG_THREAD_LOCAL RandomGenerator* localGenerator = NULL;
+
+static inline RandomGenerator* GetGenerator()
+{
+    if (!localGenerator)
+        localGenerator = threadGenerator;
+
+    return localGenerator;
+}
 
+#ifdef USE_SFMT_FOR_RNG
 int32 irand (int32 min, int32 max)
 {
-    return int32(sfmtRand->IRandom(min, max));
+    return int32(GetGenerator()->IRandom(min, max));
 }
 
 uint32 urand (uint32 min, uint32 max)
 {
-    return sfmtRand->URandom(min, max);
+    return GetGenerator()->URandom(min, max);
 }
 
 int32 rand32 ()
 {
-    return int32(sfmtRand->BRandom());
+    return int32(GetGenerator()->BRandom());
 }
 
 double rand_norm(void)
 {
-    return sfmtRand->Random();
+    return GetGenerator()->Random();
 }
 
 double rand_chance (void)
 {
-    return sfmtRand->Random() * 100.0;
+    return GetGenerator()->Random() * 100.0;
+}
+
+void urand_fill(uint32* dest, uint32 count, uint32 min, uint32 max)
+{
+    if (max <= min)
+    {
+        std::fill(dest, dest + count, max == min ? min : 0);
+        return;
+    }
+
+    GetGenerator()->BRandomFill(dest, count);
+
+    // same multiply and shift mapping as SFMTRand::URandom
+    uint32 interval = max - min + 1;
+    for (uint32 i = 0; i < count; ++i)
+        dest[i] = uint32((uint64(dest[i]) * interval) >> 32) + min;
 }
-#else
-typedef ACE_TSS<MTRand> MTRandTSS;
-static MTRandTSS mtRand;
 
+void rand_chance_fill(double* dest, uint32 count)
+{
+    GetGenerator()->RandomFill(dest, count);
+
+    for (uint32 i = 0; i < count; ++i)
+        dest[i] *= 100.0;
+}
+
+RandomSeedScope::RandomSeedScope(uint32 seed)
+{
+    SFMTRand* generator = new SFMTRand();
+    generator->RandomInit(int(seed));
+    _generator = generator;
+    _previous = GetGenerator();
+    localGenerator = generator;
+}
+#else
 int32 irand(int32 min, int32 max)
 {
-    return int32(mtRand->randInt (max - min)) + min;
+    return int32(GetGenerator()->randInt (max - min)) + min;
 }
 
 uint32 urand(uint32 min, uint32 max)
 {
-    return mtRand->randInt (max - min) + min;
+    return GetGenerator()->randInt (max - min) + min;
 }
 
 int32 rand32()
 {
-    return mtRand->randInt ();
+    return GetGenerator()->randInt ();
 }
 
 double rand_norm(void)
 {
-    return mtRand->randExc();
+    return GetGenerator()->randExc();
 }
 
 double rand_chance(void)
 {
-    return mtRand->randExc(100.0);
+    return GetGenerator()->randExc(100.0);
+}
+
+void urand_fill(uint32* dest, uint32 count, uint32 min, uint32 max)
+{
+    MTRand* generator = GetGenerator();
+    for (uint32 i = 0; i < count; ++i)
+        dest[i] = generator->randInt(max - min) + min;
+}
+
+void rand_chance_fill(double* dest, uint32 count)
+{
+    MTRand* generator = GetGenerator();
+    for (uint32 i = 0; i < count; ++i)
+        dest[i] = generator->randExc(100.0);
+}
+
+RandomSeedScope::RandomSeedScope(uint32 seed)
+{
+    MTRand* generator = new MTRand(seed);
+    _generator = generator;
+    _previous = GetGenerator();
+    localGenerator = generator;
 }
 #endif
 
+RandomSeedScope::~RandomSeedScope()
+{
+    localGenerator = static_cast<RandomGenerator*>(_previous);
+    delete static_cast<RandomGenerator*>(_generator);
+}
+
 Tokens::Tokens(const std::string &src, const char sep, uint32 vectorReserve)
 {
     m_str = new char[src.length() + 1];
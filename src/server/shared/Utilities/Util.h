@@ -74,6 +74,29 @@ inline uint32 secsToTimeBitFields(time_t secs)
  * With an FPU, there is usually no difference in performance between float and double. */
  double rand_chance(void);
 
+/* Fill dest with count random numbers in the range min..max (inclusive), the same as count calls
+ * to urand but cheaper for callers that need many rolls at once. */
+ void urand_fill(uint32* dest, uint32 count, uint32 min, uint32 max);
+
+/* Fill dest with count random doubles from 0.0 to 99.9999999999999, the same as count calls to rand_chance. */
+ void rand_chance_fill(double* dest, uint32 count);
+
+/* While alive, the random functions above draw from a generator seeded with seed on the calling
+ * thread, so a sequence of rolls can be repeated no matter when it is made. */
+class RandomSeedScope
+{
+    public:
+        explicit RandomSeedScope(uint32 seed);
+        ~RandomSeedScope();
+
+    private:
+        RandomSeedScope(RandomSeedScope const&);
+        RandomSeedScope& operator=(RandomSeedScope const&);
+
+        void* _generator;
+        void* _previous;
+};
+
 /* Return true if a random roll fits in the specified chance (range 0-100). */
 inline bool roll_chance_f(float chance)
 {